@@ -81,7 +81,9 @@ void DrawAnimatedArt(Art *art, Point screenPosition)
 
 int GetAnimationFrame(int frames, int fps)
 {
-	int frame = (SDL_GetTicks() / fps) % frames;
+	const uint32_t ticks = SDL_GetTicks();
+	int frame = (ticks / fps) % frames;
+	UiScheduleRedraw((ticks / fps + 1) * fps);
 
 	return frame > frames ? 0 : frame;
 }
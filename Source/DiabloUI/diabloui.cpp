@@ -53,6 +53,12 @@ namespace {
 uint32_t fadeTc;
 int fadeValue = 0;
 
+/** Longest time a menu sleeps without an event, in milliseconds */
+constexpr uint32_t MaxUiIdleWait = 500;
+/** Earliest time something on screen changes on its own */
+uint32_t NextUiRedraw;
+bool UiRedrawScheduled;
+
 struct ScrollBarState {
 	bool upArrowPressed;
 	bool downArrowPressed;
@@ -556,6 +562,8 @@ void UiFadeIn()
 		}
 		if (fadeValue != prevFadeValue)
 			SetFadeLevel(fadeValue);
+		if (fadeValue < 256)
+			UiScheduleRedraw(SDL_GetTicks());
 	}
 
 	if (DiabloUiSurface() == PalSurface)
@@ -599,6 +607,29 @@ void UiPollAndRender()
 	// Must happen after the very first UiFadeIn, which sets the cursor.
 	if (IsHardwareCursor())
 		SetHardwareCursorVisible(true);
+
+	UiWaitForEvent();
+}
+
+void UiScheduleRedraw(uint32_t time)
+{
+	if (!UiRedrawScheduled || static_cast<int32_t>(time - NextUiRedraw) < 0) {
+		NextUiRedraw = time;
+		UiRedrawScheduled = true;
+	}
+}
+
+void UiWaitForEvent()
+{
+	uint32_t timeout = MaxUiIdleWait;
+	if (UiRedrawScheduled) {
+		const auto untilRedraw = static_cast<int32_t>(NextUiRedraw - SDL_GetTicks());
+		timeout = std::min<uint32_t>(std::max(untilRedraw, 0), MaxUiIdleWait);
+	}
+	UiRedrawScheduled = false;
+
+	if (timeout > 0)
+		SDL_WaitEventTimeout(nullptr, timeout);
 }
 
 namespace {
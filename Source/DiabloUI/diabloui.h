@@ -106,6 +106,15 @@ void UiInitList(int count, void (*fnFocus)(int value), void (*fnSelect)(int valu
 void UiInitScrollBar(UiScrollbar *uiSb, std::size_t viewportSize, const std::size_t *currentOffset);
 void UiClearScreen();
 void UiPollAndRender();
+/**
+ * @brief Makes the next UiWaitForEvent return no later than the given time, for animations and timeouts
+ * @param time SDL_GetTicks value at which the screen has to be drawn again
+ */
+void UiScheduleRedraw(uint32_t time);
+/**
+ * @brief Sleeps until an event arrives or the earliest redraw scheduled since the last call is due
+ */
+void UiWaitForEvent();
 void UiRenderItems(const std::vector<UiItemBase *> &items);
 void UiRenderItems(const std::vector<std::unique_ptr<UiItemBase>> &items);
 void UiInitList_clear();
@@ -250,6 +250,7 @@ void DialogLoop(const std::vector<std::unique_ptr<UiItemBase>> &items, const std
 		UiRenderItems(items);
 		DrawMouse();
 		UiFadeIn();
+		UiWaitForEvent();
 	} while (!dialogEnd);
 }
 
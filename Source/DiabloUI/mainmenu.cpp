@@ -79,6 +79,7 @@ bool UiMainMenuDialog(const char *name, _mainmenu_selections *pdwResult, void (*
 
 		while (MainMenuResult == MAINMENU_NONE) {
 			UiClearScreen();
+			UiScheduleRedraw(dwAttractTicks);
 			UiPollAndRender();
 			if (SDL_GetTicks() >= dwAttractTicks) {
 				MainMenuResult = MAINMENU_ATTRACT_MODE;
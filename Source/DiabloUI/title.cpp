@@ -41,6 +41,8 @@ void UiTitleDialog()
 	while (!endMenu && SDL_GetTicks() < timeOut) {
 		UiRenderItems(vecTitleScreen);
 		UiFadeIn();
+		UiScheduleRedraw(timeOut);
+		UiWaitForEvent();
 
 		while (SDL_PollEvent(&event) != 0) {
 			if (GetMenuAction(event) != MenuAction_NONE) {
@@ -5,6 +5,9 @@
  */
 #include "automap.h"
 
+#include <cstring>
+#include <optional>
+
 #include <fmt/format.h>
 
 #include "control.h"
@@ -453,6 +456,113 @@ AutomapTile GetAutomapTypeView(Point map)
 	return GetAutomapType(map);
 }
 
+/** Marks the pixels of AutomapRaster no tile has drawn to, the tiles only draw in black and the two map colors */
+constexpr uint8_t AutomapRasterTransparent = 0xFF;
+static_assert(AutomapRasterTransparent != 0 && AutomapRasterTransparent != MapColorsBright && AutomapRasterTransparent != MapColorsDim, "AutomapRasterTransparent must not be drawn by a tile");
+
+/** The explored part of the map drawn once at the current zoom level, so drawing the automap is a single copy */
+std::optional<OwnedSurface> AutomapRaster;
+/** Zoom level AutomapRaster was drawn at */
+int AutomapRasterScale;
+/** Explored tiles already drawn to AutomapRaster */
+bool AutomapRasterView[DMAXX][DMAXY];
+/** The dungeon AutomapRaster was drawn from, doors and levers can change it after the level is loaded */
+uint8_t AutomapRasterDungeon[DMAXX][DMAXY];
+
+/**
+ * @brief Horizontal position of a diagonal of tiles, the same as stepping through them one at a time in DrawAutomap
+ */
+int GetAutomapColumnX(int column)
+{
+	int pair = column >> 1;
+	if ((column & 1) != 0)
+		return pair * AmLine64;
+	return pair * AmLine64 - AmLine32;
+}
+
+/**
+ * @brief Vertical position of a row of tiles, the same as stepping through them one at a time in DrawAutomap
+ */
+int GetAutomapRowY(int row)
+{
+	int pair = (row + 1) >> 1;
+	if ((row & 1) != 0)
+		return pair * AmLine32;
+	return pair * AmLine32 + AmLine16;
+}
+
+/**
+ * @brief Room around the outermost tiles, their lines reach up to half a tile past their center
+ */
+int GetAutomapRasterMargin()
+{
+	return AmLine64;
+}
+
+void DrawAutomapRasterTile(Point map)
+{
+	const int margin = GetAutomapRasterMargin();
+	const Point center {
+		margin + GetAutomapColumnX(map.x - map.y + DMAXY),
+		margin + GetAutomapRowY(map.x + map.y + 2)
+	};
+	DrawAutomapTile(*AutomapRaster, center, GetAutomapTypeView(map));
+}
+
+/**
+ * @brief Draws all explored tiles to a new raster in the same order DrawAutomap used to draw them on screen
+ */
+void BuildAutomapRaster()
+{
+	const int margin = GetAutomapRasterMargin();
+	AutomapRaster.emplace(2 * margin + GetAutomapColumnX(DMAXX + DMAXY + 1), 2 * margin + GetAutomapRowY(DMAXX + DMAXY + 1));
+	SDL_FillRect(AutomapRaster->surface, nullptr, AutomapRasterTransparent);
+	AutomapRasterScale = AutoMapScale;
+	memcpy(AutomapRasterView, AutomapView, sizeof(AutomapRasterView));
+	memcpy(AutomapRasterDungeon, dungeon, sizeof(AutomapRasterDungeon));
+
+	// Border tiles at -1 are drawn as well
+	for (int row = 0; row <= DMAXX + DMAXY; row++) {
+		for (int x = -1; x < DMAXX; x++) {
+			const int y = row - 2 - x;
+			if (y >= -1 && y < DMAXY)
+				DrawAutomapRasterTile({ x, y });
+		}
+	}
+}
+
+/**
+ * @brief Brings AutomapRaster up to date with the explored tiles, only drawing the ones explored since the last update
+ */
+void UpdateAutomapRaster()
+{
+	if (!AutomapRaster || AutomapRasterScale != AutoMapScale || memcmp(AutomapRasterDungeon, dungeon, sizeof(AutomapRasterDungeon)) != 0) {
+		BuildAutomapRaster();
+		return;
+	}
+
+	if (memcmp(AutomapRasterView, AutomapView, sizeof(AutomapRasterView)) == 0)
+		return;
+
+	for (int x = 0; x < DMAXX; x++) {
+		for (int y = 0; y < DMAXY; y++) {
+			if (AutomapRasterView[x][y] == AutomapView[x][y])
+				continue;
+			if (!AutomapView[x][y]) {
+				// Tiles are only ever added while on a level, anything else means the map was replaced
+				BuildAutomapRaster();
+				return;
+			}
+			AutomapRasterView[x][y] = true;
+			DrawAutomapRasterTile({ x, y });
+			if (x == 0)
+				DrawAutomapRasterTile({ -1, y });
+			if (y == 0)
+				DrawAutomapRasterTile({ x, -1 });
+		}
+	}
+}
+
 /**
  * @brief Renders game info, such as the name of the current level, and in multi player the name of the game and the game password.
  */
@@ -531,6 +641,7 @@ void InitAutomap()
 	}
 
 	memset(AutomapView, 0, sizeof(AutomapView));
+	AutomapRaster = std::nullopt;
 
 	for (auto &column : dFlags)
 		for (auto &dFlag : column)
@@ -659,24 +770,17 @@ void DrawAutomap(const Surface &out)
 		}
 	}
 
-	Point map = { Automap.x - cells, Automap.y - 1 };
-
-	for (int i = 0; i <= cells + 1; i++) {
-		Point tile1 = screen;
-		for (int j = 0; j < cells; j++) {
-			DrawAutomapTile(out, tile1, GetAutomapTypeView({ map.x + j, map.y - j }));
-			tile1.x += AmLine64;
-		}
-		map.y++;
+	UpdateAutomapRaster();
 
-		Point tile2 { screen.x - AmLine32, screen.y + AmLine16 };
-		for (int j = 0; j <= cells; j++) {
-			DrawAutomapTile(out, tile2, GetAutomapTypeView({ map.x + j, map.y - j }));
-			tile2.x += AmLine64;
-		}
-		map.x++;
-		screen.y += AmLine32;
-	}
+	// screen is where the tile at Automap - { cells, 0 } goes, line it up with where the raster has that tile
+	const int margin = GetAutomapRasterMargin();
+	const int column = Automap.y - Automap.x + cells - DMAXY;
+	const int row = cells - Automap.x - Automap.y - 2;
+	const Point rasterPosition {
+		screen.x + GetAutomapColumnX(column + 1) - GetAutomapColumnX(1) - margin,
+		screen.y + GetAutomapRowY(row + 1) - GetAutomapRowY(1) - margin
+	};
+	out.BlitFromSkipColorIndex(*AutomapRaster, MakeSdlRect(0, 0, AutomapRaster->w(), AutomapRaster->h()), rasterPosition, AutomapRasterTransparent);
 
 	for (int playerId = 0; playerId < MAX_PLRS; playerId++) {
 		auto &player = Players[playerId];
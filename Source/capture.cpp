@@ -1,144 +1,239 @@
 /**
  * @file capture.cpp
  *
- * Implementation of the screenshot function.
+ * Implementation of the screenshot and frame capture functions.
  */
 #include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <memory>
+#include <mutex>
 
-#include "DiabloUI/diabloui.h"
+#include <fmt/format.h>
+
+#include "capture.h"
+#include "diablo.h"
 #include "dx.h"
 #include "palette.h"
-#include "storm/storm.h"
 #include "utils/file_util.h"
 #include "utils/log.hpp"
 #include "utils/paths.h"
-#include "utils/ui_fwd.h"
+#include "utils/png_writer.h"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
 
 namespace devilution {
 namespace {
 
-/**
- * @brief Write the PCX-file header
- * @param width Image width
- * @param height Image height
- * @param out File stream to write to
- * @return True on success
- */
-bool CaptureHdr(int16_t width, int16_t height, std::ofstream *out)
-{
-	PCXHeader buffer;
+/** Number of frames that can wait to be written */
+constexpr int CaptureSlotCount = 8;
 
-	memset(&buffer, 0, sizeof(buffer));
-	buffer.Manufacturer = 10;
-	buffer.Version = 5;
-	buffer.Encoding = 1;
-	buffer.BitsPerPixel = 8;
-	buffer.Xmax = SDL_SwapLE16(width - 1);
-	buffer.Ymax = SDL_SwapLE16(height - 1);
-	buffer.HDpi = SDL_SwapLE16(width);
-	buffer.VDpi = SDL_SwapLE16(height);
-	buffer.NPlanes = 1;
-	buffer.BytesPerLine = SDL_SwapLE16(width);
+/** Time the screen stays red after a screenshot, in milliseconds */
+constexpr uint32_t FlashDuration = 300;
 
-	out->write(reinterpret_cast<const char *>(&buffer), sizeof(buffer));
-	return !out->fail();
-}
+/** @brief Durations of the parts of a frame in milliseconds */
+struct FrameTimings {
+	/** Game ticks that ran since the previous frame */
+	float tick;
+	float draw;
+	float present;
+	/** Time since the previous frame was presented */
+	float frame;
+};
 
-/**
- * @brief Write the current in-game palette to the PCX file
- * @param palette Current palette
- * @param out File stream for the PCX file.
- * @return True if successful, else false
- */
-bool CapturePal(SDL_Color *palette, std::ofstream *out)
+struct CapturedFrame {
+	std::unique_ptr<uint8_t[]> pixels;
+	int width;
+	int height;
+	SDL_Color palette[256];
+	/** Position of the frame in a continuous capture, -1 for a screenshot */
+	int sequenceFrame;
+	/** First frame of a continuous capture that made it into the queue */
+	bool startsSequence;
+	FrameTimings timings;
+};
+
+/** Ring of frame copies, slots outside the queued range belong to the main thread */
+CapturedFrame CaptureRing[CaptureSlotCount];
+SdlThread CaptureThread;
+SdlMutex CaptureMutex;
+SdlCond FrameQueued;
+SdlCond FrameWritten;
+/** Guarded by CaptureMutex */
+int FirstQueuedFrame;
+/** Guarded by CaptureMutex */
+int QueuedFrameCount;
+/** Guarded by CaptureMutex */
+bool CaptureStopping;
+
+bool ScreenshotPending;
+int SequenceFramesLeft;
+int SequenceFrame;
+int DroppedFrames;
+bool SequenceStarted;
+uint64_t PendingTickTime;
+uint64_t LastFrameEnd;
+
+bool Flashing;
+uint32_t FlashEnd;
+SDL_Color FlashPalette[256];
+
+/** Number used in the file names of the running continuous capture, only used by the capture thread */
+int SequenceNumber;
+
+float ToMilliseconds(uint64_t duration)
 {
-	BYTE pcxPalette[1 + 256 * 3];
+	return static_cast<float>(duration * 1000.0 / SDL_GetPerformanceFrequency());
+}
 
-	pcxPalette[0] = 12;
-	for (int i = 0; i < 256; i++) {
-		pcxPalette[1 + 3 * i + 0] = palette[i].r;
-		pcxPalette[1 + 3 * i + 1] = palette[i].g;
-		pcxPalette[1 + 3 * i + 2] = palette[i].b;
+bool FindScreenshotPath(std::string *dstPath)
+{
+	for (int i = 0; i <= 99; ++i) {
+		*dstPath = fmt::format("{}screen{:02}.PNG", paths::PrefPath(), i);
+		if (!FileExists(dstPath->c_str()))
+			return true;
 	}
-
-	out->write(reinterpret_cast<const char *>(pcxPalette), sizeof(pcxPalette));
-	return !out->fail();
+	return false;
 }
 
-/**
- * @brief RLE compress the pixel data
- * @param src Raw pixel buffer
- * @param dst Output buffer
- * @param width Width of pixel buffer
+void StartSequence()
+{
+	SequenceNumber = 0;
+	for (int i = 0; i <= 99; ++i) {
+		SequenceNumber = i;
+		std::string path = fmt::format("{}capture{:02}_0000.PNG", paths::PrefPath(), i);
+		if (!FileExists(path.c_str()))
+			break;
+	}
+}
 
- * @return Output buffer
- */
-BYTE *CaptureEnc(BYTE *src, BYTE *dst, int width)
+void WriteCapturedFrame(const CapturedFrame &frame)
 {
-	int rleLength;
+	std::string path;
+	if (frame.sequenceFrame == -1) {
+		if (!FindScreenshotPath(&path)) {
+			Log("No free screenshot file name left");
+			return;
+		}
+	} else {
+		if (frame.startsSequence)
+			StartSequence();
+		path = fmt::format("{}capture{:02}_{:04}.PNG", paths::PrefPath(), SequenceNumber, frame.sequenceFrame);
+	}
 
-	do {
-		BYTE rlePixel = *src;
-		src++;
-		rleLength = 1;
+	std::vector<PngText> text = {
+		{ "Software", gszProductName },
+		{ "Game tick", fmt::format("{:.3f} ms", frame.timings.tick) },
+		{ "Draw", fmt::format("{:.3f} ms", frame.timings.draw) },
+		{ "Present", fmt::format("{:.3f} ms", frame.timings.present) },
+		{ "Frame", fmt::format("{:.3f} ms", frame.timings.frame) },
+	};
+	std::vector<uint8_t> png = EncodePng(frame.pixels.get(), frame.width, frame.height, frame.width, frame.palette, text);
 
-		width--;
+	std::ofstream outStream(path, std::ios::binary | std::ios::trunc);
+	outStream.write(reinterpret_cast<const char *>(png.data()), png.size());
+	outStream.close();
 
-		while (rlePixel == *src) {
-			if (rleLength >= 63)
-				break;
-			if (width == 0)
-				break;
-			rleLength++;
+	if (outStream.fail()) {
+		Log("Failed to save frame at {}", path);
+		RemoveFile(path.c_str());
+	} else if (frame.sequenceFrame == -1) {
+		Log("Screenshot saved at {}", path);
+	}
+}
 
-			width--;
-			src++;
+void WriteCapturedFrames()
+{
+	while (true) {
+		int slot;
+		{
+			const std::lock_guard<SdlMutex> lock(CaptureMutex);
+			while (QueuedFrameCount == 0 && !CaptureStopping)
+				FrameQueued.wait(CaptureMutex);
+			if (QueuedFrameCount == 0)
+				return;
+			slot = FirstQueuedFrame;
 		}
 
-		if (rleLength > 1 || rlePixel > 0xBF) {
-			*dst = rleLength | 0xC0;
-			dst++;
+		WriteCapturedFrame(CaptureRing[slot]);
+
+		{
+			const std::lock_guard<SdlMutex> lock(CaptureMutex);
+			FirstQueuedFrame = (FirstQueuedFrame + 1) % CaptureSlotCount;
+			QueuedFrameCount--;
 		}
+		FrameWritten.signal();
+	}
+}
+
+void StartCaptureThread()
+{
+	if (CaptureThread.joinable())
+		return;
+
+	CaptureStopping = false;
+	CaptureThread = SdlThread { WriteCapturedFrames };
+}
 
-		*dst = rlePixel;
-		dst++;
-	} while (width > 0);
+void AllocateSlot(CapturedFrame &frame, int width, int height)
+{
+	if (frame.pixels != nullptr && frame.width == width && frame.height == height)
+		return;
 
-	return dst;
+	frame.pixels.reset(new uint8_t[width * height]);
+	frame.width = width;
+	frame.height = height;
 }
 
 /**
- * @brief Write the pixel data to the PCX file
- * @param buf Buffer
- * @return True if successful, else false
+ * @brief Allocates every slot of the ring for the current screen size so captures don't allocate per frame
  */
-bool CapturePix(const Surface &buf, std::ofstream *out)
-{
-	int width = buf.w();
-	std::unique_ptr<BYTE[]> pBuffer { new BYTE[2 * width] };
-	BYTE *pixels = buf.begin();
-	for (int height = buf.h(); height > 0; height--) {
-		const BYTE *pBufferEnd = CaptureEnc(pixels, pBuffer.get(), width);
-		pixels += buf.pitch();
-		out->write(reinterpret_cast<const char *>(pBuffer.get()), pBufferEnd - pBuffer.get());
-		if (out->fail())
-			return false;
+void ReserveCaptureSlots()
+{
+	{
+		const std::lock_guard<SdlMutex> lock(CaptureMutex);
+		while (QueuedFrameCount != 0)
+			FrameWritten.wait(CaptureMutex);
 	}
-	return true;
+
+	const Surface &buf = GlobalBackBuffer();
+	for (CapturedFrame &frame : CaptureRing)
+		AllocateSlot(frame, buf.w(), buf.h());
 }
 
-std::ofstream CaptureFile(std::string *dstPath)
+/**
+ * @brief Copies the back buffer and palette into the next free slot and hands it to the capture thread
+ * @return False if all slots are still waiting to be written
+ */
+bool QueueFrame(int sequenceFrame, bool startsSequence, const FrameTimings &timings)
 {
-	char filename[sizeof("screen00.PCX") / sizeof(char)];
-	for (int i = 0; i <= 99; ++i) {
-		snprintf(filename, sizeof(filename) / sizeof(char), "screen%02d.PCX", i);
-		*dstPath = paths::PrefPath() + filename;
-		if (!FileExists(dstPath->c_str())) {
-			return std::ofstream(*dstPath, std::ios::binary | std::ios::trunc);
-		}
+	int slot;
+	{
+		const std::lock_guard<SdlMutex> lock(CaptureMutex);
+		if (QueuedFrameCount == CaptureSlotCount)
+			return false;
+		slot = (FirstQueuedFrame + QueuedFrameCount) % CaptureSlotCount;
+	}
+
+	CapturedFrame &frame = CaptureRing[slot];
+	lock_buf(2);
+	const Surface &buf = GlobalBackBuffer();
+	AllocateSlot(frame, buf.w(), buf.h());
+	for (int y = 0; y < buf.h(); y++)
+		memcpy(&frame.pixels[y * frame.width], buf.at(0, y), frame.width);
+	unlock_buf(2);
+	PaletteGetEntries(256, frame.palette);
+	frame.sequenceFrame = sequenceFrame;
+	frame.startsSequence = startsSequence;
+	frame.timings = timings;
+
+	{
+		const std::lock_guard<SdlMutex> lock(CaptureMutex);
+		QueuedFrameCount++;
 	}
-	return {};
+	FrameQueued.signal();
+	return true;
 }
 
 /**
@@ -146,52 +241,109 @@ std::ofstream CaptureFile(std::string *dstPath)
  */
 void RedPalette()
 {
+	memcpy(FlashPalette, system_palette, sizeof(FlashPalette));
 	for (int i = 0; i < 256; i++) {
 		system_palette[i].g = 0;
 		system_palette[i].b = 0;
 	}
 	palette_update();
-	BltFast(nullptr, nullptr);
-	RenderPresent();
+	Flashing = true;
+	FlashEnd = SDL_GetTicks() + FlashDuration;
+}
+
+/**
+ * @brief Puts back the palette from before the screenshot once the flash is over
+ * @param force End the flash even if its time isn't up yet
+ */
+void EndRedPalette(bool force)
+{
+	if (!Flashing)
+		return;
+	if (!force && static_cast<int32_t>(SDL_GetTicks() - FlashEnd) < 0)
+		return;
+	Flashing = false;
+
+	// Leave the palette alone if the game replaced it (e.g. by fading to a new level) during the flash
+	for (int i = 0; i < 256; i++) {
+		if (system_palette[i].r != FlashPalette[i].r || system_palette[i].g != 0 || system_palette[i].b != 0)
+			return;
+	}
+	memcpy(system_palette, FlashPalette, sizeof(FlashPalette));
+	palette_update();
 }
+
 } // namespace
 
 void CaptureScreen()
 {
-	SDL_Color palette[256];
-	std::string fileName;
-	bool success;
+	ScreenshotPending = true;
+}
 
-	std::ofstream outStream = CaptureFile(&fileName);
-	if (!outStream.is_open())
-		return;
-	DrawAndBlit();
-	PaletteGetEntries(256, palette);
-	RedPalette();
+void CaptureFrames(int count)
+{
+	StartCaptureThread();
+	ReserveCaptureSlots();
+	SequenceFramesLeft = count;
+	SequenceFrame = 0;
+	DroppedFrames = 0;
+	SequenceStarted = false;
+}
 
-	lock_buf(2);
-	const Surface &buf = GlobalBackBuffer();
-	success = CaptureHdr(buf.w(), buf.h(), &outStream);
-	if (success) {
-		success = CapturePix(buf, &outStream);
-	}
-	if (success) {
-		success = CapturePal(palette, &outStream);
+void RecordGameTickTime(uint64_t duration)
+{
+	PendingTickTime += duration;
+}
+
+void CaptureFrame(uint64_t drawTime, uint64_t presentTime)
+{
+	uint64_t now = SDL_GetPerformanceCounter();
+	FrameTimings timings;
+	timings.tick = ToMilliseconds(PendingTickTime);
+	timings.draw = ToMilliseconds(drawTime);
+	timings.present = ToMilliseconds(presentTime);
+	timings.frame = LastFrameEnd != 0 ? ToMilliseconds(now - LastFrameEnd) : 0;
+	PendingTickTime = 0;
+	LastFrameEnd = now;
+
+	EndRedPalette(false);
+
+	if (ScreenshotPending) {
+		ScreenshotPending = false;
+		StartCaptureThread();
+		if (QueueFrame(-1, false, timings))
+			RedPalette();
+		else
+			Log("Skipped screenshot, too many captured frames are still being written");
 	}
-	unlock_buf(2);
-	outStream.close();
 
-	if (!success) {
-		Log("Failed to save screenshot at {}", fileName);
-		RemoveFile(fileName.c_str());
-	} else {
-		Log("Screenshot saved at {}", fileName);
+	if (SequenceFramesLeft > 0) {
+		if (QueueFrame(SequenceFrame, !SequenceStarted, timings))
+			SequenceStarted = true;
+		else
+			DroppedFrames++;
+		SequenceFrame++;
+		SequenceFramesLeft--;
+		if (SequenceFramesLeft == 0)
+			Log("Captured {} frames, {} dropped", SequenceFrame - DroppedFrames, DroppedFrames);
 	}
-	SDL_Delay(300);
-	for (int i = 0; i < 256; i++) {
-		system_palette[i] = palette[i];
+}
+
+void FinishFrameCaptures()
+{
+	EndRedPalette(true);
+	ScreenshotPending = false;
+	SequenceFramesLeft = 0;
+	LastFrameEnd = 0;
+
+	if (!CaptureThread.joinable())
+		return;
+
+	{
+		const std::lock_guard<SdlMutex> lock(CaptureMutex);
+		CaptureStopping = true;
 	}
-	palette_update();
+	FrameQueued.signal();
+	CaptureThread.join();
 }
 
 } // namespace devilution
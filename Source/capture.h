@@ -1,15 +1,43 @@
 /**
  * @file capture.h
  *
- * Interface of the screenshot function.
+ * Interface of the screenshot and frame capture functions.
  */
 #pragma once
 
+#include <cstdint>
+
 namespace devilution {
 
 /**
- * @brief Save the current screen to a screen??.PCX (00-99) in file if available, then make the screen red for 200ms.
+ * @brief Save the next frame to a screen??.PNG (00-99) in file if available, then make the screen red for 300ms.
  */
 void CaptureScreen();
 
+/**
+ * @brief Save each of the next frames to a capture??_????.PNG, tagged with how long the parts of the frame took
+ * @param count Number of frames to capture
+ */
+void CaptureFrames(int count);
+
+/**
+ * @brief Adds the duration of a game tick to the timings of the next captured frame
+ * @param duration Duration in performance counter ticks
+ */
+void RecordGameTickTime(uint64_t duration);
+
+/**
+ * @brief Copies the frame that was just presented if a capture asked for it
+ *
+ * The copy is compressed and written on a background thread, frames that find all capture buffers in use are dropped.
+ * @param drawTime Time spent drawing the frame in performance counter ticks
+ * @param presentTime Time spent presenting the frame in performance counter ticks
+ */
+void CaptureFrame(uint64_t drawTime, uint64_t presentTime);
+
+/**
+ * @brief Ends a running capture and waits for all copied frames to be written
+ */
+void FinishFrameCaptures();
+
 } // namespace devilution
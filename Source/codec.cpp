@@ -28,7 +28,10 @@ std::array<std::byte, sizeof...(Ts)> make_bytes(Ts &&...args) noexcept
 	return { std::byte(std::forward<Ts>(args))... };
 }
 
-void CodecInitKey(const char *pszPassword)
+/**
+ * @brief Sets up the hash the key stream is drawn from
+ */
+SHA1Context CodecInitKey(const char *pszPassword)
 {
 	std::byte pw[BlockSize]; // Repeat password until 64 char long
 	std::size_t j = 0;
@@ -39,9 +42,10 @@ void CodecInitKey(const char *pszPassword)
 	}
 
 	std::byte digest[SHA1HashSize];
-	SHA1Reset(0);
-	SHA1Calculate(0, pw, digest);
-	SHA1Clear();
+	SHA1Context context;
+	SHA1Reset(context);
+	SHA1Calculate(context, pw);
+	SHA1Result(context, digest);
 
 	// declaring key as a std::array to make the initialization easier, otherwise we would need to explicitly
 	// declare every value as a byte on platforms that use std::byte.
@@ -56,11 +60,10 @@ void CodecInitKey(const char *pszPassword)
 		key[i] ^= digest[(i + 12) % SHA1HashSize];
 	memset(pw, 0, sizeof(pw));
 	memset(digest, 0, sizeof(digest));
-	for (int n = 0; n < 3; ++n) {
-		SHA1Reset(n);
-		SHA1Calculate(n, key.data(), nullptr);
-	}
+	SHA1Reset(context);
+	SHA1Calculate(context, key.data());
 	memset(key.data(), 0, sizeof(key));
+	return context;
 }
 } // namespace
 
@@ -69,19 +72,19 @@ std::size_t codec_decode(std::byte *pbSrcDst, std::size_t size, const char *pszP
 	std::byte buf[BlockSize];
 	std::byte dst[SHA1HashSize];
 
-	CodecInitKey(pszPassword);
 	if (size <= sizeof(CodecSignature))
 		return 0;
 	size -= sizeof(CodecSignature);
 	if (size % BlockSize != 0)
 		return 0;
+	SHA1Context context = CodecInitKey(pszPassword);
 	for (auto i = size; i != 0; pbSrcDst += BlockSize, i -= BlockSize) {
 		memcpy(buf, pbSrcDst, BlockSize);
-		SHA1Result(0, dst);
+		SHA1Result(context, dst);
 		for (unsigned j = 0; j < BlockSize; j++) {
 			buf[j] ^= dst[j % SHA1HashSize];
 		}
-		SHA1Calculate(0, buf, nullptr);
+		SHA1Calculate(context, buf);
 		memset(dst, 0, sizeof(dst));
 		memcpy(pbSrcDst, buf, BlockSize);
 	}
@@ -92,17 +95,17 @@ std::size_t codec_decode(std::byte *pbSrcDst, std::size_t size, const char *pszP
 		goto error;
 	}
 
-	SHA1Result(0, dst);
+	SHA1Result(context, dst);
 	if (sig->checksum != *reinterpret_cast<uint32_t *>(dst)) {
 		memset(dst, 0, sizeof(dst));
 		goto error;
 	}
 
 	size += sig->lastChunkSize - BlockSize;
-	SHA1Clear();
+	SHA1Clear(context);
 	return size;
 error:
-	SHA1Clear();
+	SHA1Clear(context);
 	return 0;
 }
 
@@ -121,7 +124,7 @@ void codec_encode(std::byte *pbSrcDst, std::size_t size, std::size_t size64, con
 
 	if (size64 != codec_get_encoded_len(size))
 		app_fatal("Invalid encode parameters");
-	CodecInitKey(pszPassword);
+	SHA1Context context = CodecInitKey(pszPassword);
 
 	size_t lastChunk = 0;
 	while (size != 0) {
@@ -129,8 +132,8 @@ void codec_encode(std::byte *pbSrcDst, std::size_t size, std::size_t size64, con
 		memcpy(buf, pbSrcDst, chunk);
 		if (chunk < BlockSize)
 			memset(buf + chunk, 0, BlockSize - chunk);
-		SHA1Result(0, dst);
-		SHA1Calculate(0, buf, nullptr);
+		SHA1Result(context, dst);
+		SHA1Calculate(context, buf);
 		for (unsigned j = 0; j < BlockSize; j++) {
 			buf[j] ^= dst[j % SHA1HashSize];
 		}
@@ -141,13 +144,13 @@ void codec_encode(std::byte *pbSrcDst, std::size_t size, std::size_t size64, con
 		size -= chunk;
 	}
 	memset(buf, 0, sizeof(buf));
-	SHA1Result(0, tmp);
+	SHA1Result(context, tmp);
 	auto *sig = reinterpret_cast<CodecSignature *>(pbSrcDst);
 	sig->error = 0;
 	sig->unused = 0;
 	sig->checksum = *reinterpret_cast<uint32_t *>(tmp);
 	sig->lastChunkSize = static_cast<uint8_t>(lastChunk); // lastChunk is at most 64 so will always fit in an 8 bit var
-	SHA1Clear();
+	SHA1Clear(context);
 }
 
 } // namespace devilution
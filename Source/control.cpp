@@ -7,6 +7,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstring>
 
 #include <fmt/format.h>
 
@@ -114,6 +115,41 @@ bool WhisperList[MAX_PLRS];
 char panelstr[4][64];
 uint8_t SplTransTbl[256];
 
+/**
+ * @brief Everything the control panel shows, the panel is only redrawn when this changes
+ *
+ * Compared bytewise, so it is cleared before it is filled in.
+ */
+struct MainPanelState {
+	Point position;
+	int talkTable;
+	UiFlags infoColor;
+	int infoLines;
+	char info[64];
+	char infoLineText[4][64];
+	int lifeFill;
+	int manaFill;
+	spell_type spellTrans;
+	int spellFrame;
+	bool buttons[7];
+	int buttonCount;
+	int hoveredItem;
+	struct {
+		int frame;
+		bool usable;
+		bool numbered;
+		uint8_t outline;
+	} belt[MAXBELTITEMS];
+	int charLevel;
+	uint64_t experience;
+};
+
+/** Copy of the control panel as it was last drawn */
+std::optional<OwnedSurface> MainPanelLayer;
+/** What MainPanelLayer shows, only valid when MainPanelLayerValid is set */
+MainPanelState MainPanelLayerState;
+bool MainPanelLayerValid;
+
 /** Maps from spell_id to spelicon.cel frame number. */
 char SpellITbl[] = {
 	27,
@@ -634,18 +670,10 @@ bool GetSpellListSelection(spell_id &pSpell, spell_type &pSplType)
 	return false;
 }
 
-} // namespace
-
-bool IsChatAvailable()
-{
-#ifdef _DEBUG
-	return true;
-#else
-	return false;
-#endif
-}
-
-void DrawSpell(const Surface &out)
+/**
+ * @brief Works out which icon is shown for the readied spell and whether it is greyed out
+ */
+void GetReadiedSpellIcon(spell_type &trans, int &frame)
 {
 	auto &myPlayer = Players[MyPlayerId];
 	spell_id spl = myPlayer._pRSpell;
@@ -661,8 +689,80 @@ void DrawSpell(const Surface &out)
 	}
 	if (currlevel == 0 && st != RSPLTYPE_INVALID && !spelldata[spl].sTownSpell)
 		st = RSPLTYPE_INVALID;
+
+	trans = st;
+	frame = (spl != SPL_INVALID) ? SpellITbl[spl] : 27;
+}
+
+void GetMainPanelState(MainPanelState &state)
+{
+	memset(&state, 0, sizeof(state));
+
+	auto &myPlayer = Players[MyPlayerId];
+
+	state.position = { PANEL_X, PANEL_Y };
+	state.talkTable = sgbPlrTalkTbl;
+	state.infoColor = InfoColor;
+	state.infoLines = pnumlines;
+	strcpy(state.info, infostr);
+	for (int i = 0; i < pnumlines; i++)
+		strcpy(state.infoLineText[i], panelstr[i]);
+	state.lifeFill = myPlayer._pHPPer;
+	state.manaFill = myPlayer._pManaPer;
+	GetReadiedSpellIcon(state.spellTrans, state.spellFrame);
+	memcpy(state.buttons, PanelButtons, sizeof(state.buttons));
+	state.buttonCount = PanelButtonIndex;
+	state.hoveredItem = pcursinvitem;
+	for (int i = 0; i < MAXBELTITEMS; i++) {
+		const Item &item = myPlayer.SpdList[i];
+		if (item.isEmpty()) {
+			state.belt[i].frame = -1;
+			continue;
+		}
+		state.belt[i].frame = item._iCurs + CURSOR_FIRSTITEM;
+		state.belt[i].usable = item._iStatFlag;
+		state.belt[i].numbered = AllItemsList[item.IDidx].iUsable && item._iStatFlag && item._itype != ItemType::Gold;
+		if (pcursinvitem == i + INVITEM_BELT_FIRST)
+			state.belt[i].outline = GetOutlineColor(item, true);
+	}
+	state.charLevel = myPlayer._pLevel;
+	state.experience = myPlayer._pExperience;
+}
+
+void DrawMainPanelWidgets(const Surface &out)
+{
+	DrawPanelBox(out, { 0, sgbPlrTalkTbl + 16, PANEL_WIDTH, PANEL_HEIGHT }, { PANEL_X, PANEL_Y });
+	DrawPanelBox(out, { 177, 62, 288, 60 }, { PANEL_X + 177, PANEL_Y + 46 });
+	if (infostr[0] != '\0' || pnumlines != 0)
+		PrintInfo(out);
+	DrawLifeFlaskLower(out);
+	DrawManaFlaskLower(out);
+	DrawSpell(out);
+	DrawCtrlBtns(out);
+	DrawInvBelt(out);
+	if (talkflag) {
+		DrawTalkPan(out);
+	}
+	DrawXPBar(out);
+}
+
+} // namespace
+
+bool IsChatAvailable()
+{
+#ifdef _DEBUG
+	return true;
+#else
+	return false;
+#endif
+}
+
+void DrawSpell(const Surface &out)
+{
+	spell_type st;
+	int nCel;
+	GetReadiedSpellIcon(st, nCel);
 	SetSpellTrans(st);
-	const int nCel = (spl != SPL_INVALID) ? SpellITbl[spl] : 27;
 	const Point position { PANEL_X + 565, PANEL_Y + 119 };
 	DrawSpellCel(out, position, *pSpellCels, nCel);
 }
@@ -889,6 +989,8 @@ void control_update_life_mana()
 void InitControlPan()
 {
 	pBtmBuff.emplace(PANEL_WIDTH, (PANEL_HEIGHT + 16) * (IsChatAvailable() ? 2 : 1));
+	MainPanelLayer.emplace(PANEL_WIDTH, PANEL_HEIGHT);
+	MainPanelLayerValid = false;
 	pManaBuff.emplace(88, 88);
 	pLifeBuff.emplace(88, 88);
 
@@ -966,10 +1068,28 @@ void InitControlPan()
 	CalculatePanelAreas();
 }
 
-void DrawCtrlPan(const Surface &out)
+void DrawMainPanel(const Surface &out)
 {
-	DrawPanelBox(out, { 0, sgbPlrTalkTbl + 16, PANEL_WIDTH, PANEL_HEIGHT }, { PANEL_X, PANEL_Y });
-	DrawInfoBox(out);
+	UpdateInfoBox();
+
+	// The chat box redraws every frame, and a panel that doesn't fit on the screen can't be copied back in one piece
+	if (talkflag || PANEL_X < 0 || PANEL_Y < 0 || PANEL_X + PANEL_WIDTH > out.w()) {
+		MainPanelLayerValid = false;
+		DrawMainPanelWidgets(out);
+		return;
+	}
+
+	MainPanelState state;
+	GetMainPanelState(state);
+	if (MainPanelLayerValid && memcmp(&state, &MainPanelLayerState, sizeof(state)) == 0) {
+		out.BlitFrom(*MainPanelLayer, MakeSdlRect(0, 0, PANEL_WIDTH, PANEL_HEIGHT), { PANEL_X, PANEL_Y });
+		return;
+	}
+
+	DrawMainPanelWidgets(out);
+	MainPanelLayer->BlitFrom(out, MakeSdlRect(PANEL_X, PANEL_Y, PANEL_WIDTH, PANEL_HEIGHT), { 0, 0 });
+	MainPanelLayerState = state;
+	MainPanelLayerValid = true;
 }
 
 void DrawCtrlBtns(const Surface &out)
@@ -1260,6 +1380,8 @@ void CheckBtnUp()
 void FreeControlPan()
 {
 	pBtmBuff = std::nullopt;
+	MainPanelLayer = std::nullopt;
+	MainPanelLayerValid = false;
 	pManaBuff = std::nullopt;
 	pLifeBuff = std::nullopt;
 	pSpellCels = std::nullopt;
@@ -1277,9 +1399,8 @@ void FreeControlPan()
 	FreeCharPanel();
 }
 
-void DrawInfoBox(const Surface &out)
+void UpdateInfoBox()
 {
-	DrawPanelBox(out, { 177, 62, 288, 60 }, { PANEL_X + 177, PANEL_Y + 46 });
 	if (!panelflag && !trigflag && pcursinvitem == -1 && !spselflag) {
 		infostr[0] = '\0';
 		InfoColor = UiFlags::ColorWhite;
@@ -1311,9 +1432,9 @@ void DrawInfoBox(const Surface &out)
 			const auto &monster = Monsters[pcursmonst];
 			if (leveltype != DTYPE_TOWN) {
 				InfoColor = UiFlags::ColorWhite;
-				strcpy(infostr, monster.mName);
+				strcpy(infostr, monster.Stats().mName);
 				ClearPanel();
-				if (monster._uniqtype != 0) {
+				if (monster.Stats()._uniqtype != 0) {
 					InfoColor = UiFlags::ColorWhitegold;
 					PrintUniqueHistory();
 				} else {
@@ -1336,8 +1457,6 @@ void DrawInfoBox(const Surface &out)
 			AddPanelString(tempstr);
 		}
 	}
-	if (infostr[0] != '\0' || pnumlines != 0)
-		PrintInfo(out);
 }
 
 void CheckLvlBtn()
@@ -112,7 +112,13 @@ void control_update_life_mana();
 void DrawSpell(const Surface &out);
 
 void InitControlPan();
-void DrawCtrlPan(const Surface &out);
+
+/**
+ * @brief Draws the control panel along with the flasks, buttons, belt and experience bar on it.
+ *
+ * The finished panel is kept and copied back on later frames until anything it shows changes.
+ */
+void DrawMainPanel(const Surface &out);
 
 /**
  * Draws the control panel buttons in their current state. If the button is in the default
@@ -153,9 +159,9 @@ void CheckBtnUp();
 void FreeControlPan();
 
 /**
- * Sets a string to be drawn in the info box and then draws it.
+ * Sets the strings to be drawn in the info box.
  */
-void DrawInfoBox(const Surface &out);
+void UpdateInfoBox();
 void CheckLvlBtn();
 void ReleaseLvlBtn();
 void DrawLevelUpIcon(const Surface &out);
@@ -35,8 +35,8 @@ extern int pcursmonst;
 extern Size icursSize28;
 extern Size icursSize;
 extern int8_t pcursinvitem;
-extern int8_t pcursitem;
-extern int8_t pcursobj;
+extern int pcursitem;
+extern int pcursobj;
 extern int8_t pcursplr;
 extern Point cursPosition;
 extern int pcurs;
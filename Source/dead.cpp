@@ -59,12 +59,12 @@ void InitCorpses()
 
 	for (int i = 0; i < ActiveMonsterCount; i++) {
 		auto &monster = Monsters[ActiveMonsters[i]];
-		if (monster._uniqtype != 0) {
+		if (monster.Stats()._uniqtype != 0) {
 			InitDeadAnimationFromMonster(Corpses[nd], *monster.MType);
-			Corpses[nd].translationPaletteIndex = monster._uniqtrans + 4;
+			Corpses[nd].translationPaletteIndex = monster.Stats()._uniqtrans + 4;
 			nd++;
 
-			monster._udeadval = nd;
+			monster.Stats()._udeadval = nd;
 		}
 	}
 
@@ -80,11 +80,11 @@ void SyncUniqDead()
 {
 	for (int i = 0; i < ActiveMonsterCount; i++) {
 		auto &monster = Monsters[ActiveMonsters[i]];
-		if (monster._uniqtype == 0)
+		if (monster.Stats()._uniqtype == 0)
 			continue;
 		for (int dx = 0; dx < MAXDUNX; dx++) {
 			for (int dy = 0; dy < MAXDUNY; dy++) {
-				if ((dCorpse[dx][dy] & 0x1F) == monster._udeadval)
+				if ((dCorpse[dx][dy] & 0x1F) == monster.Stats()._udeadval)
 					ChangeLightXY(monster.mlid, { dx, dy });
 			}
 		}
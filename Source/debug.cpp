@@ -8,22 +8,34 @@
 
 #include <sstream>
 
+#include <SDL.h>
+
 #include "debug.h"
 
 #include "automap.h"
+#include "capture.h"
 #include "control.h"
 #include "cursor.h"
 #include "engine/load_cel.hpp"
 #include "engine/point.hpp"
+#include "engine/random.hpp"
 #include "error.h"
 #include "inv.h"
+#include "items.h"
+#include "levelsweep.h"
 #include "lighting.h"
+#include "missiles.h"
 #include "monstdat.h"
 #include "monster.h"
+#include "objects.h"
+#include "options.h"
+#include "player.h"
 #include "setmaps.h"
 #include "spells.h"
 #include "towners.h"
 #include "quests.h"
+#include "utils/file_util.h"
+#include "utils/paths.h"
 
 namespace devilution {
 
@@ -78,7 +90,7 @@ void PrintDebugMonster(int m)
 
 	auto &monster = Monsters[m];
 
-	sprintf(dstr, "Monster %i = %s", m, monster.mName);
+	sprintf(dstr, "Monster %i = %s", m, monster.Stats().mName);
 	NetSendCmdString(1 << MyPlayerId, dstr);
 	sprintf(dstr, "X = %i, Y = %i", monster.position.tile.x, monster.position.tile.y);
 	NetSendCmdString(1 << MyPlayerId, dstr);
@@ -474,6 +486,132 @@ std::string DebugCmdLevelSeed(const std::string_view parameter)
 	return fmt::format("Seedinfo for level {}\nseed: {}\nMid1: {}\nMid2: {}\nMid3: {}\nEnd: {}", currlevel, glSeedTbl[currlevel], glMid1Seed[currlevel], glMid2Seed[currlevel], glMid3Seed[currlevel], glEndSeed[currlevel]);
 }
 
+std::string DebugCmdSeedSweep(const std::string_view parameter)
+{
+	std::stringstream paramsStream(parameter.data());
+	int level = 0;
+	int count = 1000;
+	uint32_t firstSeed = 0;
+	paramsStream >> level >> count >> firstSeed;
+	if (level == 16)
+		return "Diablo's lair is loaded from the game data, there is nothing to sweep.";
+	if (!CanSweepLevel(level))
+		return "Which dungeon level should be generated?";
+	if (count < 1)
+		return "Can't generate less than one level.";
+
+	int threadCount;
+	uint64_t start = SDL_GetPerformanceCounter();
+	std::vector<SeedSweepResult> results = SweepLevelSeeds(level, firstSeed, count, true, threadCount);
+	uint64_t wallTicks = SDL_GetPerformanceCounter() - start;
+
+	std::string summary = DescribeSeedSweep(level, results, wallTicks, threadCount);
+
+	// The first sweep of a level records the layouts, later sweeps check that the generators still produce the same ones
+	std::string goldenPath = fmt::format("{}seedsweep_{}.txt", paths::PrefPath(), level);
+	if (FileExists(goldenPath.c_str())) {
+		auto stream = CreateFileStream(goldenPath.c_str(), std::fstream::in);
+		if (!stream)
+			return summary;
+		SeedSweepRecording golden;
+		if (!ReadSeedSweep(*stream, golden))
+			return summary + fmt::format("\n{} is not a recorded sweep.", goldenPath);
+
+		int compared;
+		const SeedSweepResult *firstMismatch = nullptr;
+		int mismatches = CompareSeedSweep(results, golden, compared, &firstMismatch);
+		if (firstMismatch != nullptr)
+			summary += fmt::format("\nSeed {} no longer matches {}.", firstMismatch->seed, goldenPath);
+		return summary + fmt::format("\n{} of {} recorded layouts differ.", mismatches, compared);
+	}
+
+	auto stream = CreateFileStream(goldenPath.c_str(), std::fstream::out | std::fstream::trunc);
+	if (!stream)
+		return summary;
+	WriteSeedSweep(*stream, results);
+	return summary + fmt::format("\nRecorded the layouts to {}.", goldenPath);
+}
+
+/**
+ * @brief Finds the monster whose name contains the given text, unique monsters are matched to their base type
+ * @param name Lower case part of the name
+ * @return Index into MonstersData or -1 if no monster matches
+ */
+int FindMonsterType(const std::string &name)
+{
+	for (int i = 0; i < 138; i++) {
+		auto mondata = MonstersData[i];
+		std::string monsterName(mondata.mName);
+		std::transform(monsterName.begin(), monsterName.end(), monsterName.begin(), [](unsigned char c) { return std::tolower(c); });
+		if (monsterName.find(name) == std::string::npos)
+			continue;
+		return i;
+	}
+
+	for (int i = 0; i < 100; i++) {
+		auto mondata = UniqueMonstersData[i];
+		std::string monsterName(mondata.mName);
+		std::transform(monsterName.begin(), monsterName.end(), monsterName.begin(), [](unsigned char c) { return std::tolower(c); });
+		if (monsterName.find(name) == std::string::npos)
+			continue;
+		return mondata.mtype;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Loads the graphics of a monster type if the current level doesn't use it yet
+ * @return Index into LevelMonsterTypes
+ */
+int LoadLevelMonsterType(int mtype)
+{
+	for (int i = 0; i < LevelMonsterTypeCount; i++) {
+		if (LevelMonsterTypes[i].mtype == mtype)
+			return i;
+	}
+
+	int id = MAX_LVLMTYPES - 1;
+	LevelMonsterTypes[id].mtype = static_cast<_monster_id>(mtype);
+	InitMonsterGFX(id);
+	LevelMonsterTypes[id].mPlaceFlags |= PLACE_SCATTER;
+	LevelMonsterTypes[id].mdeadval = 1;
+	return id;
+}
+
+/**
+ * @brief Places monsters on the free tiles closest to the player
+ * @param ids Level monster types to place, they take turns
+ * @param count Number of monsters to place
+ * @return Number of monsters that were placed
+ */
+int SpawnMonstersNearPlayer(const std::vector<int> &ids, int count)
+{
+	auto &myPlayer = Players[MyPlayerId];
+
+	int spawnedMonster = 0;
+
+	for (int k : CrawlNum) {
+		int ck = k + 2;
+		for (auto j = static_cast<uint8_t>(CrawlTable[k]); j > 0; j--, ck += 2) {
+			Point pos = myPlayer.position.tile + Displacement { CrawlTable[ck - 1], CrawlTable[ck] };
+			if (dPlayer[pos.x][pos.y] != 0 || dMonster[pos.x][pos.y] != 0)
+				continue;
+			if (!IsTileWalkable(pos))
+				continue;
+
+			if (AddMonster(pos, myPlayer._pdir, ids[spawnedMonster % ids.size()], true) < 0)
+				return spawnedMonster;
+			spawnedMonster += 1;
+
+			if (spawnedMonster >= count)
+				return spawnedMonster;
+		}
+	}
+
+	return spawnedMonster;
+}
+
 std::string DebugCmdSpawnMonster(const std::string_view parameter)
 {
 	if (currlevel == 0)
@@ -499,73 +637,281 @@ std::string DebugCmdSpawnMonster(const std::string_view parameter)
 
 	std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
 
-	int mtype = -1;
-	for (int i = 0; i < 138; i++) {
-		auto mondata = MonstersData[i];
-		std::string monsterName(mondata.mName);
-		std::transform(monsterName.begin(), monsterName.end(), monsterName.begin(), [](unsigned char c) { return std::tolower(c); });
-		if (monsterName.find(name) == std::string::npos)
-			continue;
-		mtype = i;
-		break;
-	}
+	int mtype = FindMonsterType(name);
+	if (mtype == -1)
+		return "Monster not found!";
 
-	if (mtype == -1) {
-		for (int i = 0; i < 100; i++) {
-			auto mondata = UniqueMonstersData[i];
-			std::string monsterName(mondata.mName);
-			std::transform(monsterName.begin(), monsterName.end(), monsterName.begin(), [](unsigned char c) { return std::tolower(c); });
-			if (monsterName.find(name) == std::string::npos)
-				continue;
-			mtype = mondata.mtype;
+	int spawnedMonster = SpawnMonstersNearPlayer({ LoadLevelMonsterType(mtype) }, count);
+	if (spawnedMonster < count)
+		return fmt::format("I could only summon {} Monsters. The rest strike for shorter working hours.", spawnedMonster);
+
+	return "Let the fighting begin!";
+}
+
+/** Seed used by every stress command so the same commands on the same level give the same workload */
+constexpr uint32_t StressSeed = 0x5EED;
+/** Spell level the stress missiles are cast with */
+constexpr int StressSpellLevel = 15;
+/** Missile slots left free so monsters and traps can still shoot while the missile list is full */
+constexpr int StressMissileReserve = 16;
+constexpr int StressLightRadius = 10;
+
+/** Spell that tops up the missile list every tick of a stress run */
+spell_id StressSpell = SPL_NULL;
+std::vector<int> StressLights;
+std::vector<int> StressVisions;
+
+/**
+ * @brief Casts the spell from the player in all directions until the missile list is full
+ * @return Number of casts
+ */
+int FillMissiles(spell_id spell)
+{
+	auto &myPlayer = Players[MyPlayerId];
+	Point origin = myPlayer.position.tile;
+
+	int casts = 0;
+	while (ActiveMissileCount < sgGameInitInfo.nMissileLimit - StressMissileReserve) {
+		int missileCount = ActiveMissileCount;
+		Point target = origin + Displacement(static_cast<Direction>(casts % 8)) * (2 + casts / 8 % 8);
+		CastSpell(MyPlayerId, spell, origin.x, origin.y, target.x, target.y, StressSpellLevel);
+		// Some spells replace their previous missile instead of adding one
+		if (ActiveMissileCount <= missileCount)
 			break;
-		}
+		casts++;
 	}
 
-	if (mtype == -1)
-		return "Monster not found!";
+	myPlayer._pMana = myPlayer._pMaxMana;
+	myPlayer._pManaBase = myPlayer._pMaxManaBase;
 
-	int id = MAX_LVLMTYPES - 1;
-	bool found = false;
+	return casts;
+}
 
-	for (int i = 0; i < LevelMonsterTypeCount; i++) {
-		if (LevelMonsterTypes[i].mtype == mtype) {
-			id = i;
-			found = true;
-			break;
-		}
+/**
+ * @brief Moves the stress lights and visions around the player so they are recalculated every tick
+ */
+void MoveStressLights(int tick)
+{
+	Point origin = Players[MyPlayerId].position.tile;
+	for (int i = 0; i < static_cast<int>(StressLights.size()); i++) {
+		auto direction = static_cast<Direction>((tick + i) % 8);
+		Point position = origin + Displacement(direction) * (1 + i % 4);
+		ChangeLightXY(StressLights[i], position);
+		ChangeVisionXY(StressVisions[i], position);
 	}
+}
+
+std::string StressMonsters(std::stringstream &paramsStream)
+{
+	if (currlevel == 0)
+		return "Do you want to kill the towners?!?";
+
+	int count = 0;
+	paramsStream >> count;
+	if (count < 1)
+		return "How many monsters should be summoned?";
 
-	if (!found) {
-		LevelMonsterTypes[id].mtype = static_cast<_monster_id>(mtype);
-		InitMonsterGFX(id);
-		LevelMonsterTypes[id].mPlaceFlags |= PLACE_SCATTER;
-		LevelMonsterTypes[id].mdeadval = 1;
+	std::string name;
+	std::string singleWord;
+	while (std::getline(paramsStream >> std::ws, singleWord, ' ')) {
+		if (!name.empty())
+			name.append(" ");
+		name.append(singleWord);
 	}
+	std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
 
-	auto &myPlayer = Players[MyPlayerId];
+	std::vector<int> ids;
+	if (name.empty()) {
+		for (int i = 0; i < LevelMonsterTypeCount; i++)
+			ids.push_back(i);
+	} else {
+		int mtype = FindMonsterType(name);
+		if (mtype == -1)
+			return "Monster not found!";
+		ids.push_back(LoadLevelMonsterType(mtype));
+	}
+	if (ids.empty())
+		return "This level has no monsters to summon.";
 
-	int spawnedMonster = 0;
+	SetRndSeed(StressSeed);
+	int spawnedMonster = SpawnMonstersNearPlayer(ids, count);
+	return fmt::format("Summoned {} monsters, {} are active.", spawnedMonster, ActiveMonsterCount);
+}
 
-	for (int k : CrawlNum) {
-		int ck = k + 2;
-		for (auto j = static_cast<uint8_t>(CrawlTable[k]); j > 0; j--, ck += 2) {
-			Point pos = myPlayer.position.tile + Displacement { CrawlTable[ck - 1], CrawlTable[ck] };
-			if (dPlayer[pos.x][pos.y] != 0 || dMonster[pos.x][pos.y] != 0)
+std::string StressMissiles(std::stringstream &paramsStream)
+{
+	std::string name;
+	std::getline(paramsStream >> std::ws, name);
+	std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+
+	if (name == "off") {
+		StressSpell = SPL_NULL;
+		return "Missiles are no longer refilled.";
+	}
+
+	spell_id spell = SPL_FIREBOLT;
+	if (!name.empty()) {
+		spell = SPL_NULL;
+		for (int i = SPL_FIREBOLT; i < MAX_SPELLS; i++) {
+			if (spelldata[i].sNameText == nullptr || spelldata[i].sMissiles[0] == MIS_NULL)
 				continue;
-			if (!IsTileWalkable(pos))
+			std::string spellName(spelldata[i].sNameText);
+			std::transform(spellName.begin(), spellName.end(), spellName.begin(), [](unsigned char c) { return std::tolower(c); });
+			if (spellName.find(name) == std::string::npos)
 				continue;
+			spell = static_cast<spell_id>(i);
+			break;
+		}
+		if (spell == SPL_NULL)
+			return "Spell not found!";
+	}
 
-			if (AddMonster(pos, myPlayer._pdir, id, true) < 0)
-				return fmt::format("I could only summon {} Monsters. The rest strike for shorter working hours.", spawnedMonster);
-			spawnedMonster += 1;
+	StressSpell = spell;
+	SetRndSeed(StressSeed);
+	int casts = FillMissiles(spell);
+	return fmt::format("Cast {} {} times, {} of {} missiles are active.", spelldata[spell].sNameText, casts, ActiveMissileCount, sgGameInitInfo.nMissileLimit);
+}
 
-			if (spawnedMonster >= count)
-				return "Let the fighting begin!";
+std::string StressItems(std::stringstream &paramsStream)
+{
+	int count = 0;
+	paramsStream >> count;
+	if (count < 1)
+		return "How many items should be dropped?";
+
+	SetRndSeed(StressSeed);
+	Point origin = Players[MyPlayerId].position.tile;
+	int dropped = 0;
+	for (int i = 0; i < count && ActiveItemCount < sgGameInitInfo.nItemLimit; i++) {
+		// Each item looks for the free tile nearest to a random spot around the player
+		Point position = origin + Displacement { GenerateRnd(31) - 15, GenerateRnd(31) - 15 };
+		position.x = std::clamp(position.x, 16, MAXDUNX - 17);
+		position.y = std::clamp(position.y, 16, MAXDUNY - 17);
+		int itemCount = ActiveItemCount;
+		CreateRndItem(position, false, false, false);
+		// Not every roll gives an item and there might be no free tile left nearby
+		if (ActiveItemCount > itemCount)
+			dropped++;
+	}
+
+	return fmt::format("Dropped {} items, {} of {} are on the ground.", dropped, ActiveItemCount, sgGameInitInfo.nItemLimit);
+}
+
+std::string StressLighting(std::stringstream &paramsStream)
+{
+	int count = 0;
+	paramsStream >> count;
+
+	for (int light : StressLights)
+		AddUnLight(light);
+	for (int vision : StressVisions)
+		AddUnVision(vision);
+	StressLights.clear();
+	StressVisions.clear();
+
+	Point origin = Players[MyPlayerId].position.tile;
+	for (int i = 0; i < count; i++) {
+		int light = AddLight(origin, StressLightRadius);
+		int vision = AddVision(origin, StressLightRadius, false);
+		if (light == NO_LIGHT || vision == -1) {
+			if (light != NO_LIGHT)
+				AddUnLight(light);
+			if (vision != -1)
+				AddUnVision(vision);
+			break;
 		}
+		StressLights.push_back(light);
+		StressVisions.push_back(vision);
 	}
 
-	return fmt::format("I could only summon {} Monsters. The rest strike for shorter working hours.", spawnedMonster);
+	if (StressLights.empty())
+		return "Removed the stress lights.";
+	return fmt::format("{} lights and visions move around the player during stress runs.", StressLights.size());
+}
+
+/** @brief Part of a game tick that a stress run times on its own */
+struct StressPhase {
+	const char *name;
+	GameLogicStep step;
+	void (*process)();
+	uint64_t ticks;
+};
+
+std::string StressRun(std::stringstream &paramsStream)
+{
+	int tickCount = 100;
+	paramsStream >> tickCount;
+	if (tickCount < 1)
+		return "How many ticks should be run?";
+
+	std::vector<StressPhase> phases;
+	if (gbProcessPlayers)
+		phases.push_back({ "Players", GameLogicStep::ProcessPlayers, &ProcessPlayers, 0 });
+	if (leveltype != DTYPE_TOWN) {
+		phases.push_back({ "Monsters", GameLogicStep::ProcessMonsters, &ProcessMonsters, 0 });
+		phases.push_back({ "Objects", GameLogicStep::ProcessObjects, &ProcessObjects, 0 });
+		phases.push_back({ "Missiles", GameLogicStep::ProcessMissiles, &ProcessMissiles, 0 });
+		phases.push_back({ "Items", GameLogicStep::ProcessItems, &ProcessItems, 0 });
+		phases.push_back({ "Lights", GameLogicStep::None, &ProcessLightList, 0 });
+		phases.push_back({ "Vision", GameLogicStep::None, &ProcessVisionList, 0 });
+	} else {
+		phases.push_back({ "Towners", GameLogicStep::ProcessTowners, &ProcessTowners, 0 });
+		phases.push_back({ "Items", GameLogicStep::ProcessItemsTown, &ProcessItems, 0 });
+		phases.push_back({ "Missiles", GameLogicStep::ProcessMissilesTown, &ProcessMissiles, 0 });
+	}
+
+	SetRndSeed(StressSeed);
+	int peakMonsters = ActiveMonsterCount;
+	int peakMissiles = ActiveMissileCount;
+	for (int tick = 0; tick < tickCount; tick++) {
+		if (StressSpell != SPL_NULL)
+			FillMissiles(StressSpell);
+		MoveStressLights(tick);
+		for (StressPhase &phase : phases) {
+			gGameLogicStep = phase.step;
+			uint64_t start = SDL_GetPerformanceCounter();
+			phase.process();
+			phase.ticks += SDL_GetPerformanceCounter() - start;
+		}
+		gGameLogicStep = GameLogicStep::None;
+		peakMonsters = std::max(peakMonsters, ActiveMonsterCount);
+		peakMissiles = std::max(peakMissiles, ActiveMissileCount);
+	}
+
+	uint64_t totalTicks = 0;
+	for (const StressPhase &phase : phases)
+		totalTicks += phase.ticks;
+	double ticksPerMillisecond = SDL_GetPerformanceFrequency() / 1000.0;
+	double totalMilliseconds = std::max(totalTicks / ticksPerMillisecond, 0.001);
+
+	std::string report = fmt::format("Ran {} ticks in {:.1f} ms, {:.0f} ticks/s.\nPeak {} monsters, {} missiles, {} items, {} lights.",
+	    tickCount, totalMilliseconds, tickCount * 1000.0 / totalMilliseconds,
+	    peakMonsters, peakMissiles, ActiveItemCount, ActiveLightCount);
+	for (const StressPhase &phase : phases) {
+		double milliseconds = phase.ticks / ticksPerMillisecond;
+		report += fmt::format("\n{}: {:.3f} ms per tick, {:.0f}%", phase.name, milliseconds / tickCount, milliseconds * 100 / totalMilliseconds);
+	}
+	return report;
+}
+
+std::string DebugCmdStress(const std::string_view parameter)
+{
+	std::stringstream paramsStream(parameter.data());
+	std::string load;
+	paramsStream >> load;
+
+	if (load == "monsters")
+		return StressMonsters(paramsStream);
+	if (load == "missiles")
+		return StressMissiles(paramsStream);
+	if (load == "items")
+		return StressItems(paramsStream);
+	if (load == "lights")
+		return StressLighting(paramsStream);
+	if (load == "run")
+		return StressRun(paramsStream);
+
+	return "Stress what? Try monsters, missiles, items, lights or run.";
 }
 
 std::string DebugCmdShowTileData(const std::string_view parameter)
@@ -626,6 +972,18 @@ std::string DebugCmdScrollView(const std::string_view parameter)
 	return "If you want to see the world, you need to explore it yourself.";
 }
 
+std::string DebugCmdCaptureFrames(const std::string_view parameter)
+{
+	std::stringstream paramsStream(parameter.data());
+	int count = 60;
+	paramsStream >> count;
+	if (count < 1)
+		return "Can't capture less than one frame.";
+
+	CaptureFrames(count);
+	return fmt::format("Capturing the next {} frames.", count);
+}
+
 std::string DebugCmdItemInfo(const std::string_view parameter)
 {
 	auto &myPlayer = Players[MyPlayerId];
@@ -707,9 +1065,12 @@ std::vector<DebugCmdItem> DebugCmdList = {
 	{ "arrow", "Changes arrow effect (normal, fire, lightning, explosion).", "{effect}", &DebugCmdArrow },
 	{ "grid", "Toggles showing grid.", "", &DebugCmdShowGrid },
 	{ "seedinfo", "Show seed infos for current level.", "", &DebugCmdLevelSeed },
+	{ "seedsweep", "Generates {count} layouts of {level} and compares them with the last recorded sweep.", "{level} ({count}) ({seed})", &DebugCmdSeedSweep },
 	{ "spawn", "Spawns monster {name}.", "({count}) {name}", &DebugCmdSpawnMonster },
 	{ "tiledata", "Toggles showing tile data {name} (leave name empty to see a list).", "{name}", &DebugCmdShowTileData },
 	{ "scrollview", "Toggles scroll view feature (with shift+mouse).", "", &DebugCmdScrollView },
+	{ "capture", "Saves the next {count} frames with their timings.", "({count})", &DebugCmdCaptureFrames },
+	{ "stress", "Builds a repeatable worst case load around the player and times the game logic under it.", "{monsters|missiles|items|lights|run} ({count}) ({name})", &DebugCmdStress },
 	{ "iteminfo", "Shows info of currently selected item.", "", &DebugCmdItemInfo },
 	{ "questinfo", "Shows info of quests.", "{id}", &DebugCmdQuestInfo },
 	{ "playerinfo", "Shows info of player.", "{playerid}", &DebugCmdPlayerInfo },
@@ -722,6 +1083,13 @@ void LoadDebugGFX()
 	pSquareCel = LoadCel("Data\\Square.CEL", 64);
 }
 
+void ClearStressState()
+{
+	StressSpell = SPL_NULL;
+	StressLights.clear();
+	StressVisions.clear();
+}
+
 void FreeDebugGFX()
 {
 	pSquareCel = std::nullopt;
@@ -22,6 +22,10 @@ extern bool DebugGrid;
 extern std::unordered_map<int, Point> DebugCoordsMap;
 extern bool DebugScrollViewEnabled;
 
+/**
+ * @brief Forgets the missiles, lights and visions added by the stress command, their ids are reused by the next level
+ */
+void ClearStressState();
 void FreeDebugGFX();
 void LoadDebugGFX();
 void GetDebugMonster();
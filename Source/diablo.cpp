@@ -31,11 +31,13 @@
 #include "engine/load_cel.hpp"
 #include "engine/load_file.hpp"
 #include "engine/random.hpp"
+#include "engine/render/cl2_render.hpp"
 #include "error.h"
 #include "gamemenu.h"
 #include "gmenu.h"
 #include "help.h"
 #include "init.h"
+#include "levelpregen.h"
 #include "lighting.h"
 #include "loadsave.h"
 #include "menu.h"
@@ -51,6 +53,7 @@
 #include "qol/common.h"
 #include "qol/itemlabels.h"
 #include "restrict.h"
+#include "scrollrt.h"
 #include "setmaps.h"
 #include "sound.h"
 #include "stores.h"
@@ -105,6 +108,8 @@ bool was_archives_init = false;
 bool was_window_init = false;
 bool was_ui_init = false;
 bool was_snd_init = false;
+/** Longest time the paused game sleeps without a message, in milliseconds */
+constexpr uint32_t MaxPausedWait = 500;
 
 void StartGame(interface_mode uMsg)
 {
@@ -141,6 +146,8 @@ void FreeGame()
 #ifdef _DEBUG
 	FreeDebugGFX();
 #endif
+	CancelLevelPregeneration();
+	FinishFrameCaptures();
 	FreeGameMem();
 }
 
@@ -610,6 +617,8 @@ void RunGameLoop(interface_mode uMsg)
 	gbRunGame = true;
 	gbProcessPlayers = true;
 	gbRunGameResult = true;
+	if (sgOptions.Graphics.bRenderThread)
+		StartWorldRenderThread();
 	DrawAndBlit();
 	LoadPWaterPalette();
 	PaletteFadeIn(8);
@@ -627,6 +636,10 @@ void RunGameLoop(interface_mode uMsg)
 		}
 #endif
 
+		// Nothing on screen changes while the game is paused, sleep until there is input instead of redrawing
+		if (PauseMode == 2 && !gmenu_is_active() && !WaitForMessage(MaxPausedWait))
+			continue;
+
 		while (FetchMessage(&msg)) {
 			if (msg.message == DVL_WM_QUIT) {
 				gbRunGameResult = false;
@@ -653,12 +666,15 @@ void RunGameLoop(interface_mode uMsg)
 
 		diablo_color_cyc_logic();
 		multi_process_network_packets();
+		const Uint64 tickStart = SDL_GetPerformanceCounter();
 		game_loop(gbGameLoopStartup);
+		RecordGameTickTime(SDL_GetPerformanceCounter() - tickStart);
 		gbGameLoopStartup = false;
 		if (drawGame)
 			DrawAndBlit();
 	}
 
+	StopWorldRenderThread();
 	PaletteFadeOut(8);
 	NewCursor(CURSOR_NONE);
 	ClearScreenBuffer();
@@ -1319,6 +1335,7 @@ void LoadGameFonts()
 void FreeGameMem()
 {
 	music_stop();
+	Cl2ClearDecodeCache();
 
 	pDungeonCels = nullptr;
 	pMegaTiles = nullptr;
@@ -1330,6 +1347,9 @@ void FreeGameMem()
 	FreeObjectGFX();
 	FreeMonsterSnd();
 	FreeTownerGFX();
+#ifdef _DEBUG
+	ClearStressState();
+#endif
 }
 
 bool StartGame(bool bNewGame)
@@ -1831,6 +1851,8 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 		music_mute();
 	}
 
+	PregenerateAdjacentLevels();
+
 	while (!IncProgress())
 		;
 
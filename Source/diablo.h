@@ -18,8 +18,6 @@
 
 namespace devilution {
 
-#define NUMLEVELS 25
-
 enum clicktype : int8_t {
 	CLICK_NONE,
 	CLICK_LEFT,
@@ -5,10 +5,12 @@
  */
 #include "drlg_l1.h"
 
+#include "drlg_pattern.h"
 #include "engine/load_file.hpp"
 #include "engine/point.hpp"
 #include "engine/random.hpp"
 #include "gendung.h"
+#include "levelpregen.h"
 #include "player.h"
 #include "quests.h"
 
@@ -22,27 +24,6 @@ int UberDiabloMonsterIndex;
 
 namespace {
 
-/** Represents a tile ID map of twice the size, repeating each tile of the original map in blocks of 4. */
-BYTE L5dungeon[80][80];
-BYTE L5dflags[DMAXX][DMAXY];
-/** Specifies whether a single player quest DUN has been loaded. */
-bool L5setloadflag;
-/** Specifies whether to generate a horizontal room at position 1 in the Cathedral. */
-bool HR1;
-/** Specifies whether to generate a horizontal room at position 2 in the Cathedral. */
-bool HR2;
-/** Specifies whether to generate a horizontal room at position 3 in the Cathedral. */
-bool HR3;
-
-/** Specifies whether to generate a vertical room at position 1 in the Cathedral. */
-bool VR1;
-/** Specifies whether to generate a vertical room at position 2 in the Cathedral. */
-bool VR2;
-/** Specifies whether to generate a vertical room at position 3 in the Cathedral. */
-bool VR3;
-/** Contains the contents of the single player quest DUN file. */
-std::unique_ptr<uint16_t[]> L5pSetPiece;
-
 /** Contains shadows for 2x2 blocks of base tile IDs in the Cathedral. */
 const ShadowStruct SPATS[37] = {
 	// clang-format off
@@ -502,7 +483,85 @@ BYTE CornerstoneRoomPattern[27] = {
  */
 BYTE L5ConvTbl[16] = { 22, 13, 1, 13, 2, 13, 13, 13, 4, 13, 1, 13, 2, 13, 16, 13 };
 
-void InitCryptPieces()
+class L1Generator : public LevelGenerationContext {
+public:
+	explicit L1Generator(const LevelGenerationContext &context)
+	    : LevelGenerationContext(context)
+	{
+	}
+
+	void LoadDungeon(const char *path, int vx, int vy);
+	void LoadPreDungeon(const char *path);
+	void Generate(uint32_t rseed, lvl_entry entry);
+
+private:
+	/** Represents a tile ID map of twice the size, repeating each tile of the original map in blocks of 4. */
+	BYTE L5dungeon[80][80] = {};
+	BYTE L5dflags[DMAXX][DMAXY] = {};
+	/** Specifies whether a single player quest DUN has been loaded. */
+	bool L5setloadflag = false;
+	/** Specifies whether to generate a horizontal room at position 1 in the Cathedral. */
+	bool HR1 = false;
+	/** Specifies whether to generate a horizontal room at position 2 in the Cathedral. */
+	bool HR2 = false;
+	/** Specifies whether to generate a horizontal room at position 3 in the Cathedral. */
+	bool HR3 = false;
+	/** Specifies whether to generate a vertical room at position 1 in the Cathedral. */
+	bool VR1 = false;
+	/** Specifies whether to generate a vertical room at position 2 in the Cathedral. */
+	bool VR2 = false;
+	/** Specifies whether to generate a vertical room at position 3 in the Cathedral. */
+	bool VR3 = false;
+	/** Contains the contents of the single player quest DUN file. */
+	std::unique_ptr<uint16_t[]> L5pSetPiece;
+
+	void InitCryptPieces();
+	void PlaceDoor(int x, int y);
+	void CryptLavafloor();
+	void ApplyShadowsPatterns();
+	int PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview, int noquad);
+	void PlaceMiniSetRandom(MinisetMatcher &matcher, const BYTE *miniset, int rndper);
+	void FillFloor();
+	void LoadQuestSetPieces();
+	void FreeQuestSetPieces();
+	void InitDungeonPieces();
+	void InitDungeonFlags();
+	void ClearFlags();
+	void MapRoom(int x, int y, int width, int height);
+	bool CheckRoom(int x, int y, int width, int height);
+	void GenerateRoom(int x, int y, int w, int h, int dir);
+	void FirstRoom();
+	int FindArea();
+	void MakeDungeon();
+	void MakeDmt();
+	int HorizontalWallOk(int i, int j);
+	int VerticalWallOk(int i, int j);
+	void HorizontalWall(int i, int j, char p, int dx);
+	void VerticalWall(int i, int j, char p, int dy);
+	void AddWall();
+	void GenerateChamber(int sx, int sy, bool topflag, bool bottomflag, bool leftflag, bool rightflag);
+	void GenerateHall(int x1, int y1, int x2, int y2);
+	void FixTilesPatterns();
+	void SetCornerRoom(int rx1, int ry1);
+	void Substitution();
+	void SetRoom(int rx1, int ry1);
+	void SetCryptRoom(int rx1, int ry1);
+	void FillChambers();
+	void FixTransparency();
+	void FixDirtTiles();
+	void FixCornerTiles();
+	void CryptPatternGroup1(int rndper);
+	void CryptPatternGroup2(int rndper);
+	void CryptPatternGroup3(int rndper);
+	void CryptPatternGroup4(int rndper);
+	void CryptPatternGroup5(int rndper);
+	void CryptPatternGroup6(int rndper);
+	void CryptPatternGroup7(int rndper);
+	void GenerateLevel(lvl_entry entry);
+	void Pass3();
+};
+
+void L1Generator::InitCryptPieces()
 {
 	for (int j = 0; j < MAXDUNY; j++) {
 		for (int i = 0; i < MAXDUNX; i++) {
@@ -515,7 +574,7 @@ void InitCryptPieces()
 	}
 }
 
-void PlaceDoor(int x, int y)
+void L1Generator::PlaceDoor(int x, int y)
 {
 	if ((L5dflags[x][y] & DLRG_PROTECTED) == 0) {
 		BYTE df = L5dflags[x][y] & 0x7F;
@@ -574,7 +633,7 @@ void PlaceDoor(int x, int y)
 	L5dflags[x][y] = DLRG_PROTECTED;
 }
 
-void CryptLavafloor()
+void L1Generator::CryptLavafloor()
 {
 	for (int j = 1; j < 40; j++) {
 		for (int i = 1; i < 40; i++) {
@@ -698,7 +757,7 @@ void CryptLavafloor()
 	}
 }
 
-void ApplyShadowsPatterns()
+void L1Generator::ApplyShadowsPatterns()
 {
 	uint8_t sd[2][2];
 
@@ -759,13 +818,15 @@ void ApplyShadowsPatterns()
 	}
 }
 
-int PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview, int noquad)
+int L1Generator::PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview, int noquad)
 {
 	int sx;
 	int sy;
 
 	int sw = miniset[0];
 	int sh = miniset[1];
+	MinisetSearch search = MinisetSearch::FromMiniset(miniset);
+	MinisetMatcher matcher(dungeon, L5dflags);
 
 	int numt = 1;
 	if (tmax - tmin != 0) {
@@ -808,17 +869,8 @@ int PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool s
 				break;
 			}
 
-			int ii = 2;
-
-			for (int yy = 0; yy < sh && abort; yy++) {
-				for (int xx = 0; xx < sw && abort; xx++) {
-					if (miniset[ii] != 0 && dungeon[xx + sx][sy + yy] != miniset[ii])
-						abort = false;
-					if (L5dflags[xx + sx][sy + yy] != 0)
-						abort = false;
-					ii++;
-				}
-			}
+			if (abort)
+				abort = matcher.Matches(search, { sx, sy });
 
 			if (!abort) {
 				sx++;
@@ -839,7 +891,7 @@ int PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool s
 		for (int yy = 0; yy < sh; yy++) {
 			for (int xx = 0; xx < sw; xx++) {
 				if (miniset[ii] != 0) {
-					dungeon[xx + sx][sy + yy] = miniset[ii];
+					matcher.SetTile({ xx + sx, sy + yy }, miniset[ii]);
 				}
 				ii++;
 			}
@@ -869,32 +921,21 @@ int PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool s
 	return 3;
 }
 
-void PlaceMiniSetRandom(const BYTE *miniset, int rndper)
+void L1Generator::PlaceMiniSetRandom(MinisetMatcher &matcher, const BYTE *miniset, int rndper)
 {
 	int sw = miniset[0];
 	int sh = miniset[1];
+	MinisetSearch search = MinisetSearch::FromMiniset(miniset);
 
 	for (int sy = 0; sy < DMAXY - sh; sy++) {
 		for (int sx = 0; sx < DMAXX - sw; sx++) {
-			bool found = true;
-			int ii = 2;
-			for (int yy = 0; yy < sh && found; yy++) {
-				for (int xx = 0; xx < sw && found; xx++) {
-					if (miniset[ii] != 0 && dungeon[xx + sx][yy + sy] != miniset[ii]) {
-						found = false;
-					}
-					if (dflags[xx + sx][yy + sy] != 0) {
-						found = false;
-					}
-					ii++;
-				}
-			}
+			bool found = matcher.Matches(search, { sx, sy });
 			int kk = sw * sh + 2;
 			if (miniset[kk] >= 84 && miniset[kk] <= 100 && found) {
 				// BUGFIX: accesses to dungeon can go out of bounds (fixed)
 				// BUGFIX: Comparisons vs 100 should use same tile as comparisons vs 84 - NOT A BUG - "fixing" this breaks crypt
 
-				constexpr auto ComparisonWithBoundsCheck = [](Point p1, Point p2) {
+				auto ComparisonWithBoundsCheck = [this](Point p1, Point p2) {
 					return (p1.x >= 0 && p1.x < DMAXX && p1.y >= 0 && p1.y < DMAXY) && (p2.x >= 0 && p2.x < DMAXX && p2.y >= 0 && p2.y < DMAXY) && (dungeon[p1.x][p1.y] >= 84 && dungeon[p2.x][p2.y] <= 100);
 				};
 				if (ComparisonWithBoundsCheck({ sx - 1, sy }, { sx - 1, sy })) {
@@ -914,7 +955,7 @@ void PlaceMiniSetRandom(const BYTE *miniset, int rndper)
 				for (int yy = 0; yy < sh; yy++) {
 					for (int xx = 0; xx < sw; xx++) {
 						if (miniset[kk] != 0) {
-							dungeon[xx + sx][yy + sy] = miniset[kk];
+							matcher.SetTile({ xx + sx, yy + sy }, miniset[kk]);
 						}
 						kk++;
 					}
@@ -924,7 +965,7 @@ void PlaceMiniSetRandom(const BYTE *miniset, int rndper)
 	}
 }
 
-void FillFloor()
+void L1Generator::FillFloor()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -940,28 +981,28 @@ void FillFloor()
 	}
 }
 
-void LoadQuestSetPieces()
+void L1Generator::LoadQuestSetPieces()
 {
 	L5setloadflag = false;
 
-	if (Quests[Q_BUTCHER].IsAvailable()) {
+	if (IsQuestAvailable(Q_BUTCHER)) {
 		L5pSetPiece = LoadFileInMem<uint16_t>("Levels\\L1Data\\rnd6.DUN");
 		L5setloadflag = true;
-	} else if (Quests[Q_SKELKING].IsAvailable()) {
+	} else if (IsQuestAvailable(Q_SKELKING)) {
 		L5pSetPiece = LoadFileInMem<uint16_t>("Levels\\L1Data\\SKngDO.DUN");
 		L5setloadflag = true;
-	} else if (Quests[Q_LTBANNER].IsAvailable()) {
+	} else if (IsQuestAvailable(Q_LTBANNER)) {
 		L5pSetPiece = LoadFileInMem<uint16_t>("Levels\\L1Data\\Banner2.DUN");
 		L5setloadflag = true;
 	}
 }
 
-void FreeQuestSetPieces()
+void L1Generator::FreeQuestSetPieces()
 {
 	L5pSetPiece = nullptr;
 }
 
-void InitDungeonPieces()
+void L1Generator::InitDungeonPieces()
 {
 	for (int j = 0; j < MAXDUNY; j++) {
 		for (int i = 0; i < MAXDUNX; i++) {
@@ -986,7 +1027,7 @@ void InitDungeonPieces()
 	}
 }
 
-void InitDungeonFlags()
+void L1Generator::InitDungeonFlags()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -996,7 +1037,7 @@ void InitDungeonFlags()
 	}
 }
 
-void ClearFlags()
+void L1Generator::ClearFlags()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) { // NOLINT(modernize-loop-convert)
@@ -1005,7 +1046,7 @@ void ClearFlags()
 	}
 }
 
-void MapRoom(int x, int y, int width, int height)
+void L1Generator::MapRoom(int x, int y, int width, int height)
 {
 	for (int j = 0; j < height; j++) {
 		for (int i = 0; i < width; i++) {
@@ -1014,7 +1055,7 @@ void MapRoom(int x, int y, int width, int height)
 	}
 }
 
-bool CheckRoom(int x, int y, int width, int height)
+bool L1Generator::CheckRoom(int x, int y, int width, int height)
 {
 	for (int j = 0; j < height; j++) {
 		for (int i = 0; i < width; i++) {
@@ -1030,7 +1071,7 @@ bool CheckRoom(int x, int y, int width, int height)
 	return true;
 }
 
-void GenerateRoom(int x, int y, int w, int h, int dir)
+void L1Generator::GenerateRoom(int x, int y, int w, int h, int dir)
 {
 	int dirProb = GenerateRnd(4);
 	int num = 0;
@@ -1088,7 +1129,7 @@ void GenerateRoom(int x, int y, int w, int h, int dir)
 		GenerateRoom(rx, ry2, width, height, 0);
 }
 
-void FirstRoom()
+void L1Generator::FirstRoom()
 {
 	if (GenerateRnd(2) == 0) {
 		int ys = 1;
@@ -1175,7 +1216,7 @@ void FirstRoom()
 	}
 }
 
-int FindArea()
+int L1Generator::FindArea()
 {
 	int rv = 0;
 
@@ -1189,7 +1230,7 @@ int FindArea()
 	return rv;
 }
 
-void MakeDungeon()
+void L1Generator::MakeDungeon()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -1203,7 +1244,7 @@ void MakeDungeon()
 	}
 }
 
-void MakeDmt()
+void L1Generator::MakeDmt()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) { // NOLINT(modernize-loop-convert)
@@ -1224,7 +1265,7 @@ void MakeDmt()
 	}
 }
 
-int HorizontalWallOk(int i, int j)
+int L1Generator::HorizontalWallOk(int i, int j)
 {
 	int x;
 	for (x = 1; dungeon[i + x][j] == 13; x++) {
@@ -1248,7 +1289,7 @@ int HorizontalWallOk(int i, int j)
 	return -1;
 }
 
-int VerticalWallOk(int i, int j)
+int L1Generator::VerticalWallOk(int i, int j)
 {
 	int y;
 	for (y = 1; dungeon[i][j + y] == 13; y++) {
@@ -1272,7 +1313,7 @@ int VerticalWallOk(int i, int j)
 	return -1;
 }
 
-void HorizontalWall(int i, int j, char p, int dx)
+void L1Generator::HorizontalWall(int i, int j, char p, int dx)
 {
 	int8_t dt;
 
@@ -1320,7 +1361,7 @@ void HorizontalWall(int i, int j, char p, int dx)
 	}
 }
 
-void VerticalWall(int i, int j, char p, int dy)
+void L1Generator::VerticalWall(int i, int j, char p, int dy)
 {
 	int8_t dt;
 
@@ -1368,7 +1409,7 @@ void VerticalWall(int i, int j, char p, int dy)
 	}
 }
 
-void AddWall()
+void L1Generator::AddWall()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -1420,7 +1461,7 @@ void AddWall()
 	}
 }
 
-void GenerateChamber(int sx, int sy, bool topflag, bool bottomflag, bool leftflag, bool rightflag)
+void L1Generator::GenerateChamber(int sx, int sy, bool topflag, bool bottomflag, bool leftflag, bool rightflag)
 {
 	if (topflag) {
 		dungeon[sx + 2][sy] = 12;
@@ -1476,7 +1517,7 @@ void GenerateChamber(int sx, int sy, bool topflag, bool bottomflag, bool leftfla
 	dungeon[sx + 7][sy + 7] = 15;
 }
 
-void GenerateHall(int x1, int y1, int x2, int y2)
+void L1Generator::GenerateHall(int x1, int y1, int x2, int y2)
 {
 	if (y1 == y2) {
 		for (int i = x1; i < x2; i++) {
@@ -1492,7 +1533,7 @@ void GenerateHall(int x1, int y1, int x2, int y2)
 	}
 }
 
-void FixTilesPatterns()
+void L1Generator::FixTilesPatterns()
 {
 	// BUGFIX: Bounds checks are required in all loop bodies.
 	// See https://github.com/diasurgical/devilutionX/pull/401
@@ -1613,7 +1654,7 @@ void FixTilesPatterns()
 	}
 }
 
-void SetCornerRoom(int rx1, int ry1)
+void L1Generator::SetCornerRoom(int rx1, int ry1)
 {
 	int rw = CornerstoneRoomPattern[0];
 	int rh = CornerstoneRoomPattern[1];
@@ -1637,7 +1678,7 @@ void SetCornerRoom(int rx1, int ry1)
 		}
 	}
 }
-void Substitution()
+void L1Generator::Substitution()
 {
 	for (int y = 0; y < DMAXY; y++) {
 		for (int x = 0; x < DMAXX; x++) {
@@ -1677,7 +1718,7 @@ void Substitution()
 	}
 }
 
-void SetRoom(int rx1, int ry1)
+void L1Generator::SetRoom(int rx1, int ry1)
 {
 	int width = SDL_SwapLE16(L5pSetPiece[0]);
 	int height = SDL_SwapLE16(L5pSetPiece[1]);
@@ -1702,7 +1743,7 @@ void SetRoom(int rx1, int ry1)
 	}
 }
 
-void SetCryptRoom(int rx1, int ry1)
+void L1Generator::SetCryptRoom(int rx1, int ry1)
 {
 	int rw = UberRoomPattern[0];
 	int rh = UberRoomPattern[1];
@@ -1713,8 +1754,6 @@ void SetCryptRoom(int rx1, int ry1)
 	setpc_y = ry1;
 	setpc_w = rw;
 	setpc_h = rh;
-	IsUberRoomOpened = false;
-	IsUberLeverActivated = false;
 
 	int sp = 2;
 
@@ -1731,7 +1770,7 @@ void SetCryptRoom(int rx1, int ry1)
 	}
 }
 
-void FillChambers()
+void L1Generator::FillChambers()
 {
 	if (HR1)
 		GenerateChamber(0, 14, false, false, false, true);
@@ -1951,7 +1990,7 @@ void FillChambers()
 	}
 }
 
-void FixTransparency()
+void L1Generator::FixTransparency()
 {
 	int yy = 16;
 	for (int j = 0; j < DMAXY; j++) {
@@ -1986,7 +2025,7 @@ void FixTransparency()
 	}
 }
 
-void FixDirtTiles()
+void L1Generator::FixDirtTiles()
 {
 	if (currlevel < 21) {
 		for (int j = 0; j < DMAXY - 1; j++) {
@@ -2030,7 +2069,7 @@ void FixDirtTiles()
 	}
 }
 
-void FixCornerTiles()
+void L1Generator::FixCornerTiles()
 {
 	for (int j = 1; j < DMAXY - 1; j++) {
 		for (int i = 1; i < DMAXX - 1; i++) {
@@ -2045,130 +2084,144 @@ void FixCornerTiles()
 	}
 }
 
-void CryptPatternGroup1(int rndper)
+void L1Generator::CryptPatternGroup1(int rndper)
 {
-	PlaceMiniSetRandom(CryptPattern97, rndper);
-	PlaceMiniSetRandom(CryptPattern98, rndper);
-	PlaceMiniSetRandom(CryptPattern99, rndper);
-	PlaceMiniSetRandom(CryptPattern100, rndper);
+	MinisetMatcher matcher(dungeon, dflags);
+
+	PlaceMiniSetRandom(matcher, CryptPattern97, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern98, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern99, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern100, rndper);
 }
 
-void CryptPatternGroup2(int rndper)
+void L1Generator::CryptPatternGroup2(int rndper)
 {
-	PlaceMiniSetRandom(CryptPattern46, rndper);
-	PlaceMiniSetRandom(CryptPattern47, rndper);
-	PlaceMiniSetRandom(CryptPattern48, rndper);
-	PlaceMiniSetRandom(CryptPattern49, rndper);
-	PlaceMiniSetRandom(CryptPattern50, rndper);
-	PlaceMiniSetRandom(CryptPattern51, rndper);
-	PlaceMiniSetRandom(CryptPattern52, rndper);
-	PlaceMiniSetRandom(CryptPattern53, rndper);
-	PlaceMiniSetRandom(CryptPattern54, rndper);
-	PlaceMiniSetRandom(CryptPattern55, rndper);
-	PlaceMiniSetRandom(CryptPattern56, rndper);
-	PlaceMiniSetRandom(CryptPattern57, rndper);
-	PlaceMiniSetRandom(CryptPattern58, rndper);
-	PlaceMiniSetRandom(CryptPattern59, rndper);
-	PlaceMiniSetRandom(CryptPattern60, rndper);
-	PlaceMiniSetRandom(CryptPattern61, rndper);
-	PlaceMiniSetRandom(CryptPattern62, rndper);
+	MinisetMatcher matcher(dungeon, dflags);
+
+	PlaceMiniSetRandom(matcher, CryptPattern46, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern47, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern48, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern49, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern50, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern51, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern52, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern53, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern54, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern55, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern56, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern57, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern58, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern59, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern60, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern61, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern62, rndper);
 }
 
-void CryptPatternGroup3(int rndper)
+void L1Generator::CryptPatternGroup3(int rndper)
 {
-	PlaceMiniSetRandom(CryptPattern63, rndper);
-	PlaceMiniSetRandom(CryptPattern64, rndper);
-	PlaceMiniSetRandom(CryptPattern65, rndper);
-	PlaceMiniSetRandom(CryptPattern66, rndper);
-	PlaceMiniSetRandom(CryptPattern67, rndper);
-	PlaceMiniSetRandom(CryptPattern68, rndper);
-	PlaceMiniSetRandom(CryptPattern69, rndper);
-	PlaceMiniSetRandom(CryptPattern70, rndper);
-	PlaceMiniSetRandom(CryptPattern71, rndper);
-	PlaceMiniSetRandom(CryptPattern72, rndper);
-	PlaceMiniSetRandom(CryptPattern73, rndper);
-	PlaceMiniSetRandom(CryptPattern74, rndper);
-	PlaceMiniSetRandom(CryptPattern75, rndper);
-	PlaceMiniSetRandom(CryptPattern76, rndper);
-	PlaceMiniSetRandom(CryptPattern77, rndper);
-	PlaceMiniSetRandom(CryptPattern78, rndper);
-	PlaceMiniSetRandom(CryptPattern79, rndper);
+	MinisetMatcher matcher(dungeon, dflags);
+
+	PlaceMiniSetRandom(matcher, CryptPattern63, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern64, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern65, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern66, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern67, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern68, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern69, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern70, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern71, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern72, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern73, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern74, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern75, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern76, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern77, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern78, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern79, rndper);
 }
 
-void CryptPatternGroup4(int rndper)
+void L1Generator::CryptPatternGroup4(int rndper)
 {
-	PlaceMiniSetRandom(CryptPattern80, rndper);
-	PlaceMiniSetRandom(CryptPattern81, rndper);
-	PlaceMiniSetRandom(CryptPattern82, rndper);
-	PlaceMiniSetRandom(CryptPattern83, rndper);
-	PlaceMiniSetRandom(CryptPattern84, rndper);
-	PlaceMiniSetRandom(CryptPattern85, rndper);
-	PlaceMiniSetRandom(CryptPattern86, rndper);
-	PlaceMiniSetRandom(CryptPattern87, rndper);
-	PlaceMiniSetRandom(CryptPattern88, rndper);
-	PlaceMiniSetRandom(CryptPattern89, rndper);
-	PlaceMiniSetRandom(CryptPattern90, rndper);
-	PlaceMiniSetRandom(CryptPattern91, rndper);
-	PlaceMiniSetRandom(CryptPattern92, rndper);
-	PlaceMiniSetRandom(CryptPattern93, rndper);
-	PlaceMiniSetRandom(CryptPattern94, rndper);
-	PlaceMiniSetRandom(CryptPattern95, rndper);
-	PlaceMiniSetRandom(CryptPattern96, rndper);
+	MinisetMatcher matcher(dungeon, dflags);
+
+	PlaceMiniSetRandom(matcher, CryptPattern80, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern81, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern82, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern83, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern84, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern85, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern86, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern87, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern88, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern89, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern90, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern91, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern92, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern93, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern94, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern95, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern96, rndper);
 }
 
-void CryptPatternGroup5(int rndper)
+void L1Generator::CryptPatternGroup5(int rndper)
 {
-	PlaceMiniSetRandom(CryptPattern36, rndper);
-	PlaceMiniSetRandom(CryptPattern37, rndper);
-	PlaceMiniSetRandom(CryptPattern38, rndper);
-	PlaceMiniSetRandom(CryptPattern39, rndper);
-	PlaceMiniSetRandom(CryptPattern40, rndper);
-	PlaceMiniSetRandom(CryptPattern41, rndper);
-	PlaceMiniSetRandom(CryptPattern42, rndper);
-	PlaceMiniSetRandom(CryptPattern43, rndper);
-	PlaceMiniSetRandom(CryptPattern44, rndper);
-	PlaceMiniSetRandom(CryptPattern45, rndper);
+	MinisetMatcher matcher(dungeon, dflags);
+
+	PlaceMiniSetRandom(matcher, CryptPattern36, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern37, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern38, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern39, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern40, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern41, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern42, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern43, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern44, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern45, rndper);
 }
 
-void CryptPatternGroup6(int rndper)
+void L1Generator::CryptPatternGroup6(int rndper)
 {
-	PlaceMiniSetRandom(CryptPattern10, rndper);
-	PlaceMiniSetRandom(CryptPattern12, rndper);
-	PlaceMiniSetRandom(CryptPattern11, rndper);
-	PlaceMiniSetRandom(CryptPattern13, rndper);
-	PlaceMiniSetRandom(CryptPattern14, rndper);
-	PlaceMiniSetRandom(CryptPattern15, rndper);
-	PlaceMiniSetRandom(CryptPattern16, rndper);
-	PlaceMiniSetRandom(CryptPattern17, rndper);
-	PlaceMiniSetRandom(CryptPattern18, rndper);
-	PlaceMiniSetRandom(CryptPattern19, rndper);
-	PlaceMiniSetRandom(CryptPattern20, rndper);
-	PlaceMiniSetRandom(CryptPattern21, rndper);
-	PlaceMiniSetRandom(CryptPattern22, rndper);
-	PlaceMiniSetRandom(CryptPattern23, rndper);
-	PlaceMiniSetRandom(CryptPattern24, rndper);
-	PlaceMiniSetRandom(CryptPattern25, rndper);
-	PlaceMiniSetRandom(CryptPattern26, rndper);
-	PlaceMiniSetRandom(CryptPattern27, rndper);
-	PlaceMiniSetRandom(CryptPattern28, rndper);
-	PlaceMiniSetRandom(CryptPattern29, rndper);
-	PlaceMiniSetRandom(CryptPattern30, rndper);
-	PlaceMiniSetRandom(CryptPattern31, rndper);
-	PlaceMiniSetRandom(CryptPattern32, rndper);
-	PlaceMiniSetRandom(CryptPattern33, rndper);
-	PlaceMiniSetRandom(CryptPattern34, rndper);
-	PlaceMiniSetRandom(CryptPattern35, rndper);
+	MinisetMatcher matcher(dungeon, dflags);
+
+	PlaceMiniSetRandom(matcher, CryptPattern10, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern12, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern11, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern13, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern14, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern15, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern16, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern17, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern18, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern19, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern20, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern21, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern22, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern23, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern24, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern25, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern26, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern27, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern28, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern29, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern30, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern31, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern32, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern33, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern34, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern35, rndper);
 }
 
-void CryptPatternGroup7(int rndper)
+void L1Generator::CryptPatternGroup7(int rndper)
 {
-	PlaceMiniSetRandom(CryptPattern5, rndper);
-	PlaceMiniSetRandom(CryptPattern6, rndper);
-	PlaceMiniSetRandom(CryptPattern7, rndper);
-	PlaceMiniSetRandom(CryptPattern8, rndper);
+	MinisetMatcher matcher(dungeon, dflags);
+
+	PlaceMiniSetRandom(matcher, CryptPattern5, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern6, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern7, rndper);
+	PlaceMiniSetRandom(matcher, CryptPattern8, rndper);
 }
 
-void GenerateLevel(lvl_entry entry)
+void L1Generator::GenerateLevel(lvl_entry entry)
 {
 	int minarea = 761;
 	switch (currlevel) {
@@ -2187,6 +2240,7 @@ void GenerateLevel(lvl_entry entry)
 		DRLG_InitTrans();
 
 		do {
+			layoutAttempts++;
 			InitDungeonFlags();
 			FirstRoom();
 		} while (FindArea() < minarea);
@@ -2201,7 +2255,7 @@ void GenerateLevel(lvl_entry entry)
 
 		doneflag = true;
 
-		if (Quests[Q_PWATER].IsAvailable()) {
+		if (IsQuestAvailable(Q_PWATER)) {
 			if (entry == ENTRY_MAIN) {
 				if (PlaceMiniSet(PWATERIN, 1, 1, 0, 0, true, -1) < 0)
 					doneflag = false;
@@ -2211,7 +2265,7 @@ void GenerateLevel(lvl_entry entry)
 				ViewPosition.y--;
 			}
 		}
-		if (Quests[Q_LTBANNER].IsAvailable()) {
+		if (IsQuestAvailable(Q_LTBANNER)) {
 			if (entry == ENTRY_MAIN) {
 				if (PlaceMiniSet(STAIRSUP, 1, 1, 0, 0, true, -1) < 0)
 					doneflag = false;
@@ -2315,11 +2369,14 @@ void GenerateLevel(lvl_entry entry)
 		Substitution();
 	} else {
 		CryptPatternGroup1(10);
-		PlaceMiniSetRandom(CryptPattern1, 95);
-		PlaceMiniSetRandom(CryptPattern2, 95);
-		PlaceMiniSetRandom(CryptPattern3, 100);
-		PlaceMiniSetRandom(CryptPattern4, 100);
-		PlaceMiniSetRandom(CryptPattern9, 60);
+		{
+			MinisetMatcher matcher(dungeon, dflags);
+			PlaceMiniSetRandom(matcher, CryptPattern1, 95);
+			PlaceMiniSetRandom(matcher, CryptPattern2, 95);
+			PlaceMiniSetRandom(matcher, CryptPattern3, 100);
+			PlaceMiniSetRandom(matcher, CryptPattern4, 100);
+			PlaceMiniSetRandom(matcher, CryptPattern9, 60);
+		}
 		CryptLavafloor();
 		switch (currlevel) {
 		case 21:
@@ -2377,14 +2434,14 @@ void GenerateLevel(lvl_entry entry)
 	DRLG_CheckQuests(setpc_x, setpc_y);
 }
 
-void Pass3()
+void L1Generator::Pass3()
 {
 	DRLG_LPass3(22 - 1);
 }
 
 } // namespace
 
-void LoadL1Dungeon(const char *path, int vx, int vy)
+void L1Generator::LoadDungeon(const char *path, int vx, int vy)
 {
 	dminPosition = { 16, 16 };
 	dmaxPosition = { 96, 96 };
@@ -2432,7 +2489,7 @@ void LoadL1Dungeon(const char *path, int vx, int vy)
 	SetMapObjects(dunData.get(), 0, 0);
 }
 
-void LoadPreL1Dungeon(const char *path)
+void L1Generator::LoadPreDungeon(const char *path)
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -2473,7 +2530,7 @@ void LoadPreL1Dungeon(const char *path)
 	}
 }
 
-void CreateL5Dungeon(uint32_t rseed, lvl_entry entry)
+void L1Generator::Generate(uint32_t rseed, lvl_entry entry)
 {
 	SetRndSeed(rseed);
 
@@ -2482,9 +2539,6 @@ void CreateL5Dungeon(uint32_t rseed, lvl_entry entry)
 
 	UberRow = 0;
 	UberCol = 0;
-	IsUberRoomOpened = false;
-	IsUberLeverActivated = false;
-	UberDiabloMonsterIndex = 0;
 
 	DRLG_InitTrans();
 	DRLG_InitSetPC();
@@ -2500,6 +2554,31 @@ void CreateL5Dungeon(uint32_t rseed, lvl_entry entry)
 	}
 
 	DRLG_SetPC();
+}
+
+void LoadL1Dungeon(const char *path, int vx, int vy)
+{
+	L1Generator(LevelGenerationContext {}).LoadDungeon(path, vx, vy);
+}
+
+void LoadPreL1Dungeon(const char *path)
+{
+	L1Generator(LevelGenerationContext {}).LoadPreDungeon(path);
+}
+
+void GenerateL5Dungeon(const LevelGenerationContext &context, uint32_t rseed, lvl_entry entry)
+{
+	L1Generator(context).Generate(rseed, entry);
+}
+
+void CreateL5Dungeon(uint32_t rseed, lvl_entry entry)
+{
+	IsUberRoomOpened = false;
+	IsUberLeverActivated = false;
+	UberDiabloMonsterIndex = 0;
+
+	if (!CommitPregeneratedLevel(rseed, entry))
+		GenerateL5Dungeon(LevelGenerationContext {}, rseed, entry);
 
 	for (int j = dminPosition.y; j < dmaxPosition.y; j++) {
 		for (int i = dminPosition.x; i < dmaxPosition.x; i++) {
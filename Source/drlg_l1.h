@@ -17,6 +17,9 @@ extern int UberDiabloMonsterIndex;
 
 void LoadL1Dungeon(const char *path, int vx, int vy);
 void LoadPreL1Dungeon(const char *path);
+/** @brief Lays out a cathedral or crypt level using the state of the given context. */
+void GenerateL5Dungeon(const LevelGenerationContext &context, uint32_t rseed, lvl_entry entry);
+/** @brief Generates the current cathedral or crypt level, or takes it from the background pregeneration when available. */
 void CreateL5Dungeon(uint32_t rseed, lvl_entry entry);
 
 } // namespace devilution
@@ -9,9 +9,11 @@
 #include <list>
 
 #include "diablo.h"
+#include "drlg_pattern.h"
 #include "engine/load_file.hpp"
 #include "engine/random.hpp"
 #include "gendung.h"
+#include "levelpregen.h"
 #include "player.h"
 #include "quests.h"
 #include "setmaps.h"
@@ -19,18 +21,8 @@
 
 namespace devilution {
 
-BYTE predungeon[DMAXX][DMAXY];
-
 namespace {
 
-int nSx1;
-int nSy1;
-int nSx2;
-int nSy2;
-int nRoomCnt;
-ROOMNODE RoomList[81];
-std::list<HALLNODE> HallList;
-
 int Area_Min = 2;
 int Room_Max = 10;
 int Room_Min = 4;
@@ -48,7 +40,7 @@ struct Miniset {
 	unsigned char search[4][5];
 	unsigned char replace[4][5];
 
-	bool matches(Point position) const
+	bool matches(const uint8_t (&dungeon)[DMAXX][DMAXY], const uint8_t (&dflags)[DMAXX][DMAXY], Point position) const
 	{
 		for (int yy = 0; yy < size.height; yy++) {
 			for (int xx = 0; xx < size.width; xx++) {
@@ -61,7 +53,7 @@ struct Miniset {
 		return true;
 	}
 
-	void place(Point position) const
+	void place(uint8_t (&dungeon)[DMAXX][DMAXY], Point position) const
 	{
 		for (int y = 0; y < size.height; y++) {
 			for (int x = 0; x < size.width; x++) {
@@ -70,6 +62,21 @@ struct Miniset {
 			}
 		}
 	}
+
+	MinisetSearch pattern() const
+	{
+		return { size, 5, &search[0][0] };
+	}
+
+	void place(MinisetMatcher &matcher, Point position) const
+	{
+		for (int y = 0; y < size.height; y++) {
+			for (int x = 0; x < size.width; x++) {
+				if (replace[y][x] != 0)
+					matcher.SetTile({ x + position.x, y + position.y }, replace[y][x]);
+			}
+		}
+	}
 };
 
 /** Miniset: Arch vertical. */
@@ -1640,7 +1647,63 @@ int Patterns[100][10] = {
 	{ 0, 0, 0, 0, 255, 0, 0, 0, 0, 0 },
 };
 
-void ApplyShadowsPatterns()
+class L2Generator : public LevelGenerationContext {
+public:
+	explicit L2Generator(const LevelGenerationContext &context)
+	    : LevelGenerationContext(context)
+	{
+	}
+
+	void LoadDungeon(const char *path, int vx, int vy);
+	void LoadPreDungeon(const char *path);
+	void Generate(uint32_t rseed, lvl_entry entry);
+
+private:
+	BYTE predungeon[DMAXX][DMAXY] = {};
+	/** Specifies whether a single player quest DUN has been loaded. */
+	bool setloadflag = false;
+	/** Contains the contents of the single player quest DUN file. */
+	std::unique_ptr<uint16_t[]> pSetPiece;
+	int nSx1 = 0;
+	int nSy1 = 0;
+	int nSx2 = 0;
+	int nSy2 = 0;
+	int nRoomCnt = 0;
+	ROOMNODE RoomList[81] = {};
+	std::list<HALLNODE> HallList;
+
+	void ApplyShadowsPatterns();
+	bool PlaceMiniSet(const Miniset &miniset, int tmin, int tmax, int cx, int cy, bool setview);
+	void PlaceMiniSetRandom(MinisetMatcher &matcher, const Miniset &miniset, int rndper);
+	void LoadQuestSetPieces();
+	void FreeQuestSetPieces();
+	void InitDungeonPieces();
+	void InitDungeonFlags();
+	void MapRoom(int x1, int y1, int x2, int y2);
+	void DefineRoom(int nX1, int nY1, int nX2, int nY2, bool forceHW);
+	void CreateDoorType(int nX, int nY);
+	void PlaceHallExt(int nX, int nY);
+	void CreateRoom(int nX1, int nY1, int nX2, int nY2, int nRDest, int nHDir, bool forceHW, int nH, int nW);
+	void ConnectHall(const HALLNODE &node);
+	void ApplyPatterns();
+	void FixTilesPatterns();
+	void Substitution();
+	void SetRoom(int rx1, int ry1);
+	int CountEmptyTiles();
+	void KnockWalls(int x1, int y1, int x2, int y2);
+	void FillVoid(bool xf1, bool yf1, bool xf2, bool yf2, int xx, int yy);
+	bool FillVoids();
+	bool CreateDungeon();
+	void FixTransparency();
+	void FixDirtTiles();
+	void FixLockout();
+	void FixDoors();
+	void GenerateLevel(lvl_entry entry);
+	void LoadDungeonData(const uint16_t *dunData);
+	void Pass3();
+};
+
+void L2Generator::ApplyShadowsPatterns()
 {
 	uint8_t sd[2][2];
 
@@ -1675,7 +1738,7 @@ void ApplyShadowsPatterns()
 	}
 }
 
-bool PlaceMiniSet(const Miniset &miniset, int tmin, int tmax, int cx, int cy, bool setview)
+bool L2Generator::PlaceMiniSet(const Miniset &miniset, int tmin, int tmax, int cx, int cy, bool setview)
 {
 	int sw = miniset.size.width;
 	int sh = miniset.size.height;
@@ -1710,7 +1773,7 @@ bool PlaceMiniSet(const Miniset &miniset, int tmin, int tmax, int cx, int cy, bo
 			}
 
 			if (abort)
-				abort = miniset.matches({ sx, sy });
+				abort = miniset.matches(dungeon, dflags, { sx, sy });
 
 			if (!abort) {
 				sx++;
@@ -1727,7 +1790,7 @@ bool PlaceMiniSet(const Miniset &miniset, int tmin, int tmax, int cx, int cy, bo
 			return false;
 		}
 
-		miniset.place({ sx, sy });
+		miniset.place(dungeon, { sx, sy });
 	}
 
 	if (setview) {
@@ -1737,16 +1800,17 @@ bool PlaceMiniSet(const Miniset &miniset, int tmin, int tmax, int cx, int cy, bo
 	return true;
 }
 
-void PlaceMiniSetRandom(const Miniset &miniset, int rndper)
+void L2Generator::PlaceMiniSetRandom(MinisetMatcher &matcher, const Miniset &miniset, int rndper)
 {
 	int sw = miniset.size.width;
 	int sh = miniset.size.height;
+	MinisetSearch search = miniset.pattern();
 
 	for (int sy = 0; sy < DMAXY - sh; sy++) {
 		for (int sx = 0; sx < DMAXX - sw; sx++) {
 			if (sx >= nSx1 && sx <= nSx2 && sy >= nSy1 && sy <= nSy2)
 				continue;
-			if (!miniset.matches({ sx, sy }))
+			if (!matcher.Matches(search, { sx, sy }))
 				continue;
 			bool found = true;
 			for (int yy = std::max(sy - sh, 0); yy < std::min(sy + 2 * sh, DMAXY) && found; yy++) {
@@ -1759,35 +1823,35 @@ void PlaceMiniSetRandom(const Miniset &miniset, int rndper)
 				}
 			}
 			if (found && GenerateRnd(100) < rndper)
-				miniset.place({ sx, sy });
+				miniset.place(matcher, { sx, sy });
 		}
 	}
 }
 
-void LoadQuestSetPieces()
+void L2Generator::LoadQuestSetPieces()
 {
 	setloadflag = false;
 
-	if (Quests[Q_BLIND].IsAvailable()) {
+	if (IsQuestAvailable(Q_BLIND)) {
 		pSetPiece = LoadFileInMem<uint16_t>("Levels\\L2Data\\Blind1.DUN");
 		pSetPiece[13] = SDL_SwapLE16(154);  // Close outer wall
 		pSetPiece[100] = SDL_SwapLE16(154); // Close outer wall
 		setloadflag = true;
-	} else if (Quests[Q_BLOOD].IsAvailable()) {
+	} else if (IsQuestAvailable(Q_BLOOD)) {
 		pSetPiece = LoadFileInMem<uint16_t>("Levels\\L2Data\\Blood1.DUN");
 		setloadflag = true;
-	} else if (Quests[Q_SCHAMB].IsAvailable()) {
+	} else if (IsQuestAvailable(Q_SCHAMB)) {
 		pSetPiece = LoadFileInMem<uint16_t>("Levels\\L2Data\\Bonestr2.DUN");
 		setloadflag = true;
 	}
 }
 
-void FreeQuestSetPieces()
+void L2Generator::FreeQuestSetPieces()
 {
 	pSetPiece = nullptr;
 }
 
-void InitDungeonPieces()
+void L2Generator::InitDungeonPieces()
 {
 	for (int j = 0; j < MAXDUNY; j++) {
 		for (int i = 0; i < MAXDUNX; i++) {
@@ -1815,7 +1879,7 @@ void InitDungeonPieces()
 	}
 }
 
-void InitDungeonFlags()
+void L2Generator::InitDungeonFlags()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -1825,7 +1889,7 @@ void InitDungeonFlags()
 	}
 }
 
-void MapRoom(int x1, int y1, int x2, int y2)
+void L2Generator::MapRoom(int x1, int y1, int x2, int y2)
 {
 	for (int jj = y1; jj <= y2; jj++) {
 		for (int ii = x1; ii <= x2; ii++) {
@@ -1842,7 +1906,7 @@ void MapRoom(int x1, int y1, int x2, int y2)
 	}
 }
 
-void DefineRoom(int nX1, int nY1, int nX2, int nY2, bool forceHW)
+void L2Generator::DefineRoom(int nX1, int nY1, int nX2, int nY2, bool forceHW)
 {
 	predungeon[nX1][nY1] = 67;
 	predungeon[nX1][nY2] = 69;
@@ -1878,7 +1942,7 @@ void DefineRoom(int nX1, int nY1, int nX2, int nY2, bool forceHW)
 	}
 }
 
-void CreateDoorType(int nX, int nY)
+void L2Generator::CreateDoorType(int nX, int nY)
 {
 	if (predungeon[nX - 1][nY] == 68) {
 		return;
@@ -1899,7 +1963,7 @@ void CreateDoorType(int nX, int nY)
 	predungeon[nX][nY] = 68;
 }
 
-void PlaceHallExt(int nX, int nY)
+void L2Generator::PlaceHallExt(int nX, int nY)
 {
 	if (predungeon[nX][nY] == 32) {
 		predungeon[nX][nY] = 44;
@@ -1918,7 +1982,7 @@ void PlaceHallExt(int nX, int nY)
  * @param nH Height of the room, if forceHW is set.
  * @param nW Width of the room, if forceHW is set.
  */
-void CreateRoom(int nX1, int nY1, int nX2, int nY2, int nRDest, int nHDir, bool forceHW, int nH, int nW)
+void L2Generator::CreateRoom(int nX1, int nY1, int nX2, int nY2, int nRDest, int nHDir, bool forceHW, int nH, int nW)
 {
 	if (nRoomCnt >= 80) {
 		return;
@@ -2045,7 +2109,7 @@ void CreateRoom(int nX1, int nY1, int nX2, int nY2, int nRDest, int nHDir, bool
 	}
 }
 
-void ConnectHall(const HALLNODE &node)
+void L2Generator::ConnectHall(const HALLNODE &node)
 {
 	int nRp;
 
@@ -2199,76 +2263,60 @@ void ConnectHall(const HALLNODE &node)
 	}
 }
 
-void DoPatternCheck(int i, int j)
+void L2Generator::ApplyPatterns()
 {
-	for (int k = 0; Patterns[k][4] != 255; k++) {
-		int x = i - 1;
-		int y = j - 1;
-		int nOk = 254;
-		for (int l = 0; l < 9 && nOk == 254; l++) {
-			nOk = 255;
-			if (l == 3 || l == 6) {
-				y++;
-				x = i - 1;
-			}
-			if (x >= 0 && x < DMAXX && y >= 0 && y < DMAXY) {
-				switch (Patterns[k][l]) {
-				case 0:
-					nOk = 254;
-					break;
-				case 1:
-					if (predungeon[x][y] == 35) {
-						nOk = 254;
-					}
-					break;
-				case 2:
-					if (predungeon[x][y] == 46) {
-						nOk = 254;
-					}
-					break;
-				case 4:
-					if (predungeon[x][y] == 32) {
-						nOk = 254;
-					}
-					break;
-				case 3:
-					if (predungeon[x][y] == 68) {
-						nOk = 254;
-					}
-					break;
-				case 5:
-					if (predungeon[x][y] == 68 || predungeon[x][y] == 46) {
-						nOk = 254;
-					}
-					break;
-				case 6:
-					if (predungeon[x][y] == 68 || predungeon[x][y] == 35) {
-						nOk = 254;
-					}
-					break;
-				case 7:
-					if (predungeon[x][y] == 32 || predungeon[x][y] == 46) {
-						nOk = 254;
-					}
-					break;
-				case 8:
-					if (predungeon[x][y] == 68 || predungeon[x][y] == 35 || predungeon[x][y] == 46) {
-						nOk = 254;
-					}
-					break;
-				}
-			} else {
-				nOk = 254;
+	// Bit x of each row is set when predungeon[x][y] is one of the tiles a Patterns entry can ask for
+	DungeonRowMask tileClassRows[9][DMAXY] = {};
+	for (int y = 0; y < DMAXY; y++) {
+		for (int x = 0; x < DMAXX; x++) {
+			DungeonRowMask column = DungeonRowMask { 1 } << x;
+			switch (predungeon[x][y]) {
+			case 35:
+				tileClassRows[1][y] |= column;
+				tileClassRows[6][y] |= column;
+				tileClassRows[8][y] |= column;
+				break;
+			case 46:
+				tileClassRows[2][y] |= column;
+				tileClassRows[5][y] |= column;
+				tileClassRows[7][y] |= column;
+				tileClassRows[8][y] |= column;
+				break;
+			case 68:
+				tileClassRows[3][y] |= column;
+				tileClassRows[5][y] |= column;
+				tileClassRows[6][y] |= column;
+				tileClassRows[8][y] |= column;
+				break;
+			case 32:
+				tileClassRows[4][y] |= column;
+				tileClassRows[7][y] |= column;
+				break;
 			}
-			x++;
 		}
-		if (nOk == 254) {
-			dungeon[i][j] = Patterns[k][9];
+	}
+
+	for (int j = 0; j < DMAXY; j++) {
+		for (int k = 0; Patterns[k][4] != 255; k++) {
+			DungeonRowMask matches = AllDungeonColumns;
+			for (int l = 0; l < 9 && matches != 0; l++) {
+				int tileClass = Patterns[k][l];
+				int y = j - 1 + l / 3;
+				// Any tile matches class 0 and the tiles outside the map match every class
+				if (tileClass == 0 || y < 0 || y >= DMAXY)
+					continue;
+				matches &= OffsetRowMask(tileClassRows[tileClass][y], l % 3 - 1, true);
+			}
+			// Later patterns take precedence, same as when checking them one tile at a time
+			for (int i = 0; i < DMAXX; i++) {
+				if ((matches & (DungeonRowMask { 1 } << i)) != 0)
+					dungeon[i][j] = Patterns[k][9];
+			}
 		}
 	}
 }
 
-void FixTilesPatterns()
+void L2Generator::FixTilesPatterns()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -2291,7 +2339,7 @@ void FixTilesPatterns()
 	}
 }
 
-void Substitution()
+void L2Generator::Substitution()
 {
 	for (int y = 0; y < DMAXY; y++) {
 		for (int x = 0; x < DMAXX; x++) {
@@ -2328,7 +2376,7 @@ void Substitution()
 	}
 }
 
-void SetRoom(int rx1, int ry1)
+void L2Generator::SetRoom(int rx1, int ry1)
 {
 	int width = SDL_SwapLE16(pSetPiece[0]);
 	int height = SDL_SwapLE16(pSetPiece[1]);
@@ -2353,7 +2401,7 @@ void SetRoom(int rx1, int ry1)
 	}
 }
 
-int CountEmptyTiles()
+int L2Generator::CountEmptyTiles()
 {
 	int t = 0;
 	for (int jj = 0; jj < DMAXY; jj++) {
@@ -2367,7 +2415,7 @@ int CountEmptyTiles()
 	return t;
 }
 
-void KnockWalls(int x1, int y1, int x2, int y2)
+void L2Generator::KnockWalls(int x1, int y1, int x2, int y2)
 {
 	for (int ii = x1 + 1; ii < x2; ii++) {
 		if (predungeon[ii][y1 - 1] == 46 && predungeon[ii][y1 + 1] == 46) {
@@ -2399,7 +2447,7 @@ void KnockWalls(int x1, int y1, int x2, int y2)
 	}
 }
 
-void FillVoid(bool xf1, bool yf1, bool xf2, bool yf2, int xx, int yy)
+void L2Generator::FillVoid(bool xf1, bool yf1, bool xf2, bool yf2, int xx, int yy)
 {
 	int x1 = xx;
 	if (xf1) {
@@ -2620,7 +2668,7 @@ void FillVoid(bool xf1, bool yf1, bool xf2, bool yf2, int xx, int yy)
 	}
 }
 
-bool FillVoids()
+bool L2Generator::FillVoids()
 {
 	int to = 0;
 	while (CountEmptyTiles() > 700 && to < 100) {
@@ -2679,7 +2727,7 @@ bool FillVoids()
 	return CountEmptyTiles() <= 700;
 }
 
-bool CreateDungeon()
+bool L2Generator::CreateDungeon()
 {
 	int forceW = 0;
 	int forceH = 0;
@@ -2687,21 +2735,21 @@ bool CreateDungeon()
 
 	switch (currlevel) {
 	case 5:
-		if (Quests[Q_BLOOD]._qactive != QUEST_NOTAVAIL) {
+		if (GetQuestState(Q_BLOOD) != QUEST_NOTAVAIL) {
 			forceHW = true;
 			forceH = 20;
 			forceW = 14;
 		}
 		break;
 	case 6:
-		if (Quests[Q_SCHAMB]._qactive != QUEST_NOTAVAIL) {
+		if (GetQuestState(Q_SCHAMB) != QUEST_NOTAVAIL) {
 			forceHW = true;
 			forceW = 10;
 			forceH = 10;
 		}
 		break;
 	case 7:
-		if (Quests[Q_BLIND]._qactive != QUEST_NOTAVAIL) {
+		if (GetQuestState(Q_BLIND) != QUEST_NOTAVAIL) {
 			forceHW = true;
 			forceW = 15;
 			forceH = 15;
@@ -2746,16 +2794,12 @@ bool CreateDungeon()
 		return false;
 	}
 
-	for (int j = 0; j < DMAXY; j++) {
-		for (int i = 0; i < DMAXX; i++) {
-			DoPatternCheck(i, j);
-		}
-	}
+	ApplyPatterns();
 
 	return true;
 }
 
-void FixTransparency()
+void L2Generator::FixTransparency()
 {
 	int yy = 16;
 	for (int j = 0; j < DMAXY; j++) {
@@ -2790,7 +2834,7 @@ void FixTransparency()
 	}
 }
 
-void FixDirtTiles()
+void L2Generator::FixDirtTiles()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -2816,7 +2860,7 @@ void FixDirtTiles()
 	}
 }
 
-void FixLockout()
+void L2Generator::FixLockout()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -2880,7 +2924,7 @@ void FixLockout()
 	}
 }
 
-void FixDoors()
+void L2Generator::FixDoors()
 {
 	for (int j = 1; j < DMAXY; j++) {
 		for (int i = 1; i < DMAXX; i++) {
@@ -2894,10 +2938,11 @@ void FixDoors()
 	}
 }
 
-void GenerateLevel(lvl_entry entry)
+void L2Generator::GenerateLevel(lvl_entry entry)
 {
 	bool doneflag = false;
 	while (!doneflag) {
+		layoutAttempts++;
 		nRoomCnt = 0;
 		InitDungeonFlags();
 		DRLG_InitTrans();
@@ -2945,114 +2990,115 @@ void GenerateLevel(lvl_entry entry)
 	FixDirtTiles();
 
 	DRLG_PlaceThemeRooms(6, 10, 3, 0, false);
-	PlaceMiniSetRandom(CTRDOOR1, 100);
-	PlaceMiniSetRandom(CTRDOOR2, 100);
-	PlaceMiniSetRandom(CTRDOOR3, 100);
-	PlaceMiniSetRandom(CTRDOOR4, 100);
-	PlaceMiniSetRandom(CTRDOOR5, 100);
-	PlaceMiniSetRandom(CTRDOOR6, 100);
-	PlaceMiniSetRandom(CTRDOOR7, 100);
-	PlaceMiniSetRandom(CTRDOOR8, 100);
-	PlaceMiniSetRandom(VARCH33, 100);
-	PlaceMiniSetRandom(VARCH34, 100);
-	PlaceMiniSetRandom(VARCH35, 100);
-	PlaceMiniSetRandom(VARCH36, 100);
-	PlaceMiniSetRandom(VARCH37, 100);
-	PlaceMiniSetRandom(VARCH38, 100);
-	PlaceMiniSetRandom(VARCH39, 100);
-	PlaceMiniSetRandom(VARCH40, 100);
-	PlaceMiniSetRandom(VARCH1, 100);
-	PlaceMiniSetRandom(VARCH2, 100);
-	PlaceMiniSetRandom(VARCH3, 100);
-	PlaceMiniSetRandom(VARCH4, 100);
-	PlaceMiniSetRandom(VARCH5, 100);
-	PlaceMiniSetRandom(VARCH6, 100);
-	PlaceMiniSetRandom(VARCH7, 100);
-	PlaceMiniSetRandom(VARCH8, 100);
-	PlaceMiniSetRandom(VARCH9, 100);
-	PlaceMiniSetRandom(VARCH10, 100);
-	PlaceMiniSetRandom(VARCH11, 100);
-	PlaceMiniSetRandom(VARCH12, 100);
-	PlaceMiniSetRandom(VARCH13, 100);
-	PlaceMiniSetRandom(VARCH14, 100);
-	PlaceMiniSetRandom(VARCH15, 100);
-	PlaceMiniSetRandom(VARCH16, 100);
-	PlaceMiniSetRandom(VARCH17, 100);
-	PlaceMiniSetRandom(VARCH18, 100);
-	PlaceMiniSetRandom(VARCH19, 100);
-	PlaceMiniSetRandom(VARCH20, 100);
-	PlaceMiniSetRandom(VARCH21, 100);
-	PlaceMiniSetRandom(VARCH22, 100);
-	PlaceMiniSetRandom(VARCH23, 100);
-	PlaceMiniSetRandom(VARCH24, 100);
-	PlaceMiniSetRandom(VARCH25, 100);
-	PlaceMiniSetRandom(VARCH26, 100);
-	PlaceMiniSetRandom(VARCH27, 100);
-	PlaceMiniSetRandom(VARCH28, 100);
-	PlaceMiniSetRandom(VARCH29, 100);
-	PlaceMiniSetRandom(VARCH30, 100);
-	PlaceMiniSetRandom(VARCH31, 100);
-	PlaceMiniSetRandom(VARCH32, 100);
-	PlaceMiniSetRandom(HARCH1, 100);
-	PlaceMiniSetRandom(HARCH2, 100);
-	PlaceMiniSetRandom(HARCH3, 100);
-	PlaceMiniSetRandom(HARCH4, 100);
-	PlaceMiniSetRandom(HARCH5, 100);
-	PlaceMiniSetRandom(HARCH6, 100);
-	PlaceMiniSetRandom(HARCH7, 100);
-	PlaceMiniSetRandom(HARCH8, 100);
-	PlaceMiniSetRandom(HARCH9, 100);
-	PlaceMiniSetRandom(HARCH10, 100);
-	PlaceMiniSetRandom(HARCH11, 100);
-	PlaceMiniSetRandom(HARCH12, 100);
-	PlaceMiniSetRandom(HARCH13, 100);
-	PlaceMiniSetRandom(HARCH14, 100);
-	PlaceMiniSetRandom(HARCH15, 100);
-	PlaceMiniSetRandom(HARCH16, 100);
-	PlaceMiniSetRandom(HARCH17, 100);
-	PlaceMiniSetRandom(HARCH18, 100);
-	PlaceMiniSetRandom(HARCH19, 100);
-	PlaceMiniSetRandom(HARCH20, 100);
-	PlaceMiniSetRandom(HARCH21, 100);
-	PlaceMiniSetRandom(HARCH22, 100);
-	PlaceMiniSetRandom(HARCH23, 100);
-	PlaceMiniSetRandom(HARCH24, 100);
-	PlaceMiniSetRandom(HARCH25, 100);
-	PlaceMiniSetRandom(HARCH26, 100);
-	PlaceMiniSetRandom(HARCH27, 100);
-	PlaceMiniSetRandom(HARCH28, 100);
-	PlaceMiniSetRandom(HARCH29, 100);
-	PlaceMiniSetRandom(HARCH30, 100);
-	PlaceMiniSetRandom(HARCH31, 100);
-	PlaceMiniSetRandom(HARCH32, 100);
-	PlaceMiniSetRandom(HARCH33, 100);
-	PlaceMiniSetRandom(HARCH34, 100);
-	PlaceMiniSetRandom(HARCH35, 100);
-	PlaceMiniSetRandom(HARCH36, 100);
-	PlaceMiniSetRandom(HARCH37, 100);
-	PlaceMiniSetRandom(HARCH38, 100);
-	PlaceMiniSetRandom(HARCH39, 100);
-	PlaceMiniSetRandom(HARCH40, 100);
-	PlaceMiniSetRandom(CRUSHCOL, 99);
-	PlaceMiniSetRandom(RUINS1, 10);
-	PlaceMiniSetRandom(RUINS2, 10);
-	PlaceMiniSetRandom(RUINS3, 10);
-	PlaceMiniSetRandom(RUINS4, 10);
-	PlaceMiniSetRandom(RUINS5, 10);
-	PlaceMiniSetRandom(RUINS6, 10);
-	PlaceMiniSetRandom(RUINS7, 50);
-	PlaceMiniSetRandom(PANCREAS1, 1);
-	PlaceMiniSetRandom(PANCREAS2, 1);
-	PlaceMiniSetRandom(BIG1, 3);
-	PlaceMiniSetRandom(BIG2, 3);
-	PlaceMiniSetRandom(BIG3, 3);
-	PlaceMiniSetRandom(BIG4, 3);
-	PlaceMiniSetRandom(BIG5, 3);
-	PlaceMiniSetRandom(BIG6, 20);
-	PlaceMiniSetRandom(BIG7, 20);
-	PlaceMiniSetRandom(BIG8, 3);
-	PlaceMiniSetRandom(BIG9, 20);
-	PlaceMiniSetRandom(BIG10, 20);
+	MinisetMatcher matcher(dungeon, dflags);
+	PlaceMiniSetRandom(matcher, CTRDOOR1, 100);
+	PlaceMiniSetRandom(matcher, CTRDOOR2, 100);
+	PlaceMiniSetRandom(matcher, CTRDOOR3, 100);
+	PlaceMiniSetRandom(matcher, CTRDOOR4, 100);
+	PlaceMiniSetRandom(matcher, CTRDOOR5, 100);
+	PlaceMiniSetRandom(matcher, CTRDOOR6, 100);
+	PlaceMiniSetRandom(matcher, CTRDOOR7, 100);
+	PlaceMiniSetRandom(matcher, CTRDOOR8, 100);
+	PlaceMiniSetRandom(matcher, VARCH33, 100);
+	PlaceMiniSetRandom(matcher, VARCH34, 100);
+	PlaceMiniSetRandom(matcher, VARCH35, 100);
+	PlaceMiniSetRandom(matcher, VARCH36, 100);
+	PlaceMiniSetRandom(matcher, VARCH37, 100);
+	PlaceMiniSetRandom(matcher, VARCH38, 100);
+	PlaceMiniSetRandom(matcher, VARCH39, 100);
+	PlaceMiniSetRandom(matcher, VARCH40, 100);
+	PlaceMiniSetRandom(matcher, VARCH1, 100);
+	PlaceMiniSetRandom(matcher, VARCH2, 100);
+	PlaceMiniSetRandom(matcher, VARCH3, 100);
+	PlaceMiniSetRandom(matcher, VARCH4, 100);
+	PlaceMiniSetRandom(matcher, VARCH5, 100);
+	PlaceMiniSetRandom(matcher, VARCH6, 100);
+	PlaceMiniSetRandom(matcher, VARCH7, 100);
+	PlaceMiniSetRandom(matcher, VARCH8, 100);
+	PlaceMiniSetRandom(matcher, VARCH9, 100);
+	PlaceMiniSetRandom(matcher, VARCH10, 100);
+	PlaceMiniSetRandom(matcher, VARCH11, 100);
+	PlaceMiniSetRandom(matcher, VARCH12, 100);
+	PlaceMiniSetRandom(matcher, VARCH13, 100);
+	PlaceMiniSetRandom(matcher, VARCH14, 100);
+	PlaceMiniSetRandom(matcher, VARCH15, 100);
+	PlaceMiniSetRandom(matcher, VARCH16, 100);
+	PlaceMiniSetRandom(matcher, VARCH17, 100);
+	PlaceMiniSetRandom(matcher, VARCH18, 100);
+	PlaceMiniSetRandom(matcher, VARCH19, 100);
+	PlaceMiniSetRandom(matcher, VARCH20, 100);
+	PlaceMiniSetRandom(matcher, VARCH21, 100);
+	PlaceMiniSetRandom(matcher, VARCH22, 100);
+	PlaceMiniSetRandom(matcher, VARCH23, 100);
+	PlaceMiniSetRandom(matcher, VARCH24, 100);
+	PlaceMiniSetRandom(matcher, VARCH25, 100);
+	PlaceMiniSetRandom(matcher, VARCH26, 100);
+	PlaceMiniSetRandom(matcher, VARCH27, 100);
+	PlaceMiniSetRandom(matcher, VARCH28, 100);
+	PlaceMiniSetRandom(matcher, VARCH29, 100);
+	PlaceMiniSetRandom(matcher, VARCH30, 100);
+	PlaceMiniSetRandom(matcher, VARCH31, 100);
+	PlaceMiniSetRandom(matcher, VARCH32, 100);
+	PlaceMiniSetRandom(matcher, HARCH1, 100);
+	PlaceMiniSetRandom(matcher, HARCH2, 100);
+	PlaceMiniSetRandom(matcher, HARCH3, 100);
+	PlaceMiniSetRandom(matcher, HARCH4, 100);
+	PlaceMiniSetRandom(matcher, HARCH5, 100);
+	PlaceMiniSetRandom(matcher, HARCH6, 100);
+	PlaceMiniSetRandom(matcher, HARCH7, 100);
+	PlaceMiniSetRandom(matcher, HARCH8, 100);
+	PlaceMiniSetRandom(matcher, HARCH9, 100);
+	PlaceMiniSetRandom(matcher, HARCH10, 100);
+	PlaceMiniSetRandom(matcher, HARCH11, 100);
+	PlaceMiniSetRandom(matcher, HARCH12, 100);
+	PlaceMiniSetRandom(matcher, HARCH13, 100);
+	PlaceMiniSetRandom(matcher, HARCH14, 100);
+	PlaceMiniSetRandom(matcher, HARCH15, 100);
+	PlaceMiniSetRandom(matcher, HARCH16, 100);
+	PlaceMiniSetRandom(matcher, HARCH17, 100);
+	PlaceMiniSetRandom(matcher, HARCH18, 100);
+	PlaceMiniSetRandom(matcher, HARCH19, 100);
+	PlaceMiniSetRandom(matcher, HARCH20, 100);
+	PlaceMiniSetRandom(matcher, HARCH21, 100);
+	PlaceMiniSetRandom(matcher, HARCH22, 100);
+	PlaceMiniSetRandom(matcher, HARCH23, 100);
+	PlaceMiniSetRandom(matcher, HARCH24, 100);
+	PlaceMiniSetRandom(matcher, HARCH25, 100);
+	PlaceMiniSetRandom(matcher, HARCH26, 100);
+	PlaceMiniSetRandom(matcher, HARCH27, 100);
+	PlaceMiniSetRandom(matcher, HARCH28, 100);
+	PlaceMiniSetRandom(matcher, HARCH29, 100);
+	PlaceMiniSetRandom(matcher, HARCH30, 100);
+	PlaceMiniSetRandom(matcher, HARCH31, 100);
+	PlaceMiniSetRandom(matcher, HARCH32, 100);
+	PlaceMiniSetRandom(matcher, HARCH33, 100);
+	PlaceMiniSetRandom(matcher, HARCH34, 100);
+	PlaceMiniSetRandom(matcher, HARCH35, 100);
+	PlaceMiniSetRandom(matcher, HARCH36, 100);
+	PlaceMiniSetRandom(matcher, HARCH37, 100);
+	PlaceMiniSetRandom(matcher, HARCH38, 100);
+	PlaceMiniSetRandom(matcher, HARCH39, 100);
+	PlaceMiniSetRandom(matcher, HARCH40, 100);
+	PlaceMiniSetRandom(matcher, CRUSHCOL, 99);
+	PlaceMiniSetRandom(matcher, RUINS1, 10);
+	PlaceMiniSetRandom(matcher, RUINS2, 10);
+	PlaceMiniSetRandom(matcher, RUINS3, 10);
+	PlaceMiniSetRandom(matcher, RUINS4, 10);
+	PlaceMiniSetRandom(matcher, RUINS5, 10);
+	PlaceMiniSetRandom(matcher, RUINS6, 10);
+	PlaceMiniSetRandom(matcher, RUINS7, 50);
+	PlaceMiniSetRandom(matcher, PANCREAS1, 1);
+	PlaceMiniSetRandom(matcher, PANCREAS2, 1);
+	PlaceMiniSetRandom(matcher, BIG1, 3);
+	PlaceMiniSetRandom(matcher, BIG2, 3);
+	PlaceMiniSetRandom(matcher, BIG3, 3);
+	PlaceMiniSetRandom(matcher, BIG4, 3);
+	PlaceMiniSetRandom(matcher, BIG5, 3);
+	PlaceMiniSetRandom(matcher, BIG6, 20);
+	PlaceMiniSetRandom(matcher, BIG7, 20);
+	PlaceMiniSetRandom(matcher, BIG8, 3);
+	PlaceMiniSetRandom(matcher, BIG9, 20);
+	PlaceMiniSetRandom(matcher, BIG10, 20);
 	Substitution();
 	ApplyShadowsPatterns();
 
@@ -3066,7 +3112,7 @@ void GenerateLevel(lvl_entry entry)
 	DRLG_CheckQuests(nSx1, nSy1);
 }
 
-void LoadDungeonData(const uint16_t *dunData)
+void L2Generator::LoadDungeonData(const uint16_t *dunData)
 {
 	InitDungeonFlags();
 	DRLG_InitTrans();
@@ -3105,14 +3151,14 @@ void LoadDungeonData(const uint16_t *dunData)
 	}
 }
 
-void Pass3()
+void L2Generator::Pass3()
 {
 	DRLG_LPass3(12 - 1);
 }
 
 } // namespace
 
-void LoadL2Dungeon(const char *path, int vx, int vy)
+void L2Generator::LoadDungeon(const char *path, int vx, int vy)
 {
 	auto dunData = LoadFileInMem<uint16_t>(path);
 
@@ -3129,7 +3175,7 @@ void LoadL2Dungeon(const char *path, int vx, int vy)
 	SetMapObjects(dunData.get(), 0, 0);
 }
 
-void LoadPreL2Dungeon(const char *path)
+void L2Generator::LoadPreDungeon(const char *path)
 {
 	{
 		auto dunData = LoadFileInMem<uint16_t>(path);
@@ -3143,21 +3189,21 @@ void LoadPreL2Dungeon(const char *path)
 	}
 }
 
-void CreateL2Dungeon(uint32_t rseed, lvl_entry entry)
+void L2Generator::Generate(uint32_t rseed, lvl_entry entry)
 {
-	if (currlevel == 7 && Quests[Q_BLIND]._qactive == QUEST_NOTAVAIL) {
+	if (currlevel == 7 && GetQuestState(Q_BLIND) == QUEST_NOTAVAIL) {
 		currlevel = 6;
-		CreateL2Dungeon(glSeedTbl[6], ENTRY_LOAD);
+		Generate(glSeedTbl[6], ENTRY_LOAD);
 		currlevel = 7;
 	}
 	if (currlevel == 8) {
-		if (Quests[Q_BLIND]._qactive == QUEST_NOTAVAIL) {
+		if (GetQuestState(Q_BLIND) == QUEST_NOTAVAIL) {
 			currlevel = 6;
-			CreateL2Dungeon(glSeedTbl[6], ENTRY_LOAD);
+			Generate(glSeedTbl[6], ENTRY_LOAD);
 			currlevel = 8;
 		} else {
 			currlevel = 7;
-			CreateL2Dungeon(glSeedTbl[7], ENTRY_LOAD);
+			Generate(glSeedTbl[7], ENTRY_LOAD);
 			currlevel = 8;
 		}
 	}
@@ -3177,4 +3223,25 @@ void CreateL2Dungeon(uint32_t rseed, lvl_entry entry)
 	DRLG_SetPC();
 }
 
+void LoadL2Dungeon(const char *path, int vx, int vy)
+{
+	L2Generator(LevelGenerationContext {}).LoadDungeon(path, vx, vy);
+}
+
+void LoadPreL2Dungeon(const char *path)
+{
+	L2Generator(LevelGenerationContext {}).LoadPreDungeon(path);
+}
+
+void GenerateL2Dungeon(const LevelGenerationContext &context, uint32_t rseed, lvl_entry entry)
+{
+	L2Generator(context).Generate(rseed, entry);
+}
+
+void CreateL2Dungeon(uint32_t rseed, lvl_entry entry)
+{
+	if (!CommitPregeneratedLevel(rseed, entry))
+		GenerateL2Dungeon(LevelGenerationContext {}, rseed, entry);
+}
+
 } // namespace devilution
@@ -24,10 +24,15 @@ struct ROOMNODE {
 	int nRoomy2;
 };
 
-extern BYTE predungeon[DMAXX][DMAXY];
-
 void LoadL2Dungeon(const char *path, int vx, int vy);
 void LoadPreL2Dungeon(const char *path);
+/**
+ * @brief Lays out a catacombs level using the state of the given context.
+ *
+ * Levels 7 and 8 replay the generation of the levels above them, just like the base game.
+ */
+void GenerateL2Dungeon(const LevelGenerationContext &context, uint32_t rseed, lvl_entry entry);
+/** @brief Generates the current catacombs level, or takes it from the background pregeneration when available. */
 void CreateL2Dungeon(uint32_t rseed, lvl_entry entry);
 
 } // namespace devilution
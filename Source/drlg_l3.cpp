@@ -6,9 +6,11 @@
 
 #include <algorithm>
 
+#include "drlg_pattern.h"
 #include "engine/load_file.hpp"
 #include "engine/random.hpp"
 #include "gendung.h"
+#include "levelpregen.h"
 #include "lighting.h"
 #include "monster.h"
 #include "objdat.h"
@@ -20,11 +22,6 @@ namespace devilution {
 
 namespace {
 
-/** This will be true if a lava pool has been generated for the level */
-uint8_t lavapool;
-int lockoutcnt;
-bool lockout[DMAXX][DMAXY];
-
 /**
  * A lookup table for the 16 possible patterns of a 2x2 area,
  * where each cell either contains a SW wall or it doesn't.
@@ -842,7 +839,58 @@ const BYTE HivePattern42[] = {
 	// clang-format on
 };
 
-void InitDungeonFlags()
+class L3Generator : public LevelGenerationContext {
+public:
+	explicit L3Generator(const LevelGenerationContext &context)
+	    : LevelGenerationContext(context)
+	{
+	}
+
+	void LoadDungeon(const char *path, int vx, int vy);
+	void LoadPreDungeon(const char *path);
+	void Generate(uint32_t rseed, lvl_entry entry);
+
+private:
+	/** This will be true if a lava pool has been generated for the level */
+	uint8_t lavapool = 0;
+	int lockoutcnt = 0;
+	bool lockout[DMAXX][DMAXY] = {};
+
+	void InitDungeonFlags();
+	bool FillRoom(int x1, int y1, int x2, int y2);
+	void CreateBlock(int x, int y, int obs, int dir);
+	void FloorArea(int x1, int y1, int x2, int y2);
+	void FillDiagonals();
+	void FillSingles();
+	void FillStraights();
+	void Edges();
+	int GetFloorArea();
+	void MakeMegas();
+	void River();
+	bool SpawnEdge(int x, int y, int *totarea);
+	bool Spawn(int x, int y, int *totarea);
+	void Pool();
+	void PoolFix();
+	bool PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview);
+	void PlaceMiniSetRandom(MinisetMatcher &matcher, const BYTE *miniset, int rndper);
+	bool HivePlaceSetRandom(MinisetMatcher &matcher, const BYTE *miniset, int rndper);
+	bool FenceVerticalUp(int i, int y);
+	bool FenceVerticalDown(int i, int y);
+	bool FenceHorizontalLeft(int x, int j);
+	bool FenceHorizontalRight(int x, int j);
+	void AddFenceDoors();
+	void FenceDoorFix();
+	void Fence();
+	bool Anvil();
+	void Warp();
+	void HallOfHeroes();
+	void LockRectangle(int x, int y);
+	bool Lockout();
+	void GenerateLevel(lvl_entry entry);
+	void Pass3();
+};
+
+void L3Generator::InitDungeonFlags()
 {
 	memset(dungeon, 0, sizeof(dungeon));
 
@@ -854,7 +902,7 @@ void InitDungeonFlags()
 	}
 }
 
-bool FillRoom(int x1, int y1, int x2, int y2)
+bool L3Generator::FillRoom(int x1, int y1, int x2, int y2)
 {
 	if (x1 <= 1 || x2 >= 34 || y1 <= 1 || y2 >= 38) {
 		return false;
@@ -896,7 +944,7 @@ bool FillRoom(int x1, int y1, int x2, int y2)
 	return true;
 }
 
-void CreateBlock(int x, int y, int obs, int dir)
+void L3Generator::CreateBlock(int x, int y, int obs, int dir)
 {
 	int x1;
 	int y1;
@@ -980,7 +1028,7 @@ void CreateBlock(int x, int y, int obs, int dir)
 	}
 }
 
-void FloorArea(int x1, int y1, int x2, int y2)
+void L3Generator::FloorArea(int x1, int y1, int x2, int y2)
 {
 	for (int j = y1; j <= y2; j++) {
 		for (int i = x1; i <= x2; i++) {
@@ -989,7 +1037,7 @@ void FloorArea(int x1, int y1, int x2, int y2)
 	}
 }
 
-void FillDiagonals()
+void L3Generator::FillDiagonals()
 {
 	for (int j = 0; j < DMAXY - 1; j++) {
 		for (int i = 0; i < DMAXX - 1; i++) {
@@ -1012,7 +1060,7 @@ void FillDiagonals()
 	}
 }
 
-void FillSingles()
+void L3Generator::FillSingles()
 {
 	for (int j = 1; j < DMAXY - 1; j++) {
 		for (int i = 1; i < DMAXX - 1; i++) {
@@ -1026,7 +1074,7 @@ void FillSingles()
 	}
 }
 
-void FillStraights()
+void L3Generator::FillStraights()
 {
 	int xc;
 	int yc;
@@ -1109,7 +1157,7 @@ void FillStraights()
 	}
 }
 
-void Edges()
+void L3Generator::Edges()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		dungeon[DMAXX - 1][j] = 0;
@@ -1119,7 +1167,7 @@ void Edges()
 	}
 }
 
-int GetFloorArea()
+int L3Generator::GetFloorArea()
 {
 	int gfa = 0;
 
@@ -1132,7 +1180,7 @@ int GetFloorArea()
 	return gfa;
 }
 
-void MakeMegas()
+void L3Generator::MakeMegas()
 {
 	for (int j = 0; j < DMAXY - 1; j++) {
 		for (int i = 0; i < DMAXX - 1; i++) {
@@ -1162,7 +1210,7 @@ void MakeMegas()
 	}
 }
 
-void River()
+void L3Generator::River()
 {
 	int dir;
 	int nodir;
@@ -1413,9 +1461,7 @@ void River()
 	}
 }
 
-bool Spawn(int x, int y, int *totarea);
-
-bool SpawnEdge(int x, int y, int *totarea)
+bool L3Generator::SpawnEdge(int x, int y, int *totarea)
 {
 	BYTE i;
 	static BYTE spawntable[15] = { 0x00, 0x0A, 0x43, 0x05, 0x2c, 0x06, 0x09, 0x00, 0x00, 0x1c, 0x83, 0x06, 0x09, 0x0A, 0x05 };
@@ -1465,7 +1511,7 @@ bool SpawnEdge(int x, int y, int *totarea)
 	return false;
 }
 
-bool Spawn(int x, int y, int *totarea)
+bool L3Generator::Spawn(int x, int y, int *totarea)
 {
 	BYTE i;
 	static BYTE spawntable[15] = { 0x00, 0x0A, 0x03, 0x05, 0x0C, 0x06, 0x09, 0x00, 0x00, 0x0C, 0x03, 0x06, 0x09, 0x0A, 0x05 };
@@ -1523,7 +1569,7 @@ bool Spawn(int x, int y, int *totarea)
  * an area of at most 40 tiles and disconnected from the map edge.
  * If it finds one, converts it to lava tiles and sets lavapool to true.
  */
-void Pool()
+void L3Generator::Pool()
 {
 	constexpr uint8_t Poolsub[15] = { 0, 35, 26, 36, 25, 29, 34, 7, 33, 28, 27, 37, 32, 31, 30 };
 
@@ -1574,7 +1620,7 @@ void Pool()
 	}
 }
 
-void PoolFix()
+void L3Generator::PoolFix()
 {
 	for (int duny = 1; duny < DMAXY - 1; duny++) {     // BUGFIX: Change '0' to '1' and 'DMAXY' to 'DMAXY - 1' (fixed)
 		for (int dunx = 1; dunx < DMAXX - 1; dunx++) { // BUGFIX: Change '0' to '1' and 'DMAXX' to 'DMAXX - 1' (fixed)
@@ -1596,7 +1642,7 @@ void PoolFix()
 	}
 }
 
-bool PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview)
+bool L3Generator::PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview)
 {
 	int sw = miniset[0];
 	int sh = miniset[1];
@@ -1672,26 +1718,15 @@ bool PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool
 	return false;
 }
 
-void PlaceMiniSetRandom(const BYTE *miniset, int rndper)
+void L3Generator::PlaceMiniSetRandom(MinisetMatcher &matcher, const BYTE *miniset, int rndper)
 {
 	int sw = miniset[0];
 	int sh = miniset[1];
+	MinisetSearch search = MinisetSearch::FromMiniset(miniset);
 
 	for (int sy = 0; sy < DMAXX - sh; sy++) {
 		for (int sx = 0; sx < DMAXY - sw; sx++) {
-			bool found = true;
-			int ii = 2;
-			for (int yy = 0; yy < sh && found; yy++) {
-				for (int xx = 0; xx < sw && found; xx++) {
-					if (miniset[ii] != 0 && dungeon[xx + sx][yy + sy] != miniset[ii]) {
-						found = false;
-					}
-					if (dflags[xx + sx][yy + sy] != 0) {
-						found = false;
-					}
-					ii++;
-				}
-			}
+			bool found = matcher.Matches(search, { sx, sy });
 			int kk = sw * sh + 2;
 			if (found) {
 				if (miniset[kk] >= 84 && miniset[kk] <= 100) {
@@ -1715,7 +1750,7 @@ void PlaceMiniSetRandom(const BYTE *miniset, int rndper)
 				for (int yy = 0; yy < sh; yy++) {
 					for (int xx = 0; xx < sw; xx++) {
 						if (miniset[kk] != 0) {
-							dungeon[xx + sx][yy + sy] = miniset[kk];
+							matcher.SetTile({ xx + sx, yy + sy }, miniset[kk]);
 						}
 						kk++;
 					}
@@ -1725,27 +1760,16 @@ void PlaceMiniSetRandom(const BYTE *miniset, int rndper)
 	}
 }
 
-bool HivePlaceSetRandom(const BYTE *miniset, int rndper)
+bool L3Generator::HivePlaceSetRandom(MinisetMatcher &matcher, const BYTE *miniset, int rndper)
 {
 	bool placed = false;
 	int sw = miniset[0];
 	int sh = miniset[1];
+	MinisetSearch search = MinisetSearch::FromMiniset(miniset);
 
 	for (int sy = 0; sy < DMAXX - sh; sy++) {
 		for (int sx = 0; sx < DMAXY - sw; sx++) {
-			bool found = true;
-			int ii = 2;
-			for (int yy = 0; yy < sh && found; yy++) {
-				for (int xx = 0; xx < sw && found; xx++) {
-					if (miniset[ii] != 0 && dungeon[xx + sx][yy + sy] != miniset[ii]) {
-						found = false;
-					}
-					if (dflags[xx + sx][yy + sy] != 0) {
-						found = false;
-					}
-					ii++;
-				}
-			}
+			bool found = matcher.Matches(search, { sx, sy });
 			int kk = sw * sh + 2;
 			if (found) {
 				if (miniset[kk] >= 84 && miniset[kk] <= 100) {
@@ -1770,7 +1794,7 @@ bool HivePlaceSetRandom(const BYTE *miniset, int rndper)
 				for (int yy = 0; yy < sh; yy++) {
 					for (int xx = 0; xx < sw; xx++) {
 						if (miniset[kk] != 0) {
-							dungeon[xx + sx][yy + sy] = miniset[kk];
+							matcher.SetTile({ xx + sx, yy + sy }, miniset[kk]);
 						}
 						kk++;
 					}
@@ -1782,7 +1806,7 @@ bool HivePlaceSetRandom(const BYTE *miniset, int rndper)
 	return placed;
 }
 
-bool FenceVerticalUp(int i, int y)
+bool L3Generator::FenceVerticalUp(int i, int y)
 {
 	if ((dungeon[i + 1][y] > 152 || dungeon[i + 1][y] < 130)
 	    && (dungeon[i - 1][y] > 152 || dungeon[i - 1][y] < 130)) {
@@ -1794,7 +1818,7 @@ bool FenceVerticalUp(int i, int y)
 	return false;
 }
 
-bool FenceVerticalDown(int i, int y)
+bool L3Generator::FenceVerticalDown(int i, int y)
 {
 	if ((dungeon[i + 1][y] > 152 || dungeon[i + 1][y] < 130)
 	    && (dungeon[i - 1][y] > 152 || dungeon[i - 1][y] < 130)) {
@@ -1806,7 +1830,7 @@ bool FenceVerticalDown(int i, int y)
 	return false;
 }
 
-bool FenceHorizontalLeft(int x, int j)
+bool L3Generator::FenceHorizontalLeft(int x, int j)
 {
 	if ((dungeon[x][j + 1] > 152 || dungeon[x][j + 1] < 130)
 	    && (dungeon[x][j - 1] > 152 || dungeon[x][j - 1] < 130)) {
@@ -1818,7 +1842,7 @@ bool FenceHorizontalLeft(int x, int j)
 	return false;
 }
 
-bool FenceHorizontalRight(int x, int j)
+bool L3Generator::FenceHorizontalRight(int x, int j)
 {
 	if ((dungeon[x][j + 1] > 152 || dungeon[x][j + 1] < 130)
 	    && (dungeon[x][j - 1] > 152 || dungeon[x][j - 1] < 130)) {
@@ -1830,7 +1854,7 @@ bool FenceHorizontalRight(int x, int j)
 	return false;
 }
 
-void AddFenceDoors()
+void L3Generator::AddFenceDoors()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -1852,7 +1876,7 @@ void AddFenceDoors()
 	}
 }
 
-void FenceDoorFix()
+void L3Generator::FenceDoorFix()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -1886,7 +1910,7 @@ void FenceDoorFix()
 	}
 }
 
-void Fence()
+void L3Generator::Fence()
 {
 	for (int j = 1; j < DMAXY - 1; j++) {     // BUGFIX: Change '0' to '1' (fixed)
 		for (int i = 1; i < DMAXX - 1; i++) { // BUGFIX: Change '0' to '1' (fixed)
@@ -2078,7 +2102,7 @@ void Fence()
 	FenceDoorFix();
 }
 
-bool Anvil()
+bool L3Generator::Anvil()
 {
 	int sw = L3ANVIL[0];
 	int sh = L3ANVIL[1];
@@ -2136,7 +2160,7 @@ bool Anvil()
 	return false;
 }
 
-void Warp()
+void L3Generator::Warp()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -2154,7 +2178,7 @@ void Warp()
 	}
 }
 
-void HallOfHeroes()
+void L3Generator::HallOfHeroes()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -2179,7 +2203,7 @@ void HallOfHeroes()
 	}
 }
 
-void LockRectangle(int x, int y)
+void L3Generator::LockRectangle(int x, int y)
 {
 	if (!lockout[x][y]) {
 		return;
@@ -2193,7 +2217,7 @@ void LockRectangle(int x, int y)
 	LockRectangle(x + 1, y);
 }
 
-bool Lockout()
+bool L3Generator::Lockout()
 {
 	int fx;
 	int fy;
@@ -2218,7 +2242,7 @@ bool Lockout()
 	return t == lockoutcnt;
 }
 
-void GenerateLevel(lvl_entry entry)
+void L3Generator::GenerateLevel(lvl_entry entry)
 {
 	bool found;
 	bool genok;
@@ -2228,6 +2252,7 @@ void GenerateLevel(lvl_entry entry)
 	do {
 		do {
 			do {
+				layoutAttempts++;
 				InitDungeonFlags();
 				int x1 = GenerateRnd(20) + 10;
 				int y1 = GenerateRnd(20) + 10;
@@ -2238,7 +2263,7 @@ void GenerateLevel(lvl_entry entry)
 				CreateBlock(x2, y1, 2, 1);
 				CreateBlock(x1, y2, 2, 2);
 				CreateBlock(x1, y1, 2, 3);
-				if (Quests[Q_ANVIL].IsAvailable()) {
+				if (IsQuestAvailable(Q_ANVIL)) {
 					x1 = GenerateRnd(10) + 10;
 					y1 = GenerateRnd(10) + 10;
 					x2 = x1 + 12;
@@ -2321,20 +2346,21 @@ void GenerateLevel(lvl_entry entry)
 					}
 				}
 			}
-			if (!genok && Quests[Q_ANVIL].IsAvailable()) {
+			if (!genok && IsQuestAvailable(Q_ANVIL)) {
 				genok = Anvil();
 			}
 		} while (genok);
 		if (currlevel < 17) {
 			Pool();
 		} else {
-			if (HivePlaceSetRandom(HivePattern41, 30))
+			MinisetMatcher matcher(dungeon, dflags);
+			if (HivePlaceSetRandom(matcher, HivePattern41, 30))
 				lavapool++;
-			if (HivePlaceSetRandom(HivePattern42, 40))
+			if (HivePlaceSetRandom(matcher, HivePattern42, 40))
 				lavapool++;
-			if (HivePlaceSetRandom(HivePattern39, 50))
+			if (HivePlaceSetRandom(matcher, HivePattern39, 50))
 				lavapool++;
-			if (HivePlaceSetRandom(HivePattern40, 60))
+			if (HivePlaceSetRandom(matcher, HivePattern40, 60))
 				lavapool++;
 			if (lavapool < 3)
 				lavapool = 0;
@@ -2347,21 +2373,23 @@ void GenerateLevel(lvl_entry entry)
 		Warp();
 
 	if (currlevel < 17) {
-		PlaceMiniSetRandom(L3ISLE1, 70);
-		PlaceMiniSetRandom(L3ISLE2, 70);
-		PlaceMiniSetRandom(L3ISLE3, 30);
-		PlaceMiniSetRandom(L3ISLE4, 30);
-		PlaceMiniSetRandom(L3ISLE1, 100);
-		PlaceMiniSetRandom(L3ISLE2, 100);
-		PlaceMiniSetRandom(L3ISLE5, 90);
+		MinisetMatcher matcher(dungeon, dflags);
+		PlaceMiniSetRandom(matcher, L3ISLE1, 70);
+		PlaceMiniSetRandom(matcher, L3ISLE2, 70);
+		PlaceMiniSetRandom(matcher, L3ISLE3, 30);
+		PlaceMiniSetRandom(matcher, L3ISLE4, 30);
+		PlaceMiniSetRandom(matcher, L3ISLE1, 100);
+		PlaceMiniSetRandom(matcher, L3ISLE2, 100);
+		PlaceMiniSetRandom(matcher, L3ISLE5, 90);
 	} else {
-		PlaceMiniSetRandom(L6ISLE1, 70);
-		PlaceMiniSetRandom(L6ISLE2, 70);
-		PlaceMiniSetRandom(L6ISLE3, 30);
-		PlaceMiniSetRandom(L6ISLE4, 30);
-		PlaceMiniSetRandom(L6ISLE1, 100);
-		PlaceMiniSetRandom(L6ISLE2, 100);
-		PlaceMiniSetRandom(L6ISLE5, 90);
+		MinisetMatcher matcher(dungeon, dflags);
+		PlaceMiniSetRandom(matcher, L6ISLE1, 70);
+		PlaceMiniSetRandom(matcher, L6ISLE2, 70);
+		PlaceMiniSetRandom(matcher, L6ISLE3, 30);
+		PlaceMiniSetRandom(matcher, L6ISLE4, 30);
+		PlaceMiniSetRandom(matcher, L6ISLE1, 100);
+		PlaceMiniSetRandom(matcher, L6ISLE2, 100);
+		PlaceMiniSetRandom(matcher, L6ISLE5, 90);
 	}
 
 	if (currlevel < 17)
@@ -2369,7 +2397,7 @@ void GenerateLevel(lvl_entry entry)
 	if (currlevel < 17)
 		River();
 
-	if (Quests[Q_ANVIL].IsAvailable()) {
+	if (IsQuestAvailable(Q_ANVIL)) {
 		dungeon[setpc_x + 7][setpc_y + 5] = 7;
 		dungeon[setpc_x + 8][setpc_y + 5] = 7;
 		dungeon[setpc_x + 9][setpc_y + 5] = 7;
@@ -2383,82 +2411,84 @@ void GenerateLevel(lvl_entry entry)
 
 	if (currlevel < 17) {
 		Fence();
-		PlaceMiniSetRandom(L3TITE1, 10);
-		PlaceMiniSetRandom(L3TITE2, 10);
-		PlaceMiniSetRandom(L3TITE3, 10);
-		PlaceMiniSetRandom(L3TITE6, 20);
-		PlaceMiniSetRandom(L3TITE7, 20);
-		PlaceMiniSetRandom(L3TITE8, 20);
-		PlaceMiniSetRandom(L3TITE9, 20);
-		PlaceMiniSetRandom(L3TITE10, 20);
-		PlaceMiniSetRandom(L3TITE11, 30);
-		PlaceMiniSetRandom(L3TITE12, 20);
-		PlaceMiniSetRandom(L3TITE13, 20);
-		PlaceMiniSetRandom(L3CREV1, 30);
-		PlaceMiniSetRandom(L3CREV2, 30);
-		PlaceMiniSetRandom(L3CREV3, 30);
-		PlaceMiniSetRandom(L3CREV4, 30);
-		PlaceMiniSetRandom(L3CREV5, 30);
-		PlaceMiniSetRandom(L3CREV6, 30);
-		PlaceMiniSetRandom(L3CREV7, 30);
-		PlaceMiniSetRandom(L3CREV8, 30);
-		PlaceMiniSetRandom(L3CREV9, 30);
-		PlaceMiniSetRandom(L3CREV10, 30);
-		PlaceMiniSetRandom(L3CREV11, 30);
-		PlaceMiniSetRandom(L3XTRA1, 25);
-		PlaceMiniSetRandom(L3XTRA2, 25);
-		PlaceMiniSetRandom(L3XTRA3, 25);
-		PlaceMiniSetRandom(L3XTRA4, 25);
-		PlaceMiniSetRandom(L3XTRA5, 25);
+		MinisetMatcher matcher(dungeon, dflags);
+		PlaceMiniSetRandom(matcher, L3TITE1, 10);
+		PlaceMiniSetRandom(matcher, L3TITE2, 10);
+		PlaceMiniSetRandom(matcher, L3TITE3, 10);
+		PlaceMiniSetRandom(matcher, L3TITE6, 20);
+		PlaceMiniSetRandom(matcher, L3TITE7, 20);
+		PlaceMiniSetRandom(matcher, L3TITE8, 20);
+		PlaceMiniSetRandom(matcher, L3TITE9, 20);
+		PlaceMiniSetRandom(matcher, L3TITE10, 20);
+		PlaceMiniSetRandom(matcher, L3TITE11, 30);
+		PlaceMiniSetRandom(matcher, L3TITE12, 20);
+		PlaceMiniSetRandom(matcher, L3TITE13, 20);
+		PlaceMiniSetRandom(matcher, L3CREV1, 30);
+		PlaceMiniSetRandom(matcher, L3CREV2, 30);
+		PlaceMiniSetRandom(matcher, L3CREV3, 30);
+		PlaceMiniSetRandom(matcher, L3CREV4, 30);
+		PlaceMiniSetRandom(matcher, L3CREV5, 30);
+		PlaceMiniSetRandom(matcher, L3CREV6, 30);
+		PlaceMiniSetRandom(matcher, L3CREV7, 30);
+		PlaceMiniSetRandom(matcher, L3CREV8, 30);
+		PlaceMiniSetRandom(matcher, L3CREV9, 30);
+		PlaceMiniSetRandom(matcher, L3CREV10, 30);
+		PlaceMiniSetRandom(matcher, L3CREV11, 30);
+		PlaceMiniSetRandom(matcher, L3XTRA1, 25);
+		PlaceMiniSetRandom(matcher, L3XTRA2, 25);
+		PlaceMiniSetRandom(matcher, L3XTRA3, 25);
+		PlaceMiniSetRandom(matcher, L3XTRA4, 25);
+		PlaceMiniSetRandom(matcher, L3XTRA5, 25);
 	} else {
-		PlaceMiniSetRandom(HivePattern1, 20);
-		PlaceMiniSetRandom(HivePattern2, 20);
-		PlaceMiniSetRandom(HivePattern3, 20);
-		PlaceMiniSetRandom(HivePattern4, 20);
-		PlaceMiniSetRandom(HivePattern29, 10);
-		PlaceMiniSetRandom(HivePattern30, 15);
-		PlaceMiniSetRandom(HivePattern31, 20);
-		PlaceMiniSetRandom(HivePattern32, 25);
-		PlaceMiniSetRandom(HivePattern33, 30);
-		PlaceMiniSetRandom(HivePattern34, 35);
-		PlaceMiniSetRandom(HivePattern35, 40);
-		PlaceMiniSetRandom(HivePattern36, 45);
-		PlaceMiniSetRandom(HivePattern37, 50);
-		PlaceMiniSetRandom(HivePattern38, 55);
-		PlaceMiniSetRandom(HivePattern38, 10);
-		PlaceMiniSetRandom(HivePattern37, 15);
-		PlaceMiniSetRandom(HivePattern36, 20);
-		PlaceMiniSetRandom(HivePattern35, 25);
-		PlaceMiniSetRandom(HivePattern34, 30);
-		PlaceMiniSetRandom(HivePattern33, 35);
-		PlaceMiniSetRandom(HivePattern32, 40);
-		PlaceMiniSetRandom(HivePattern31, 45);
-		PlaceMiniSetRandom(HivePattern30, 50);
-		PlaceMiniSetRandom(HivePattern29, 55);
-		PlaceMiniSetRandom(HivePattern9, 40);
-		PlaceMiniSetRandom(HivePattern10, 45);
-		PlaceMiniSetRandom(HivePattern5, 25);
-		PlaceMiniSetRandom(HivePattern6, 25);
-		PlaceMiniSetRandom(HivePattern7, 25);
-		PlaceMiniSetRandom(HivePattern8, 25);
-		PlaceMiniSetRandom(HivePattern11, 25);
-		PlaceMiniSetRandom(HivePattern12, 25);
-		PlaceMiniSetRandom(HivePattern13, 25);
-		PlaceMiniSetRandom(HivePattern14, 25);
-		PlaceMiniSetRandom(HivePattern15, 25);
-		PlaceMiniSetRandom(HivePattern17, 25);
-		PlaceMiniSetRandom(HivePattern18, 25);
-		PlaceMiniSetRandom(HivePattern19, 25);
-		PlaceMiniSetRandom(HivePattern20, 25);
-		PlaceMiniSetRandom(HivePattern21, 25);
-		PlaceMiniSetRandom(HivePattern23, 25);
-		PlaceMiniSetRandom(HivePattern24, 25);
-		PlaceMiniSetRandom(HivePattern25, 25);
-		PlaceMiniSetRandom(HivePattern26, 25);
-		PlaceMiniSetRandom(HivePattern16, 25);
-		PlaceMiniSetRandom(HivePattern22, 25);
-		PlaceMiniSetRandom(HivePattern27, 25);
-		PlaceMiniSetRandom(HivePattern28, 25);
+		MinisetMatcher matcher(dungeon, dflags);
+		PlaceMiniSetRandom(matcher, HivePattern1, 20);
+		PlaceMiniSetRandom(matcher, HivePattern2, 20);
+		PlaceMiniSetRandom(matcher, HivePattern3, 20);
+		PlaceMiniSetRandom(matcher, HivePattern4, 20);
+		PlaceMiniSetRandom(matcher, HivePattern29, 10);
+		PlaceMiniSetRandom(matcher, HivePattern30, 15);
+		PlaceMiniSetRandom(matcher, HivePattern31, 20);
+		PlaceMiniSetRandom(matcher, HivePattern32, 25);
+		PlaceMiniSetRandom(matcher, HivePattern33, 30);
+		PlaceMiniSetRandom(matcher, HivePattern34, 35);
+		PlaceMiniSetRandom(matcher, HivePattern35, 40);
+		PlaceMiniSetRandom(matcher, HivePattern36, 45);
+		PlaceMiniSetRandom(matcher, HivePattern37, 50);
+		PlaceMiniSetRandom(matcher, HivePattern38, 55);
+		PlaceMiniSetRandom(matcher, HivePattern38, 10);
+		PlaceMiniSetRandom(matcher, HivePattern37, 15);
+		PlaceMiniSetRandom(matcher, HivePattern36, 20);
+		PlaceMiniSetRandom(matcher, HivePattern35, 25);
+		PlaceMiniSetRandom(matcher, HivePattern34, 30);
+		PlaceMiniSetRandom(matcher, HivePattern33, 35);
+		PlaceMiniSetRandom(matcher, HivePattern32, 40);
+		PlaceMiniSetRandom(matcher, HivePattern31, 45);
+		PlaceMiniSetRandom(matcher, HivePattern30, 50);
+		PlaceMiniSetRandom(matcher, HivePattern29, 55);
+		PlaceMiniSetRandom(matcher, HivePattern9, 40);
+		PlaceMiniSetRandom(matcher, HivePattern10, 45);
+		PlaceMiniSetRandom(matcher, HivePattern5, 25);
+		PlaceMiniSetRandom(matcher, HivePattern6, 25);
+		PlaceMiniSetRandom(matcher, HivePattern7, 25);
+		PlaceMiniSetRandom(matcher, HivePattern8, 25);
+		PlaceMiniSetRandom(matcher, HivePattern11, 25);
+		PlaceMiniSetRandom(matcher, HivePattern12, 25);
+		PlaceMiniSetRandom(matcher, HivePattern13, 25);
+		PlaceMiniSetRandom(matcher, HivePattern14, 25);
+		PlaceMiniSetRandom(matcher, HivePattern15, 25);
+		PlaceMiniSetRandom(matcher, HivePattern17, 25);
+		PlaceMiniSetRandom(matcher, HivePattern18, 25);
+		PlaceMiniSetRandom(matcher, HivePattern19, 25);
+		PlaceMiniSetRandom(matcher, HivePattern20, 25);
+		PlaceMiniSetRandom(matcher, HivePattern21, 25);
+		PlaceMiniSetRandom(matcher, HivePattern23, 25);
+		PlaceMiniSetRandom(matcher, HivePattern24, 25);
+		PlaceMiniSetRandom(matcher, HivePattern25, 25);
+		PlaceMiniSetRandom(matcher, HivePattern26, 25);
+		PlaceMiniSetRandom(matcher, HivePattern16, 25);
+		PlaceMiniSetRandom(matcher, HivePattern22, 25);
+		PlaceMiniSetRandom(matcher, HivePattern27, 25);
+		PlaceMiniSetRandom(matcher, HivePattern28, 25);
 	}
 
 	for (int j = 0; j < DMAXY; j++) {
@@ -2470,51 +2500,14 @@ void GenerateLevel(lvl_entry entry)
 	DRLG_Init_Globals();
 }
 
-void Pass3()
+void L3Generator::Pass3()
 {
 	DRLG_LPass3(8 - 1);
 }
 
 } // namespace
 
-void CreateL3Dungeon(uint32_t rseed, lvl_entry entry)
-{
-	SetRndSeed(rseed);
-
-	dminPosition = { 16, 16 };
-	dmaxPosition = { 96, 96 };
-
-	DRLG_InitTrans();
-	DRLG_InitSetPC();
-	GenerateLevel(entry);
-	Pass3();
-
-	if (currlevel < 17) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) {
-				if (dPiece[i][j] >= 56 && dPiece[i][j] <= 147) {
-					DoLighting({ i, j }, 7, -1);
-				} else if (dPiece[i][j] >= 154 && dPiece[i][j] <= 161) {
-					DoLighting({ i, j }, 7, -1);
-				} else if (dPiece[i][j] == AnyOf(150, 152)) {
-					DoLighting({ i, j }, 7, -1);
-				}
-			}
-		}
-	} else {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) {
-				if (dPiece[i][j] >= 382 && dPiece[i][j] <= 457) {
-					DoLighting({ i, j }, 9, -1);
-				}
-			}
-		}
-	}
-
-	DRLG_SetPC();
-}
-
-void LoadL3Dungeon(const char *path, int vx, int vy)
+void L3Generator::LoadDungeon(const char *path, int vx, int vy)
 {
 	dminPosition = { 16, 16 };
 	dmaxPosition = { 96, 96 };
@@ -2565,7 +2558,7 @@ void LoadL3Dungeon(const char *path, int vx, int vy)
 	}
 }
 
-void LoadPreL3Dungeon(const char *path)
+void L3Generator::LoadPreDungeon(const char *path)
 {
 	InitDungeonFlags();
 	DRLG_InitTrans();
@@ -2595,4 +2588,62 @@ void LoadPreL3Dungeon(const char *path)
 	memcpy(pdungeon, dungeon, sizeof(pdungeon));
 }
 
+void L3Generator::Generate(uint32_t rseed, lvl_entry entry)
+{
+	SetRndSeed(rseed);
+
+	dminPosition = { 16, 16 };
+	dmaxPosition = { 96, 96 };
+
+	DRLG_InitTrans();
+	DRLG_InitSetPC();
+	GenerateLevel(entry);
+	Pass3();
+	DRLG_SetPC();
+}
+
+void GenerateL3Dungeon(const LevelGenerationContext &context, uint32_t rseed, lvl_entry entry)
+{
+	L3Generator(context).Generate(rseed, entry);
+}
+
+void CreateL3Dungeon(uint32_t rseed, lvl_entry entry)
+{
+	if (!CommitPregeneratedLevel(rseed, entry))
+		GenerateL3Dungeon(LevelGenerationContext {}, rseed, entry);
+
+	// Lava lights go through the light map of the active level so they are added once the layout is in place
+	if (currlevel < 17) {
+		for (int j = 0; j < MAXDUNY; j++) {
+			for (int i = 0; i < MAXDUNX; i++) {
+				if (dPiece[i][j] >= 56 && dPiece[i][j] <= 147) {
+					DoLighting({ i, j }, 7, -1);
+				} else if (dPiece[i][j] >= 154 && dPiece[i][j] <= 161) {
+					DoLighting({ i, j }, 7, -1);
+				} else if (dPiece[i][j] == AnyOf(150, 152)) {
+					DoLighting({ i, j }, 7, -1);
+				}
+			}
+		}
+	} else {
+		for (int j = 0; j < MAXDUNY; j++) {
+			for (int i = 0; i < MAXDUNX; i++) {
+				if (dPiece[i][j] >= 382 && dPiece[i][j] <= 457) {
+					DoLighting({ i, j }, 9, -1);
+				}
+			}
+		}
+	}
+}
+
+void LoadL3Dungeon(const char *path, int vx, int vy)
+{
+	L3Generator(LevelGenerationContext {}).LoadDungeon(path, vx, vy);
+}
+
+void LoadPreL3Dungeon(const char *path)
+{
+	L3Generator(LevelGenerationContext {}).LoadPreDungeon(path);
+}
+
 } // namespace devilution
@@ -9,6 +9,9 @@
 
 namespace devilution {
 
+/** @brief Lays out a caves or nest level using the state of the given context. */
+void GenerateL3Dungeon(const LevelGenerationContext &context, uint32_t rseed, lvl_entry entry);
+/** @brief Generates the current caves or nest level, or takes it from the background pregeneration when available. */
 void CreateL3Dungeon(uint32_t rseed, lvl_entry entry);
 void LoadL3Dungeon(const char *sFileName, int vx, int vy);
 void LoadPreL3Dungeon(const char *sFileName);
@@ -8,6 +8,7 @@
 #include "engine/load_file.hpp"
 #include "engine/random.hpp"
 #include "gendung.h"
+#include "levelpregen.h"
 #include "monster.h"
 #include "multi.h"
 #include "objdat.h"
@@ -25,15 +26,6 @@ int diabquad4y;
 
 namespace {
 
-bool hallok[20];
-int l4holdx;
-int l4holdy;
-int SP4x1;
-int SP4y1;
-int SP4x2;
-int SP4y2;
-BYTE L4dungeon[80][80];
-BYTE dung[20][20];
 //int dword_52A4DC;
 
 /**
@@ -151,7 +143,67 @@ const BYTE L4BTYPES[140] = {
 	0, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
-void ApplyShadowsPatterns()
+class L4Generator : public LevelGenerationContext {
+public:
+	explicit L4Generator(const LevelGenerationContext &context)
+	    : LevelGenerationContext(context)
+	{
+	}
+
+	void LoadDungeon(const char *path, int vx, int vy);
+	void LoadPreDungeon(const char *path);
+	void Generate(uint32_t rseed, lvl_entry entry);
+
+private:
+	/** Specifies whether a single player quest DUN has been loaded. */
+	bool setloadflag = false;
+	/** Contains the contents of the single player quest DUN file. */
+	std::unique_ptr<uint16_t[]> pSetPiece;
+	bool hallok[20] = {};
+	int l4holdx = 0;
+	int l4holdy = 0;
+	int SP4x1 = 0;
+	int SP4y1 = 0;
+	int SP4x2 = 0;
+	int SP4y2 = 0;
+	BYTE L4dungeon[80][80] = {};
+	BYTE dung[20][20] = {};
+
+	void ApplyShadowsPatterns();
+	bool PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview);
+	void LoadQuestSetPieces();
+	void FreeQuestSetPieces();
+	void InitDungeonFlags();
+	void SetRoom(const uint16_t *dunData, int rx1, int ry1);
+	void MapRoom(int x, int y, int width, int height);
+	bool CheckRoom(int x, int y, int width, int height);
+	void GenerateRoom(int x, int y, int w, int h, int dir);
+	void FirstRoom();
+	void SetSetPiecesRoom(int rx1, int ry1);
+	void MakeDungeon();
+	void MakeDmt();
+	int HorizontalWallOk(int i, int j);
+	int VerticalWallOk(int i, int j);
+	void HorizontalWall(int i, int j, int dx);
+	void VerticalWall(int i, int j, int dy);
+	void AddWall();
+	void FixTilesPatterns();
+	void Substitution();
+	void UShape();
+	int GetArea();
+	void SaveQuads();
+	void LoadDiabQuads(bool preflag);
+	bool IsDURightWall(char d);
+	bool IsDLLeftWall(char dd);
+	void FixTransparency();
+	void FixCornerTiles();
+	void FixRim();
+	void GeneralFix();
+	void GenerateLevel(lvl_entry entry);
+	void Pass3();
+};
+
+void L4Generator::ApplyShadowsPatterns()
 {
 	for (int y = 1; y < DMAXY; y++) {
 		for (int x = 1; x < DMAXY; x++) {
@@ -168,7 +220,7 @@ void ApplyShadowsPatterns()
 	}
 }
 
-bool PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview)
+bool L4Generator::PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool setview)
 {
 	int sx;
 	int sy;
@@ -240,7 +292,7 @@ bool PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool
 		}
 	}
 
-	if (currlevel == 15 && Quests[Q_BETRAYER]._qactive >= QUEST_ACTIVE) { /// Lazarus staff skip bug fixed
+	if (currlevel == 15 && GetQuestState(Q_BETRAYER) >= QUEST_ACTIVE) { /// Lazarus staff skip bug fixed
 		Quests[Q_BETRAYER].position = { sx + 1, sy + 1 };
 	}
 	if (setview) {
@@ -250,21 +302,21 @@ bool PlaceMiniSet(const BYTE *miniset, int tmin, int tmax, int cx, int cy, bool
 	return true;
 }
 
-void LoadQuestSetPieces()
+void L4Generator::LoadQuestSetPieces()
 {
 	setloadflag = false;
-	if (Quests[Q_WARLORD].IsAvailable()) {
+	if (IsQuestAvailable(Q_WARLORD)) {
 		pSetPiece = LoadFileInMem<uint16_t>("Levels\\L4Data\\Warlord.DUN");
 		setloadflag = true;
 	}
 }
 
-void FreeQuestSetPieces()
+void L4Generator::FreeQuestSetPieces()
 {
 	pSetPiece = nullptr;
 }
 
-void InitDungeonFlags()
+void L4Generator::InitDungeonFlags()
 {
 	memset(dung, 0, sizeof(dung));
 	memset(L4dungeon, 0, sizeof(L4dungeon));
@@ -277,7 +329,7 @@ void InitDungeonFlags()
 	}
 }
 
-void SetRoom(const uint16_t *dunData, int rx1, int ry1)
+void L4Generator::SetRoom(const uint16_t *dunData, int rx1, int ry1)
 {
 	int width = SDL_SwapLE16(dunData[0]);
 	int height = SDL_SwapLE16(dunData[1]);
@@ -297,7 +349,7 @@ void SetRoom(const uint16_t *dunData, int rx1, int ry1)
 	}
 }
 
-void MapRoom(int x, int y, int width, int height)
+void L4Generator::MapRoom(int x, int y, int width, int height)
 {
 	for (int j = 0; j < height && j + y < 20; j++) {
 		for (int i = 0; i < width && i + x < 20; i++) {
@@ -306,7 +358,7 @@ void MapRoom(int x, int y, int width, int height)
 	}
 }
 
-bool CheckRoom(int x, int y, int width, int height)
+bool L4Generator::CheckRoom(int x, int y, int width, int height)
 {
 	if (x <= 0 || y <= 0) {
 		return false;
@@ -326,7 +378,7 @@ bool CheckRoom(int x, int y, int width, int height)
 	return true;
 }
 
-void GenerateRoom(int x, int y, int w, int h, int dir)
+void L4Generator::GenerateRoom(int x, int y, int w, int h, int dir)
 {
 	int dirProb = GenerateRnd(4);
 	int num = 0;
@@ -384,12 +436,12 @@ void GenerateRoom(int x, int y, int w, int h, int dir)
 		GenerateRoom(rx, ry2, width, height, 0);
 }
 
-void FirstRoom()
+void L4Generator::FirstRoom()
 {
 	int w = 14;
 	int h = 14;
 	if (currlevel != 16) {
-		if (currlevel == Quests[Q_WARLORD]._qlevel && Quests[Q_WARLORD]._qactive != QUEST_NOTAVAIL) {
+		if (IsQuestAvailable(Q_WARLORD)) {
 			w = 11;
 			h = 11;
 		} else {
@@ -410,7 +462,7 @@ void FirstRoom()
 		l4holdx = x;
 		l4holdy = y;
 	}
-	if (Quests[Q_WARLORD].IsAvailable()) {
+	if (IsQuestAvailable(Q_WARLORD)) {
 		SP4x1 = x + 1;
 		SP4y1 = y + 1;
 		SP4x2 = SP4x1 + w;
@@ -426,7 +478,7 @@ void FirstRoom()
 	GenerateRoom(x, y, w, h, GenerateRnd(2));
 }
 
-void SetSetPiecesRoom(int rx1, int ry1)
+void L4Generator::SetSetPiecesRoom(int rx1, int ry1)
 {
 	setpc_x = rx1;
 	setpc_y = ry1;
@@ -436,7 +488,7 @@ void SetSetPiecesRoom(int rx1, int ry1)
 	SetRoom(pSetPiece.get(), rx1, ry1);
 }
 
-void MakeDungeon()
+void L4Generator::MakeDungeon()
 {
 	for (int j = 0; j < 20; j++) {
 		for (int i = 0; i < 20; i++) {
@@ -480,7 +532,7 @@ void MakeDungeon()
 	}
 }
 
-void MakeDmt()
+void L4Generator::MakeDmt()
 {
 	int dmty = 1;
 	for (int j = 0; dmty <= 77; j++, dmty += 2) {
@@ -495,7 +547,7 @@ void MakeDmt()
 	}
 }
 
-int HorizontalWallOk(int i, int j)
+int L4Generator::HorizontalWallOk(int i, int j)
 {
 	int x;
 	for (x = 1; dungeon[i + x][j] == 6; x++) {
@@ -516,7 +568,7 @@ int HorizontalWallOk(int i, int j)
 	return -1;
 }
 
-int VerticalWallOk(int i, int j)
+int L4Generator::VerticalWallOk(int i, int j)
 {
 	int y;
 	for (y = 1; dungeon[i][j + y] == 6; y++) {
@@ -537,7 +589,7 @@ int VerticalWallOk(int i, int j)
 	return -1;
 }
 
-void HorizontalWall(int i, int j, int dx)
+void L4Generator::HorizontalWall(int i, int j, int dx)
 {
 	if (dungeon[i][j] == 13) {
 		dungeon[i][j] = 17;
@@ -579,7 +631,7 @@ void HorizontalWall(int i, int j, int dx)
 	}
 }
 
-void VerticalWall(int i, int j, int dy)
+void L4Generator::VerticalWall(int i, int j, int dy)
 {
 	if (dungeon[i][j] == 14) {
 		dungeon[i][j] = 17;
@@ -624,7 +676,7 @@ void VerticalWall(int i, int j, int dy)
 	}
 }
 
-void AddWall()
+void L4Generator::AddWall()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -653,7 +705,7 @@ void AddWall()
 	}
 }
 
-void FixTilesPatterns()
+void L4Generator::FixTilesPatterns()
 {
 	for (int j = 0; j < DMAXY; j++) {
 		for (int i = 0; i < DMAXX; i++) {
@@ -1002,7 +1054,7 @@ void FixTilesPatterns()
 	}
 }
 
-void Substitution()
+void L4Generator::Substitution()
 {
 	for (int y = 0; y < DMAXY; y++) {
 		for (int x = 0; x < DMAXX; x++) {
@@ -1039,7 +1091,7 @@ void Substitution()
 	}
 }
 
-void UShape()
+void L4Generator::UShape()
 {
 	for (int j = 19; j >= 0; j--) {
 		for (int i = 19; i >= 0; i--) {
@@ -1118,7 +1170,7 @@ void UShape()
 	} while (rv != 0);
 }
 
-int GetArea()
+int L4Generator::GetArea()
 {
 	int rv = 0;
 
@@ -1133,7 +1185,7 @@ int GetArea()
 	return rv;
 }
 
-void SaveQuads()
+void L4Generator::SaveQuads()
 {
 	int x = l4holdx;
 	int y = l4holdy;
@@ -1148,7 +1200,7 @@ void SaveQuads()
 	}
 }
 
-void LoadDiabQuads(bool preflag)
+void L4Generator::LoadDiabQuads(bool preflag)
 {
 	{
 		auto dunData = LoadFileInMem<uint16_t>("Levels\\L4Data\\diab1.DUN");
@@ -1176,7 +1228,7 @@ void LoadDiabQuads(bool preflag)
 	}
 }
 
-bool IsDURightWall(char d)
+bool L4Generator::IsDURightWall(char d)
 {
 	if (d == 25) {
 		return true;
@@ -1191,7 +1243,7 @@ bool IsDURightWall(char d)
 	return false;
 }
 
-bool IsDLLeftWall(char dd)
+bool L4Generator::IsDLLeftWall(char dd)
 {
 	if (dd == 27) {
 		return true;
@@ -1206,7 +1258,7 @@ bool IsDLLeftWall(char dd)
 	return false;
 }
 
-void FixTransparency()
+void L4Generator::FixTransparency()
 {
 	int yy = 16;
 	for (int j = 0; j < DMAXY; j++) {
@@ -1249,7 +1301,7 @@ void FixTransparency()
 	}
 }
 
-void FixCornerTiles()
+void L4Generator::FixCornerTiles()
 {
 	for (int j = 1; j < DMAXY - 1; j++) {
 		for (int i = 1; i < DMAXX - 1; i++) {
@@ -1262,7 +1314,7 @@ void FixCornerTiles()
 	}
 }
 
-void FixRim()
+void L4Generator::FixRim()
 {
 	for (int i = 0; i < 20; i++) { // NOLINT(modernize-loop-convert)
 		dung[i][0] = 0;
@@ -1272,7 +1324,7 @@ void FixRim()
 	}
 }
 
-void GeneralFix()
+void L4Generator::GeneralFix()
 {
 	for (int j = 0; j < DMAXY - 1; j++) {
 		for (int i = 0; i < DMAXX - 1; i++) {
@@ -1283,7 +1335,7 @@ void GeneralFix()
 	}
 }
 
-void GenerateLevel(lvl_entry entry)
+void L4Generator::GenerateLevel(lvl_entry entry)
 {
 	constexpr int Minarea = 173;
 	int ar;
@@ -1292,6 +1344,7 @@ void GenerateLevel(lvl_entry entry)
 		DRLG_InitTrans();
 
 		do {
+			layoutAttempts++;
 			InitDungeonFlags();
 			FirstRoom();
 			FixRim();
@@ -1307,7 +1360,7 @@ void GenerateLevel(lvl_entry entry)
 		if (currlevel == 16) {
 			SaveQuads();
 		}
-		if (Quests[Q_WARLORD].IsAvailable()) {
+		if (IsQuestAvailable(Q_WARLORD)) {
 			for (int spi = SP4x1; spi < SP4x2; spi++) {
 				for (int spj = SP4y1; spj < SP4y2; spj++) {
 					dflags[spi][spj] = 1;
@@ -1323,7 +1376,7 @@ void GenerateLevel(lvl_entry entry)
 		if (currlevel == 16) {
 			LoadDiabQuads(true);
 		}
-		if (Quests[Q_WARLORD].IsAvailable()) {
+		if (IsQuestAvailable(Q_WARLORD)) {
 			if (entry == ENTRY_MAIN) {
 				doneflag = PlaceMiniSet(L4USTAIRS, 1, 1, -1, -1, true);
 				if (doneflag && currlevel == 13) {
@@ -1376,7 +1429,7 @@ void GenerateLevel(lvl_entry entry)
 			if (entry == ENTRY_MAIN) {
 				doneflag = PlaceMiniSet(L4USTAIRS, 1, 1, -1, -1, true);
 				if (doneflag) {
-					if (Quests[Q_DIABLO]._qactive != QUEST_ACTIVE) {
+					if (GetQuestState(Q_DIABLO) != QUEST_ACTIVE) {
 						doneflag = PlaceMiniSet(L4PENTA, 1, 1, -1, -1, false);
 					} else {
 						doneflag = PlaceMiniSet(L4PENTA2, 1, 1, -1, -1, false);
@@ -1386,7 +1439,7 @@ void GenerateLevel(lvl_entry entry)
 			} else {
 				doneflag = PlaceMiniSet(L4USTAIRS, 1, 1, -1, -1, false);
 				if (doneflag) {
-					if (Quests[Q_DIABLO]._qactive != QUEST_ACTIVE) {
+					if (GetQuestState(Q_DIABLO) != QUEST_ACTIVE) {
 						doneflag = PlaceMiniSet(L4PENTA, 1, 1, -1, -1, true);
 					} else {
 						doneflag = PlaceMiniSet(L4PENTA2, 1, 1, -1, -1, true);
@@ -1408,7 +1461,7 @@ void GenerateLevel(lvl_entry entry)
 	Substitution();
 	DRLG_Init_Globals();
 
-	if (Quests[Q_WARLORD].IsAvailable()) {
+	if (IsQuestAvailable(Q_WARLORD)) {
 		for (int j = 0; j < DMAXY; j++) {
 			for (int i = 0; i < DMAXX; i++) {
 				pdungeon[i][j] = dungeon[i][j];
@@ -1440,14 +1493,14 @@ void GenerateLevel(lvl_entry entry)
 	}
 }
 
-void Pass3()
+void L4Generator::Pass3()
 {
 	DRLG_LPass3(30 - 1);
 }
 
 } // namespace
 
-void CreateL4Dungeon(uint32_t rseed, lvl_entry entry)
+void L4Generator::Generate(uint32_t rseed, lvl_entry entry)
 {
 	SetRndSeed(rseed);
 
@@ -1464,7 +1517,7 @@ void CreateL4Dungeon(uint32_t rseed, lvl_entry entry)
 	DRLG_SetPC();
 }
 
-void LoadL4Dungeon(const char *path, int vx, int vy)
+void L4Generator::LoadDungeon(const char *path, int vx, int vy)
 {
 	dminPosition = { 16, 16 };
 	dmaxPosition = { 96, 96 };
@@ -1485,7 +1538,7 @@ void LoadL4Dungeon(const char *path, int vx, int vy)
 	SetMapObjects(dunData.get(), 0, 0);
 }
 
-void LoadPreL4Dungeon(const char *path)
+void L4Generator::LoadPreDungeon(const char *path)
 {
 	dminPosition = { 16, 16 };
 	dmaxPosition = { 96, 96 };
@@ -1497,4 +1550,25 @@ void LoadPreL4Dungeon(const char *path)
 	SetRoom(dunData.get(), 0, 0);
 }
 
+void GenerateL4Dungeon(const LevelGenerationContext &context, uint32_t rseed, lvl_entry entry)
+{
+	L4Generator(context).Generate(rseed, entry);
+}
+
+void CreateL4Dungeon(uint32_t rseed, lvl_entry entry)
+{
+	if (!CommitPregeneratedLevel(rseed, entry))
+		GenerateL4Dungeon(LevelGenerationContext {}, rseed, entry);
+}
+
+void LoadL4Dungeon(const char *path, int vx, int vy)
+{
+	L4Generator(LevelGenerationContext {}).LoadDungeon(path, vx, vy);
+}
+
+void LoadPreL4Dungeon(const char *path)
+{
+	L4Generator(LevelGenerationContext {}).LoadPreDungeon(path);
+}
+
 } // namespace devilution
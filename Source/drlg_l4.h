@@ -17,6 +17,9 @@ extern int diabquad3x;
 extern int diabquad3y;
 extern int diabquad4x;
 extern int diabquad4y;
+/** @brief Lays out a hell level using the state of the given context. */
+void GenerateL4Dungeon(const LevelGenerationContext &context, uint32_t rseed, lvl_entry entry);
+/** @brief Generates the current hell level, or takes it from the background pregeneration when available. */
 void CreateL4Dungeon(uint32_t rseed, lvl_entry entry);
 void LoadL4Dungeon(const char *path, int vx, int vy);
 void LoadPreL4Dungeon(const char *path);
@@ -0,0 +1,72 @@
+/**
+ * @file drlg_pattern.cpp
+ *
+ * Implementation of the indexed tile pattern matching used when placing minisets.
+ */
+#include "drlg_pattern.h"
+
+namespace devilution {
+
+namespace {
+
+constexpr int TileValues = 256;
+
+} // namespace
+
+MinisetMatcher::MinisetMatcher(uint8_t (&dungeon)[DMAXX][DMAXY], const uint8_t (&flags)[DMAXX][DMAXY])
+    : dungeon_(dungeon)
+    , tileRows_(new DungeonRowMask[TileValues * DMAXY] {})
+    , flaggedRows_ {}
+{
+	for (int y = 0; y < DMAXY; y++) {
+		for (int x = 0; x < DMAXX; x++) {
+			DungeonRowMask column = DungeonRowMask { 1 } << x;
+			tileRows_[dungeon[x][y] * DMAXY + y] |= column;
+			if (flags[x][y] != 0)
+				flaggedRows_[y] |= column;
+		}
+	}
+}
+
+DungeonRowMask MinisetMatcher::FindMatches(const MinisetSearch &search, int sy) const
+{
+	DungeonRowMask matches = AllDungeonColumns >> (search.size.width - 1);
+
+	for (int yy = 0; yy < search.size.height && matches != 0; yy++) {
+		int y = sy + yy;
+		const uint8_t *row = &search.tiles[yy * search.stride];
+		for (int xx = 0; xx < search.size.width; xx++) {
+			matches &= ~OffsetRowMask(flaggedRows_[y], xx, false);
+			if (row[xx] != 0)
+				matches &= OffsetRowMask(tileRows_[row[xx] * DMAXY + y], xx, false);
+		}
+	}
+
+	return matches;
+}
+
+bool MinisetMatcher::Matches(const MinisetSearch &search, Point origin) const
+{
+	if (cachedTiles_ != search.tiles || cachedRow_ != origin.y) {
+		cachedMatches_ = FindMatches(search, origin.y);
+		cachedTiles_ = search.tiles;
+		cachedRow_ = origin.y;
+	}
+
+	return (cachedMatches_ & (DungeonRowMask { 1 } << origin.x)) != 0;
+}
+
+void MinisetMatcher::SetTile(Point position, uint8_t tile)
+{
+	uint8_t &current = dungeon_[position.x][position.y];
+	if (current == tile)
+		return;
+
+	DungeonRowMask column = DungeonRowMask { 1 } << position.x;
+	tileRows_[current * DMAXY + position.y] &= ~column;
+	tileRows_[tile * DMAXY + position.y] |= column;
+	current = tile;
+	cachedTiles_ = nullptr;
+}
+
+} // namespace devilution
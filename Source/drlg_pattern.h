@@ -0,0 +1,107 @@
+/**
+ * @file drlg_pattern.h
+ *
+ * Interface of the indexed tile pattern matching used when placing minisets.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "engine/point.hpp"
+#include "engine/size.hpp"
+#include "gendung.h"
+
+namespace devilution {
+
+/** Bit x is set when column x of a dungeon row is part of the set */
+using DungeonRowMask = uint64_t;
+
+static_assert(DMAXX <= 64, "A dungeon row must fit in a DungeonRowMask");
+
+/** Row mask with a bit set for every column of the dungeon */
+constexpr DungeonRowMask AllDungeonColumns = (DungeonRowMask { 1 } << DMAXX) - 1;
+
+/**
+ * @brief Lines up a row mask with the origins of a pattern
+ * @param mask Row mask of the tile the pattern checks
+ * @param offset Column of the tile relative to the origin, may be negative
+ * @param outsideMatches Whether columns outside of the dungeon count as set
+ * @return A row mask where bit x tells if column x + offset is set
+ */
+constexpr DungeonRowMask OffsetRowMask(DungeonRowMask mask, int offset, bool outsideMatches)
+{
+	if (offset >= 0) {
+		DungeonRowMask shifted = mask >> offset;
+		if (outsideMatches)
+			shifted |= AllDungeonColumns & ~(AllDungeonColumns >> offset);
+		return shifted;
+	}
+
+	DungeonRowMask shifted = (mask << -offset) & AllDungeonColumns;
+	if (outsideMatches)
+		shifted |= (DungeonRowMask { 1 } << -offset) - 1;
+	return shifted;
+}
+
+/**
+ * @brief The tiles a miniset looks for, 0 matches any tile
+ */
+struct MinisetSearch {
+	Size size;
+	/** Distance between two rows of tiles */
+	int stride;
+	/** Tiles indexed as [y * stride + x] */
+	const uint8_t *tiles;
+
+	/** @brief Reads the search part of a miniset stored as { width, height, search..., replace... } */
+	static MinisetSearch FromMiniset(const uint8_t *miniset)
+	{
+		return { { miniset[0], miniset[1] }, miniset[0], &miniset[2] };
+	}
+};
+
+/**
+ * @brief Finds the origins where a miniset fits without comparing it against every origin
+ *
+ * Keeps a row mask per tile value so a whole dungeon row of origins is tested at once. The index is built from the
+ * map on construction, tiles written while it is in use have to go through SetTile to keep it valid.
+ */
+class MinisetMatcher {
+public:
+	/**
+	 * @param dungeon Map to search, written by SetTile
+	 * @param flags Tiles with any flag set never match
+	 */
+	MinisetMatcher(uint8_t (&dungeon)[DMAXX][DMAXY], const uint8_t (&flags)[DMAXX][DMAXY]);
+
+	/**
+	 * @brief Finds all origins in a row where the search matches
+	 * @param search Tiles to look for
+	 * @param sy Row of the origins, the search must fit below it
+	 * @return A row mask with a bit set for each matching origin, only origins where the search fits are included
+	 */
+	DungeonRowMask FindMatches(const MinisetSearch &search, int sy) const;
+
+	/**
+	 * @brief Checks a single origin, repeated calls on the same row only do the matching once
+	 */
+	bool Matches(const MinisetSearch &search, Point origin) const;
+
+	/**
+	 * @brief Writes a tile to the map and keeps the index up to date
+	 */
+	void SetTile(Point position, uint8_t tile);
+
+private:
+	uint8_t (&dungeon_)[DMAXX][DMAXY];
+	/** Rows of each tile value, indexed as [tile * DMAXY + y] */
+	std::unique_ptr<DungeonRowMask[]> tileRows_;
+	DungeonRowMask flaggedRows_[DMAXY];
+
+	mutable const uint8_t *cachedTiles_ = nullptr;
+	mutable int cachedRow_ = -1;
+	mutable DungeonRowMask cachedMatches_ = 0;
+};
+
+} // namespace devilution
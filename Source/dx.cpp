@@ -14,6 +14,7 @@
 #include "utils/log.hpp"
 #include "utils/sdl_mutex.h"
 #include "utils/sdl_wrap.h"
+#include "utils/timing.h"
 
 namespace devilution {
 
@@ -112,14 +113,19 @@ void LimitFrameRate()
 {
 	if (!sgOptions.Graphics.bFPSLimit)
 		return;
-	static uint32_t frameDeadline;
-	uint32_t tc = SDL_GetTicks() * 1000;
-	uint32_t v = 0;
-	if (frameDeadline > tc) {
-		v = tc % refreshDelay;
-		SDL_Delay(v / 1000 + 1); // ceil
+	static uint64_t frameDeadline;
+	const uint64_t frameDuration = MicrosecondsToPerformanceTicks(refreshDelay);
+	const uint64_t now = SDL_GetPerformanceCounter();
+	if (now < frameDeadline) {
+		SleepUntil(frameDeadline);
+		frameDeadline += frameDuration;
+	} else if (now - frameDeadline < frameDuration) {
+		// A little late, the next frame is shortened to get back on the schedule
+		frameDeadline += frameDuration;
+	} else {
+		// More than a frame late, rushing frames out to catch up would only stutter
+		frameDeadline = now + frameDuration;
 	}
-	frameDeadline = tc + v + refreshDelay;
 }
 
 } // namespace
@@ -246,6 +252,8 @@ void RenderPresent()
 		}
 		LimitFrameRate();
 	}
+
+	RecordFramePresented();
 }
 
 void PaletteGetEntries(int dwNumEntries, SDL_Color *lpEntries)
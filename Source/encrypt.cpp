@@ -99,6 +99,28 @@ uint32_t Hash(const char *s, int type)
 	return seed1;
 }
 
+const size_t PkwareWorkBufferSize = CMP_BUFFER_SIZE;
+
+uint32_t PkwareCompress(const std::byte *srcData, uint32_t size, std::byte *destData, char *workBuffer)
+{
+	TDataInfo param;
+	param.srcData = const_cast<std::byte *>(srcData);
+	param.srcOffset = 0;
+	param.destData = destData;
+	param.destOffset = 0;
+	param.size = size;
+
+	unsigned type = 0;
+	unsigned dsize = 4096;
+	implode(PkwareBufferRead, PkwareBufferWrite, workBuffer, &param, &type, &dsize);
+
+	if (param.destOffset < size)
+		return param.destOffset;
+
+	memcpy(destData, srcData, size);
+	return size;
+}
+
 uint32_t PkwareCompress(std::byte *srcData, uint32_t size)
 {
 	std::unique_ptr<char[]> ptr { new char[CMP_BUFFER_SIZE] };
@@ -109,21 +131,8 @@ uint32_t PkwareCompress(std::byte *srcData, uint32_t size)
 
 	std::unique_ptr<std::byte[]> destData { new std::byte[destSize] };
 
-	TDataInfo param;
-	param.srcData = srcData;
-	param.srcOffset = 0;
-	param.destData = destData.get();
-	param.destOffset = 0;
-	param.size = size;
-
-	unsigned type = 0;
-	unsigned dsize = 4096;
-	implode(PkwareBufferRead, PkwareBufferWrite, ptr.get(), &param, &type, &dsize);
-
-	if (param.destOffset < size) {
-		memcpy(srcData, destData.get(), param.destOffset);
-		size = param.destOffset;
-	}
+	size = PkwareCompress(srcData, size, destData.get(), ptr.get());
+	memcpy(srcData, destData.get(), size);
 
 	return size;
 }
@@ -5,6 +5,7 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace devilution {
@@ -20,6 +21,19 @@ struct TDataInfo {
 void Decrypt(uint32_t *castBlock, uint32_t size, uint32_t key);
 void Encrypt(uint32_t *castBlock, uint32_t size, uint32_t key);
 uint32_t Hash(const char *s, int type);
+
+/** Size of the work buffer needed by PkwareCompress */
+extern const size_t PkwareWorkBufferSize;
+
+/**
+ * @brief Compresses data into a separate buffer, leaving the source untouched
+ * @param srcData Data to compress
+ * @param size Number of bytes to compress
+ * @param destData Receives the compressed data, or a copy of the source if it doesn't get smaller. Must hold 2 * max(size, 4096) bytes
+ * @param workBuffer Scratch space of PkwareWorkBufferSize bytes, can be reused between calls
+ * @return Number of bytes written to destData
+ */
+uint32_t PkwareCompress(const std::byte *srcData, uint32_t size, std::byte *destData, char *workBuffer);
 uint32_t PkwareCompress(std::byte *srcData, uint32_t size);
 void PkwareDecompress(std::byte *inBuff, int recvSize, int maxBytes);
 
@@ -12,6 +12,11 @@
 namespace devilution {
 
 int AnimationInfo::GetFrameToUseForRendering() const
+{
+	return GetFrameToUseForRendering(gfProgressToNextGameTick);
+}
+
+int AnimationInfo::GetFrameToUseForRendering(float progressToNextGameTick) const
 {
 	// Normal logic is used,
 	// - if no frame-skipping is required and so we have exactly one Animationframe per game tick
@@ -30,7 +35,7 @@ int AnimationInfo::GetFrameToUseForRendering() const
 	}
 
 	// we don't use the processed game ticks alone but also the fraction of the next game tick (if a rendering happens between game ticks). This helps to smooth the animations.
-	float totalTicksForCurrentAnimationSequence = GetProgressToNextGameTick() + ticksSinceSequenceStarted;
+	float totalTicksForCurrentAnimationSequence = GetProgressToNextGameTick(progressToNextGameTick) + ticksSinceSequenceStarted;
 
 	// 1 added for rounding reasons. float to int cast always truncate.
 	int absoluteAnimationFrame = 1 + (int)(totalTicksForCurrentAnimationSequence * TickModifier);
@@ -57,17 +62,22 @@ int AnimationInfo::GetFrameToUseForRendering() const
 }
 
 float AnimationInfo::GetAnimationProgress() const
+{
+	return GetAnimationProgress(gfProgressToNextGameTick);
+}
+
+float AnimationInfo::GetAnimationProgress(float progressToNextGameTick) const
 {
 	if (RelevantFramesForDistributing <= 0) {
 		// This logic is used if animation distrubtion is not active (see GetFrameToUseForRendering).
 		// In this case the variables calculated with animation distribution are not initialized and we have to calculate them on the fly with the given information.
 		int passedTicks = ((CurrentFrame - 1) * TicksPerFrame) + TickCounterOfCurrentFrame;
-		float totalTicksForCurrentAnimationSequence = GetProgressToNextGameTick() + (float)passedTicks;
+		float totalTicksForCurrentAnimationSequence = GetProgressToNextGameTick(progressToNextGameTick) + (float)passedTicks;
 		float fAnimationFraction = totalTicksForCurrentAnimationSequence / (float)(NumberOfFrames * TicksPerFrame);
 		return fAnimationFraction;
 	}
 
-	float totalTicksForCurrentAnimationSequence = GetProgressToNextGameTick() + TicksSinceSequenceStarted;
+	float totalTicksForCurrentAnimationSequence = GetProgressToNextGameTick(progressToNextGameTick) + TicksSinceSequenceStarted;
 	float fProgressInAnimationFrames = totalTicksForCurrentAnimationSequence * TickModifier;
 	float fAnimationFraction = fProgressInAnimationFrames / NumberOfFrames;
 	return fAnimationFraction;
@@ -203,11 +213,11 @@ void AnimationInfo::ProcessAnimation(bool reverseAnimation /*= false*/, bool don
 	}
 }
 
-float AnimationInfo::GetProgressToNextGameTick() const
+float AnimationInfo::GetProgressToNextGameTick(float progressToNextGameTick) const
 {
 	if (IsPetrified)
 		return 0.0;
-	return gfProgressToNextGameTick;
+	return progressToNextGameTick;
 }
 
 } // namespace devilution
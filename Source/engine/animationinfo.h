@@ -67,11 +67,24 @@ public:
 	 */
 	int GetFrameToUseForRendering() const;
 
+	/**
+	 * @brief Calculates the Frame to use for the Animation rendering at the given point between two game ticks
+	 * @param progressToNextGameTick Progress as a fraction (0.0f to 1.0f) in time to the next game tick
+	 * @return The Frame to use for rendering
+	 */
+	int GetFrameToUseForRendering(float progressToNextGameTick) const;
+
 	/**
 	 * @brief Calculates the progress of the current animation as a fraction (0.0f to 1.0f)
 	*/
 	float GetAnimationProgress() const;
 
+	/**
+	 * @brief Calculates the progress of the current animation as a fraction (0.0f to 1.0f) at the given point between two game ticks
+	 * @param progressToNextGameTick Progress as a fraction (0.0f to 1.0f) in time to the next game tick
+	 */
+	float GetAnimationProgress(float progressToNextGameTick) const;
+
 	/**
 	 * @brief Sets the new Animation with all relevant information for rendering
 	 * @param celSprite Pointer to Animation Sprite
@@ -100,9 +113,9 @@ public:
 
 private:
 	/**
-	 * @brief returns the progress as a fraction (0.0f to 1.0f) in time to the next game tick or 0.0f if the animation is frozen
+	 * @brief returns the given progress as a fraction (0.0f to 1.0f) in time to the next game tick or 0.0f if the animation is frozen
 	 */
-	float GetProgressToNextGameTick() const;
+	float GetProgressToNextGameTick(float progressToNextGameTick) const;
 
 	/**
 	 * @brief Specifies how many animations-fractions are displayed between two game ticks. this can be > 0, if animations are skipped or < 0 if the same animation is shown in multiple times (delay specified).
@@ -25,24 +25,34 @@ uint32_t GetLCGEngineState()
 	return sglGameSeed;
 }
 
-int32_t GetRndSeed()
+uint32_t &GetLCGEngineStateRef()
 {
-	return abs(static_cast<int32_t>(sglGameSeed));
+	return sglGameSeed;
+}
+
+int32_t AdvanceRndSeed(uint32_t &state)
+{
+	state = (RndMult * state) + RndInc;
+	return abs(static_cast<int32_t>(state));
 }
 
 int32_t AdvanceRndSeed()
 {
-	sglGameSeed = (RndMult * sglGameSeed) + RndInc;
-	return GetRndSeed();
+	return AdvanceRndSeed(sglGameSeed);
 }
 
-int32_t GenerateRnd(int32_t v)
+int32_t GenerateRnd(uint32_t &state, int32_t v)
 {
 	if (v <= 0)
 		return 0;
 	if (v < 0xFFFF)
-		return (AdvanceRndSeed() >> 16) % v;
-	return AdvanceRndSeed() % v;
+		return (AdvanceRndSeed(state) >> 16) % v;
+	return AdvanceRndSeed(state) % v;
+}
+
+int32_t GenerateRnd(int32_t v)
+{
+	return GenerateRnd(sglGameSeed, v);
 }
 
 } // namespace devilution
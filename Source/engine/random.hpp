@@ -59,6 +59,34 @@ int32_t AdvanceRndSeed();
  */
 int32_t GenerateRnd(int32_t v);
 
+/**
+ * @brief Returns the state of the RandomNumberEngine used by the base game so it can be advanced in place
+ *
+ * This is used by code that runs vanilla algorithms against an explicit engine state, see GenerateRnd(uint32_t &, int32_t)
+ *
+ * @return The engine state
+ */
+uint32_t &GetLCGEngineStateRef();
+
+/**
+ * @brief Same as AdvanceRndSeed() but advances the given engine state instead of the global one
+ * @param state Engine state to advance
+ * @return A random number in the range [0,2^31) or -2^31
+ */
+int32_t AdvanceRndSeed(uint32_t &state);
+
+/**
+ * @brief Same as GenerateRnd(int32_t) but advances the given engine state instead of the global one
+ *
+ * This lets the base game logic run away from the main thread (e.g. to generate a level in the background) without
+ * disturbing the sequence of the global engine.
+ *
+ * @param state Engine state to advance
+ * @param v The upper limit for the return value
+ * @return A random number in the range [0, v) or rarely a negative value in (-v, -1]
+ */
+int32_t GenerateRnd(uint32_t &state, int32_t v);
+
 /**
  * @brief Picks one of the elements in the list randomly.
  *
@@ -6,9 +6,14 @@
 #include "cl2_render.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <list>
+#include <unordered_map>
+#include <vector>
 
 #include "engine/cel_header.hpp"
 #include "engine/render/common_impl.h"
+#include "gendung.h"
 #include "scrollrt.h"
 #include "utils/attributes.h"
 
@@ -326,6 +331,234 @@ void Cl2BlitLightSafe(const Surface &out, int sx, int sy, const std::byte *pRLEB
 	);
 }
 
+/** Memory the decoded frames of one thread may take up before the least recently drawn ones are dropped */
+constexpr std::size_t Cl2DecodeCacheBudget = 8 * 1024 * 1024;
+
+/**
+ * @brief Bumped by Cl2ClearDecodeCache, the caches of all threads drop their frames once they see it change
+ *
+ * Freed graphics and light tables can be replaced by different ones at the same address, so frames are only ever looked
+ * up by address within one generation.
+ */
+std::atomic<std::uint32_t> DecodeCacheGeneration;
+
+/** A horizontal run of opaque pixels in a decoded frame */
+struct Cl2Span {
+	std::int16_t x;
+	std::int16_t width;
+	/** Position of the first pixel in DecodedCl2Frame::pixels */
+	std::uint32_t pixels;
+};
+
+/**
+ * @brief A CL2 frame with the light table already applied, stored as runs of opaque pixels per row
+ */
+struct DecodedCl2Frame {
+	const std::byte *src;
+	std::size_t srcSize;
+	const std::uint8_t *lightTable;
+	int width;
+	/** False if the frame can't be drawn from spans, it is then always drawn from the CL2 data */
+	bool usable;
+	/** The spans of row y, counting up from the bottom row, are [rowStarts[y], rowStarts[y + 1]) */
+	std::vector<std::uint32_t> rowStarts;
+	std::vector<Cl2Span> spans;
+	std::vector<std::uint8_t> pixels;
+
+	[[nodiscard]] std::size_t MemoryUsage() const
+	{
+		return sizeof(*this) + rowStarts.size() * sizeof(std::uint32_t) + spans.size() * sizeof(Cl2Span) + pixels.size();
+	}
+};
+
+/**
+ * @brief Splits a CL2 frame into spans, merging runs that touch
+ * @return false if an opaque run crosses the end of a row
+ */
+bool DecodeCl2Frame(const std::byte *src, std::size_t srcSize, DecodedCl2Frame &decoded)
+{
+	const auto *srcEnd = src + srcSize;
+	const int width = decoded.width;
+	const std::uint8_t *lightTable = decoded.lightTable;
+
+	int x = 0;
+	decoded.rowStarts.push_back(0);
+	while (src < srcEnd) {
+		auto v = static_cast<std::uint8_t>(*src++);
+		if (IsCl2Opaque(v)) {
+			const bool fill = IsCl2OpaqueFill(v);
+			v = fill ? GetCl2OpaqueFillWidth(v) : GetCl2OpaquePixelsWidth(v);
+			if (x + v > width)
+				return false;
+
+			const auto pixels = static_cast<std::uint32_t>(decoded.pixels.size());
+			if (fill) {
+				decoded.pixels.insert(decoded.pixels.end(), v, lightTable[static_cast<std::uint8_t>(*src++)]);
+			} else {
+				for (int i = 0; i < v; i++)
+					decoded.pixels.push_back(lightTable[static_cast<std::uint8_t>(src[i])]);
+				src += v;
+			}
+
+			if (decoded.spans.size() > decoded.rowStarts.back() && decoded.spans.back().x + decoded.spans.back().width == x) {
+				decoded.spans.back().width += v;
+			} else {
+				decoded.spans.push_back({ static_cast<std::int16_t>(x), static_cast<std::int16_t>(v), pixels });
+			}
+		}
+		x += v;
+		while (x >= width) {
+			x -= width;
+			decoded.rowStarts.push_back(static_cast<std::uint32_t>(decoded.spans.size()));
+		}
+	}
+	if (x != 0)
+		decoded.rowStarts.push_back(static_cast<std::uint32_t>(decoded.spans.size()));
+
+	return true;
+}
+
+/**
+ * @brief Keeps the most recently drawn lit frames around so they don't have to be decoded and lit again
+ *
+ * Each thread that draws has its own cache.
+ */
+class Cl2DecodeCache {
+public:
+	/**
+	 * @brief Returns the decoded frame, decoding it if it isn't cached
+	 * @return nullptr if the frame has to be drawn from the CL2 data
+	 */
+	const DecodedCl2Frame *Get(const std::byte *src, std::size_t srcSize, int width, const std::uint8_t *lightTable)
+	{
+		const std::uint32_t generation = DecodeCacheGeneration.load(std::memory_order_acquire);
+		if (generation != generation_) {
+			Clear();
+			generation_ = generation;
+		}
+
+		const Key key { src, srcSize, lightTable };
+		auto cached = index_.find(key);
+		if (cached != index_.end()) {
+			auto entry = cached->second;
+			if (entry->width == width) {
+				frames_.splice(frames_.begin(), frames_, entry);
+				return entry->usable ? &*entry : nullptr;
+			}
+			Remove(entry);
+		}
+
+		frames_.push_front({ src, srcSize, lightTable, width, false, {}, {}, {} });
+		DecodedCl2Frame &decoded = frames_.front();
+		decoded.usable = DecodeCl2Frame(src, srcSize, decoded);
+		if (!decoded.usable) {
+			decoded.rowStarts = {};
+			decoded.spans = {};
+			decoded.pixels = {};
+		}
+		index_.emplace(key, frames_.begin());
+		memoryUsage_ += decoded.MemoryUsage();
+
+		while (memoryUsage_ > Cl2DecodeCacheBudget && frames_.size() > 1)
+			Remove(std::prev(frames_.end()));
+
+		return decoded.usable ? &decoded : nullptr;
+	}
+
+	void Clear()
+	{
+		frames_.clear();
+		index_.clear();
+		memoryUsage_ = 0;
+	}
+
+private:
+	struct Key {
+		const std::byte *src;
+		std::size_t srcSize;
+		const std::uint8_t *lightTable;
+
+		bool operator==(const Key &other) const
+		{
+			return src == other.src && srcSize == other.srcSize && lightTable == other.lightTable;
+		}
+	};
+
+	struct KeyHash {
+		std::size_t operator()(const Key &key) const
+		{
+			return std::hash<const void *>()(key.src) ^ (std::hash<const void *>()(key.lightTable) << 1);
+		}
+	};
+
+	/** Most recently drawn first */
+	std::list<DecodedCl2Frame> frames_;
+	std::unordered_map<Key, std::list<DecodedCl2Frame>::iterator, KeyHash> index_;
+	std::size_t memoryUsage_ = 0;
+	/** Value of DecodeCacheGeneration the cached frames were decoded in */
+	std::uint32_t generation_ = 0;
+
+	void Remove(std::list<DecodedCl2Frame>::iterator entry)
+	{
+		memoryUsage_ -= entry->MemoryUsage();
+		index_.erase({ entry->src, entry->srcSize, entry->lightTable });
+		frames_.erase(entry);
+	}
+};
+
+thread_local Cl2DecodeCache DecodeCache;
+
+/**
+ * @brief Blit a decoded frame to the given buffer, giving the same result as drawing the CL2 data
+ * @param out Target buffer
+ * @param position Target buffer coordinate of the bottom left corner
+ * @param decoded Frame to draw
+ */
+void RenderDecodedCl2(const Surface &out, Point position, const DecodedCl2Frame &decoded)
+{
+	const ClipX clipX = CalculateClipX(position.x, decoded.width, out);
+	if (clipX.width <= 0)
+		return;
+
+	const int left = static_cast<int>(clipX.left);
+	const int right = decoded.width - static_cast<int>(clipX.right);
+	const int rowCount = static_cast<int>(decoded.rowStarts.size()) - 1;
+	const int firstRow = std::max(position.y - (out.h() - 1), 0);
+	const int lastRow = std::min(position.y, rowCount - 1);
+	for (int row = firstRow; row <= lastRow; row++) {
+		std::uint8_t *dst = &out[{ position.x + left, position.y - row }];
+		for (std::uint32_t i = decoded.rowStarts[row]; i < decoded.rowStarts[row + 1]; i++) {
+			const Cl2Span &span = decoded.spans[i];
+			const int begin = std::max<int>(span.x, left);
+			const int end = std::min<int>(span.x + span.width, right);
+			if (begin < end)
+				std::memcpy(dst + (begin - left), &decoded.pixels[span.pixels + (begin - span.x)], end - begin);
+		}
+	}
+}
+
+/**
+ * @brief Blit CL2 sprite with a light table through the decode cache
+ * @param out Target buffer
+ * @param sx Target buffer coordinate
+ * @param sy Target buffer coordinate
+ * @param pRLEBytes CL2 pixel stream (run-length encoded)
+ * @param nDataSize Size of CL2 in bytes
+ * @param nWidth With of CL2 sprite
+ * @param pTable Light color table
+ */
+void Cl2BlitLightCached(const Surface &out, int sx, int sy, const std::byte *pRLEBytes, int nDataSize, int nWidth, uint8_t *pTable)
+{
+#ifndef DEBUG_RENDER_COLOR
+	const DecodedCl2Frame *decoded = DecodeCache.Get(pRLEBytes, nDataSize, nWidth, pTable);
+	if (decoded != nullptr) {
+		RenderDecodedCl2(out, { sx, sy }, *decoded);
+		return;
+	}
+#endif
+	Cl2BlitLightSafe(out, sx, sy, pRLEBytes, nDataSize, nWidth, pTable);
+}
+
 template <bool North, bool West, bool South, bool East>
 void RenderOutlineForPixel(std::uint8_t *dst, int dstPitch, std::uint8_t color)
 {
@@ -730,10 +963,17 @@ void RenderCl2Outline(const Surface &out, Point position, const std::byte *src,
 
 } // namespace
 
+void Cl2ClearDecodeCache()
+{
+	DecodeCacheGeneration.fetch_add(1, std::memory_order_release);
+}
+
 void Cl2ApplyTrans(std::byte *p, const std::array<uint8_t, 256> &ttbl, int nCel)
 {
 	assert(p != nullptr);
 
+	Cl2ClearDecodeCache();
+
 	for (int i = 1; i <= nCel; i++) {
 		constexpr int FrameHeaderSize = 10;
 		int nDataSize;
@@ -789,7 +1029,7 @@ void Cl2DrawLightTbl(const Surface &out, int sx, int sy, const CelSprite &cel, i
 
 	int nDataSize;
 	const std::byte *pRLEBytes = CelGetFrameClipped(cel.Data(), frame, &nDataSize);
-	Cl2BlitLightSafe(out, sx, sy, pRLEBytes, nDataSize, cel.Width(frame), GetLightTable(light));
+	Cl2BlitLightCached(out, sx, sy, pRLEBytes, nDataSize, cel.Width(frame), GetLightTable(light));
 }
 
 void Cl2DrawLight(const Surface &out, int sx, int sy, const CelSprite &cel, int frame)
@@ -799,8 +1039,11 @@ void Cl2DrawLight(const Surface &out, int sx, int sy, const CelSprite &cel, int
 	int nDataSize;
 	const std::byte *pRLEBytes = CelGetFrameClipped(cel.Data(), frame, &nDataSize);
 
-	if (LightTableIndex != 0)
+	// The light tables of hell levels are color cycled every game tick, so caching them would not pay off
+	if (LightTableIndex != 0 && leveltype == DTYPE_HELL)
 		Cl2BlitLightSafe(out, sx, sy, pRLEBytes, nDataSize, cel.Width(frame), &LightTables[LightTableIndex * 256]);
+	else if (LightTableIndex != 0)
+		Cl2BlitLightCached(out, sx, sy, pRLEBytes, nDataSize, cel.Width(frame), &LightTables[LightTableIndex * 256]);
 	else
 		Cl2BlitSafe(out, sx, sy, pRLEBytes, nDataSize, cel.Width(frame));
 }
@@ -14,6 +14,14 @@
 
 namespace devilution {
 
+/**
+ * @brief Drop all frames kept by the decode caches of the lit CL2 drawing functions
+ *
+ * Has to be called when CL2 data that has been drawn is freed or the light tables change. Every thread that draws
+ * drops its frames the next time it draws a lit CL2 frame.
+ */
+void Cl2ClearDecodeCache();
+
 /**
  * @brief Apply the color swaps to a CL2 sprite
  * @param p CL2 buffer
@@ -6,8 +6,8 @@ namespace devilution {
 
 namespace {
 
-template <bool SkipColorIndexZero>
-void SurfaceBlit(const Surface &src, SDL_Rect srcRect, const Surface &dst, Point dstPosition)
+template <bool SkipColorIndex>
+void SurfaceBlit(const Surface &src, SDL_Rect srcRect, const Surface &dst, Point dstPosition, std::uint8_t skipColorIndex = 0)
 {
 	// We do not use `SDL_BlitSurface` here because the palettes may be different objects
 	// and SDL would attempt to map them.
@@ -22,9 +22,9 @@ void SurfaceBlit(const Surface &src, SDL_Rect srcRect, const Surface &dst, Point
 	const auto dstPitch = dst.pitch();
 
 	for (unsigned h = srcRect.h; h != 0; --h) {
-		if (SkipColorIndexZero) {
+		if (SkipColorIndex) {
 			for (unsigned w = srcRect.w; w != 0; --w) {
-				if (*srcBuf != 0)
+				if (*srcBuf != skipColorIndex)
 					*dstBuf = *srcBuf;
 				++srcBuf, ++dstBuf;
 			}
@@ -42,12 +42,17 @@ void SurfaceBlit(const Surface &src, SDL_Rect srcRect, const Surface &dst, Point
 
 void Surface::BlitFrom(const Surface &src, SDL_Rect srcRect, Point targetPosition) const
 {
-	SurfaceBlit</*SkipColorIndexZero=*/false>(src, srcRect, *this, targetPosition);
+	SurfaceBlit</*SkipColorIndex=*/false>(src, srcRect, *this, targetPosition);
 }
 
 void Surface::BlitFromSkipColorIndexZero(const Surface &src, SDL_Rect srcRect, Point targetPosition) const
 {
-	SurfaceBlit</*SkipColorIndexZero=*/true>(src, srcRect, *this, targetPosition);
+	SurfaceBlit</*SkipColorIndex=*/true>(src, srcRect, *this, targetPosition);
+}
+
+void Surface::BlitFromSkipColorIndex(const Surface &src, SDL_Rect srcRect, Point targetPosition, std::uint8_t skipColorIndex) const
+{
+	SurfaceBlit</*SkipColorIndex=*/true>(src, srcRect, *this, targetPosition, skipColorIndex);
 }
 
 } // namespace devilution
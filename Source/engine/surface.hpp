@@ -147,6 +147,12 @@ struct Surface {
 	 * Source pixels with index 0 are not copied.
 	 */
 	void BlitFromSkipColorIndexZero(const Surface &src, SDL_Rect srcRect, Point targetPosition) const;
+
+	/**
+	 * @brief Copies the `srcRect` portion of the given buffer to this buffer at `targetPosition`.
+	 * Source pixels with index `skipColorIndex` are not copied.
+	 */
+	void BlitFromSkipColorIndex(const Surface &src, SDL_Rect srcRect, Point targetPosition, std::uint8_t skipColorIndex) const;
 };
 
 class OwnedSurface : public Surface {
@@ -5,11 +5,15 @@
  */
 #include "gendung.h"
 
+#include "diablo.h"
+#include "drlg_l1.h"
 #include "engine/load_file.hpp"
 #include "engine/random.hpp"
 #include "init.h"
 #include "lighting.h"
+#include "monster.h"
 #include "options.h"
+#include "quests.h"
 
 namespace devilution {
 
@@ -20,8 +24,6 @@ int setpc_x;
 int setpc_y;
 int setpc_w;
 int setpc_h;
-std::unique_ptr<uint16_t[]> pSetPiece;
-bool setloadflag;
 std::optional<CelSprite> pSpecialCels;
 std::unique_ptr<MegaTile[]> pMegaTiles;
 std::unique_ptr<uint16_t[]> pLevelPieces;
@@ -53,14 +55,17 @@ int8_t dFlags[MAXDUNX][MAXDUNY];
 int8_t dPlayer[MAXDUNX][MAXDUNY];
 int16_t dMonster[MAXDUNX][MAXDUNY];
 int8_t dCorpse[MAXDUNX][MAXDUNY];
-char dObject[MAXDUNX][MAXDUNY];
-int8_t dItem[MAXDUNX][MAXDUNY];
+int16_t dObject[MAXDUNX][MAXDUNY];
+int16_t dItem[MAXDUNX][MAXDUNY];
 char dSpecial[MAXDUNX][MAXDUNY];
 int themeCount;
 THEME_LOC themeLoc[MAXTHEMES];
 
 namespace {
 
+/** Attempt counter of the active level, only kept for the sake of LevelGenerationContext */
+int LiveLayoutAttempts;
+
 std::unique_ptr<uint8_t[]> LoadLevelSOLData(size_t &tileCount)
 {
 	switch (leveltype) {
@@ -83,7 +88,9 @@ std::unique_ptr<uint8_t[]> LoadLevelSOLData(size_t &tileCount)
 	}
 }
 
-bool WillThemeRoomFit(int floor, int x, int y, int minSize, int maxSize, int *width, int *height)
+} // namespace
+
+bool LevelGenerationContext::WillThemeRoomFit(int floor, int x, int y, int minSize, int maxSize, int *width, int *height)
 {
 	bool yFlag = true;
 	bool xFlag = true;
@@ -164,7 +171,7 @@ bool WillThemeRoomFit(int floor, int x, int y, int minSize, int maxSize, int *wi
 	return true;
 }
 
-void CreateThemeRoom(int themeIndex)
+void LevelGenerationContext::CreateThemeRoom(int themeIndex)
 {
 	const int lx = themeLoc[themeIndex].x;
 	const int ly = themeLoc[themeIndex].y;
@@ -263,7 +270,7 @@ void CreateThemeRoom(int themeIndex)
 	}
 }
 
-void FindTransparencyValues(int i, int j, int x, int y, int d, uint8_t floorID)
+void LevelGenerationContext::FindTransparencyValues(int i, int j, int x, int y, int d, uint8_t floorID)
 {
 	if (dTransVal[x][y] != 0 || dungeon[i][j] != floorID) {
 		if (d == 1) {
@@ -311,8 +318,6 @@ void FindTransparencyValues(int i, int j, int x, int y, int d, uint8_t floorID)
 	FindTransparencyValues(i + 1, j + 1, x + 2, y + 2, 8, floorID);
 }
 
-} // namespace
-
 void FillSolidBlockTbls()
 {
 	size_t tileCount;
@@ -331,6 +336,8 @@ void FillSolidBlockTbls()
 
 void SetDungeonMicros()
 {
+	InvalidateLineOfSightCache();
+
 	MicroTileLen = 10;
 	int blocks = 10;
 
@@ -359,14 +366,122 @@ void SetDungeonMicros()
 	}
 }
 
-void DRLG_InitTrans()
+LevelGenerationContext::LevelGenerationContext()
+    : dungeon(devilution::dungeon)
+    , pdungeon(devilution::pdungeon)
+    , dflags(devilution::dflags)
+    , setpc_x(devilution::setpc_x)
+    , setpc_y(devilution::setpc_y)
+    , setpc_w(devilution::setpc_w)
+    , setpc_h(devilution::setpc_h)
+    , dminPosition(devilution::dminPosition)
+    , dmaxPosition(devilution::dmaxPosition)
+    , ViewPosition(devilution::ViewPosition)
+    , TransVal(devilution::TransVal)
+    , TransList(devilution::TransList)
+    , dPiece(devilution::dPiece)
+    , dTransVal(devilution::dTransVal)
+    , dLight(devilution::dLight)
+    , dFlags(devilution::dFlags)
+    , dSpecial(devilution::dSpecial)
+    , themeCount(devilution::themeCount)
+    , themeLoc(devilution::themeLoc)
+    , UberRow(devilution::UberRow)
+    , UberCol(devilution::UberCol)
+    , currlevel(devilution::currlevel)
+    , leveltype(devilution::leveltype)
+    , glSeedTbl(devilution::glSeedTbl)
+    , pMegaTiles(devilution::pMegaTiles.get())
+    , layoutAttempts(LiveLayoutAttempts)
+    , rngState_(GetLCGEngineStateRef())
+    , disableLighting_(DisableLighting)
+    , live_(true)
+{
+}
+
+LevelGenerationContext::LevelGenerationContext(LevelGenerationBuffers &buffers)
+    : dungeon(buffers.dungeon)
+    , pdungeon(buffers.pdungeon)
+    , dflags(buffers.dflags)
+    , setpc_x(buffers.setpc_x)
+    , setpc_y(buffers.setpc_y)
+    , setpc_w(buffers.setpc_w)
+    , setpc_h(buffers.setpc_h)
+    , dminPosition(buffers.dminPosition)
+    , dmaxPosition(buffers.dmaxPosition)
+    , ViewPosition(buffers.ViewPosition)
+    , TransVal(buffers.TransVal)
+    , TransList(buffers.TransList)
+    , dPiece(buffers.dPiece)
+    , dTransVal(buffers.dTransVal)
+    , dLight(buffers.dLight)
+    , dFlags(buffers.dFlags)
+    , dSpecial(buffers.dSpecial)
+    , themeCount(buffers.themeCount)
+    , themeLoc(buffers.themeLoc)
+    , UberRow(buffers.UberRow)
+    , UberCol(buffers.UberCol)
+    , currlevel(buffers.currlevel)
+    , leveltype(buffers.leveltype)
+    , glSeedTbl(buffers.glSeedTbl)
+    , pMegaTiles(buffers.megaTiles.get())
+    , layoutAttempts(buffers.layoutAttempts)
+    , rngState_(buffers.rngState)
+    , disableLighting_(buffers.disableLighting)
+    , live_(false)
+{
+}
+
+void LevelGenerationContext::SetRndSeed(uint32_t seed)
+{
+	rngState_ = seed;
+}
+
+int32_t LevelGenerationContext::AdvanceRndSeed()
+{
+	return devilution::AdvanceRndSeed(rngState_);
+}
+
+int32_t LevelGenerationContext::GenerateRnd(int32_t v)
+{
+	return devilution::GenerateRnd(rngState_, v);
+}
+
+bool LevelGenerationContext::IsQuestAvailable(quest_id id) const
+{
+	if (!live_)
+		return false;
+
+	return Quests[id].IsAvailable();
+}
+
+quest_state LevelGenerationContext::GetQuestState(quest_id id) const
+{
+	if (!live_)
+		return QUEST_NOTAVAIL;
+
+	return Quests[id]._qactive;
+}
+
+void LevelGenerationContext::DRLG_CheckQuests(int x, int y)
+{
+	if (live_)
+		devilution::DRLG_CheckQuests(x, y);
+}
+
+void LevelGenerationContext::DRLG_InitTrans()
 {
 	memset(dTransVal, 0, sizeof(dTransVal));
 	memset(TransList, 0, sizeof(TransList));
 	TransVal = 1;
 }
 
-void DRLG_MRectTrans(int x1, int y1, int x2, int y2)
+void DRLG_InitTrans()
+{
+	LevelGenerationContext().DRLG_InitTrans();
+}
+
+void LevelGenerationContext::DRLG_MRectTrans(int x1, int y1, int x2, int y2)
 {
 	x1 = 2 * x1 + 17;
 	y1 = 2 * y1 + 17;
@@ -382,7 +497,12 @@ void DRLG_MRectTrans(int x1, int y1, int x2, int y2)
 	TransVal++;
 }
 
-void DRLG_RectTrans(int x1, int y1, int x2, int y2)
+void DRLG_MRectTrans(int x1, int y1, int x2, int y2)
+{
+	LevelGenerationContext().DRLG_MRectTrans(x1, y1, x2, y2);
+}
+
+void LevelGenerationContext::DRLG_RectTrans(int x1, int y1, int x2, int y2)
 {
 	for (int j = y1; j <= y2; j++) {
 		for (int i = x1; i <= x2; i++) {
@@ -392,7 +512,12 @@ void DRLG_RectTrans(int x1, int y1, int x2, int y2)
 	TransVal++;
 }
 
-void DRLG_CopyTrans(int sx, int sy, int dx, int dy)
+void DRLG_RectTrans(int x1, int y1, int x2, int y2)
+{
+	LevelGenerationContext().DRLG_RectTrans(x1, y1, x2, y2);
+}
+
+void LevelGenerationContext::DRLG_CopyTrans(int sx, int sy, int dx, int dy)
 {
 	dTransVal[dx][dy] = dTransVal[sx][sy];
 }
@@ -421,7 +546,7 @@ void DRLG_AreaTrans(int num, BYTE *list)
 	TransVal++;
 }
 
-void DRLG_InitSetPC()
+void LevelGenerationContext::DRLG_InitSetPC()
 {
 	setpc_x = 0;
 	setpc_y = 0;
@@ -429,7 +554,7 @@ void DRLG_InitSetPC()
 	setpc_h = 0;
 }
 
-void DRLG_SetPC()
+void LevelGenerationContext::DRLG_SetPC()
 {
 	int w = 2 * setpc_w;
 	int h = 2 * setpc_h;
@@ -443,7 +568,7 @@ void DRLG_SetPC()
 	}
 }
 
-void Make_SetPC(int x, int y, int w, int h)
+void LevelGenerationContext::Make_SetPC(int x, int y, int w, int h)
 {
 	int dw = 2 * w;
 	int dh = 2 * h;
@@ -457,7 +582,7 @@ void Make_SetPC(int x, int y, int w, int h)
 	}
 }
 
-void DRLG_PlaceThemeRooms(int minSize, int maxSize, int floor, int freq, bool rndSize)
+void LevelGenerationContext::DRLG_PlaceThemeRooms(int minSize, int maxSize, int floor, int freq, bool rndSize)
 {
 	themeCount = 0;
 	memset(themeLoc, 0, sizeof(*themeLoc));
@@ -508,7 +633,7 @@ void DRLG_HoldThemeRooms()
 	}
 }
 
-void DRLG_LPass3(int lv)
+void LevelGenerationContext::DRLG_LPass3(int lv)
 {
 	{
 		MegaTile mega = pMegaTiles[lv];
@@ -554,20 +679,27 @@ void DRLG_LPass3(int lv)
 	}
 }
 
-void DRLG_Init_Globals()
+void LevelGenerationContext::DRLG_Init_Globals()
 {
 	memset(dFlags, 0, sizeof(dFlags));
-	memset(dPlayer, 0, sizeof(dPlayer));
-	memset(dMonster, 0, sizeof(dMonster));
-	memset(dCorpse, 0, sizeof(dCorpse));
-	memset(dObject, 0, sizeof(dObject));
-	memset(dItem, 0, sizeof(dItem));
+	if (live_) {
+		memset(devilution::dPlayer, 0, sizeof(devilution::dPlayer));
+		memset(devilution::dMonster, 0, sizeof(devilution::dMonster));
+		memset(devilution::dCorpse, 0, sizeof(devilution::dCorpse));
+		memset(devilution::dObject, 0, sizeof(devilution::dObject));
+		memset(devilution::dItem, 0, sizeof(devilution::dItem));
+	}
 	memset(dSpecial, 0, sizeof(dSpecial));
-	int8_t c = DisableLighting ? 0 : 15;
+	int8_t c = disableLighting_ ? 0 : 15;
 	memset(dLight, c, sizeof(dLight));
 }
 
-bool SkipThemeRoom(int x, int y)
+void DRLG_Init_Globals()
+{
+	LevelGenerationContext().DRLG_Init_Globals();
+}
+
+bool LevelGenerationContext::SkipThemeRoom(int x, int y)
 {
 	for (int i = 0; i < themeCount; i++) {
 		if (x >= themeLoc[i].x - 2 && x <= themeLoc[i].x + themeLoc[i].width + 2
@@ -578,6 +710,11 @@ bool SkipThemeRoom(int x, int y)
 	return true;
 }
 
+bool SkipThemeRoom(int x, int y)
+{
+	return LevelGenerationContext().SkipThemeRoom(x, y);
+}
+
 void InitLevels()
 {
 	currlevel = 0;
@@ -585,7 +722,23 @@ void InitLevels()
 	setlevel = false;
 }
 
-void FloodTransparencyValues(uint8_t floorID)
+const char *GetMegaTilesPath(dungeon_type levelType, int level)
+{
+	switch (levelType) {
+	case DTYPE_CATHEDRAL:
+		return level < 21 ? "Levels\\L1Data\\L1.TIL" : "NLevels\\L5Data\\L5.TIL";
+	case DTYPE_CATACOMBS:
+		return "Levels\\L2Data\\L2.TIL";
+	case DTYPE_CAVES:
+		return level < 17 ? "Levels\\L3Data\\L3.TIL" : "NLevels\\L6Data\\L6.TIL";
+	case DTYPE_HELL:
+		return "Levels\\L4Data\\L4.TIL";
+	default:
+		return nullptr;
+	}
+}
+
+void LevelGenerationContext::FloodTransparencyValues(uint8_t floorID)
 {
 	int yy = 16;
 	for (int j = 0; j < DMAXY; j++) {
@@ -22,6 +22,8 @@ namespace devilution {
 #define MAXDUNX (16 + DMAXX * 2 + 16)
 #define MAXDUNY (16 + DMAXY * 2 + 16)
 
+#define NUMLEVELS 25
+
 #define MAXTHEMES 50
 #define MAXTILES 2048
 
@@ -129,10 +131,6 @@ extern int setpc_y;
 extern int setpc_w;
 /** Specifies the height of the active set level of the map. */
 extern int setpc_h;
-/** Contains the contents of the single player quest DUN file. */
-extern std::unique_ptr<uint16_t[]> pSetPiece;
-/** Specifies whether a single player quest DUN has been loaded. */
-extern bool setloadflag;
 extern std::optional<CelSprite> pSpecialCels;
 /** Specifies the tile definitions of the active dungeon type; (e.g. levels/l1data/l1.til). */
 extern std::unique_ptr<MegaTile[]> pMegaTiles;
@@ -204,9 +202,9 @@ extern int16_t dMonster[MAXDUNX][MAXDUNY];
  */
 extern int8_t dCorpse[MAXDUNX][MAXDUNY];
 /** Contains the object numbers (objects array indices) of the map. */
-extern char dObject[MAXDUNX][MAXDUNY];
+extern int16_t dObject[MAXDUNX][MAXDUNY];
 /** Contains the item numbers (items array indices) of the map. */
-extern int8_t dItem[MAXDUNX][MAXDUNY];
+extern int16_t dItem[MAXDUNX][MAXDUNY];
 /**
  * Contains the arch frame numbers of the map from the special tileset
  * (e.g. "levels/l1data/l1s.cel"). Note, the special tileset of Tristram (i.e.
@@ -216,23 +214,150 @@ extern char dSpecial[MAXDUNX][MAXDUNY];
 extern int themeCount;
 extern THEME_LOC themeLoc[MAXTHEMES];
 
+enum quest_id : int8_t;
+enum quest_state : uint8_t;
+
+/**
+ * @brief Backing storage for a level that is generated next to the active one.
+ *
+ * Mirrors the subset of the level globals written by the random level generators.
+ */
+struct LevelGenerationBuffers {
+	uint8_t dungeon[DMAXX][DMAXY];
+	uint8_t pdungeon[DMAXX][DMAXY];
+	uint8_t dflags[DMAXX][DMAXY];
+	int setpc_x;
+	int setpc_y;
+	int setpc_w;
+	int setpc_h;
+	Point dminPosition;
+	Point dmaxPosition;
+	Point ViewPosition;
+	char TransVal;
+	bool TransList[256];
+	int dPiece[MAXDUNX][MAXDUNY];
+	int8_t dTransVal[MAXDUNX][MAXDUNY];
+	char dLight[MAXDUNX][MAXDUNY];
+	int8_t dFlags[MAXDUNX][MAXDUNY];
+	char dSpecial[MAXDUNX][MAXDUNY];
+	int themeCount;
+	THEME_LOC themeLoc[MAXTHEMES];
+	int UberRow;
+	int UberCol;
+	BYTE currlevel;
+	dungeon_type leveltype;
+	/** Seeds of the dungeon levels, catacomb levels 7 and 8 replay the layouts of the levels above them */
+	uint32_t glSeedTbl[NUMLEVELS];
+	/** State of the vanilla RNG, see GenerateRnd() */
+	uint32_t rngState;
+	/** Tile definitions of the level type, these have to be loaded up front as file access is not thread safe. */
+	std::unique_ptr<MegaTile[]> megaTiles;
+	bool disableLighting;
+	/** Number of times the generator started over on a new layout */
+	int layoutAttempts;
+};
+
+/**
+ * @brief The level state used by the random level generators.
+ *
+ * The members carry the names of the globals they stand in for so generator code reads the same whether it runs
+ * against the active level or against a LevelGenerationBuffers.
+ */
+class LevelGenerationContext {
+public:
+	/** @brief Binds the context to the globals of the active level. */
+	LevelGenerationContext();
+	/** @brief Binds the context to the given buffers, the active level is left untouched. */
+	explicit LevelGenerationContext(LevelGenerationBuffers &buffers);
+
+	/** @return Whether this context writes to the globals of the active level */
+	bool IsLive() const
+	{
+		return live_;
+	}
+
+	void SetRndSeed(uint32_t seed);
+	int32_t AdvanceRndSeed();
+	int32_t GenerateRnd(int32_t v);
+
+	/**
+	 * @brief Same as Quest::IsAvailable() for the level being generated.
+	 *
+	 * Levels are only generated into buffers when no quest can show up on them, so this is always false there.
+	 */
+	bool IsQuestAvailable(quest_id id) const;
+	/** @brief Returns the state of the given quest, QUEST_NOTAVAIL when generating into buffers. */
+	quest_state GetQuestState(quest_id id) const;
+	/** @brief Places the quest set pieces, only relevant to the active level. */
+	void DRLG_CheckQuests(int x, int y);
+
+	void DRLG_InitTrans();
+	void DRLG_MRectTrans(int x1, int y1, int x2, int y2);
+	void DRLG_RectTrans(int x1, int y1, int x2, int y2);
+	void DRLG_CopyTrans(int sx, int sy, int dx, int dy);
+	void DRLG_InitSetPC();
+	void DRLG_SetPC();
+	void Make_SetPC(int x, int y, int w, int h);
+	void DRLG_PlaceThemeRooms(int minSize, int maxSize, int floor, int freq, bool rndSize);
+	void DRLG_LPass3(int lv);
+	/** @brief Resets the per tile flags, the entity maps of the active level are only cleared by live contexts. */
+	void DRLG_Init_Globals();
+	bool SkipThemeRoom(int x, int y);
+	void FloodTransparencyValues(uint8_t floorID);
+
+	uint8_t (&dungeon)[DMAXX][DMAXY];
+	uint8_t (&pdungeon)[DMAXX][DMAXY];
+	uint8_t (&dflags)[DMAXX][DMAXY];
+	int &setpc_x;
+	int &setpc_y;
+	int &setpc_w;
+	int &setpc_h;
+	Point &dminPosition;
+	Point &dmaxPosition;
+	Point &ViewPosition;
+	char &TransVal;
+	bool (&TransList)[256];
+	int (&dPiece)[MAXDUNX][MAXDUNY];
+	int8_t (&dTransVal)[MAXDUNX][MAXDUNY];
+	char (&dLight)[MAXDUNX][MAXDUNY];
+	int8_t (&dFlags)[MAXDUNX][MAXDUNY];
+	char (&dSpecial)[MAXDUNX][MAXDUNY];
+	int &themeCount;
+	THEME_LOC (&themeLoc)[MAXTHEMES];
+	int &UberRow;
+	int &UberCol;
+	BYTE &currlevel;
+	dungeon_type &leveltype;
+	uint32_t (&glSeedTbl)[NUMLEVELS];
+	const MegaTile *pMegaTiles;
+	int &layoutAttempts;
+
+private:
+	bool WillThemeRoomFit(int floor, int x, int y, int minSize, int maxSize, int *width, int *height);
+	void CreateThemeRoom(int themeIndex);
+	void FindTransparencyValues(int i, int j, int x, int y, int d, uint8_t floorID);
+
+	uint32_t &rngState_;
+	bool disableLighting_;
+	bool live_;
+};
+
 void FillSolidBlockTbls();
 void SetDungeonMicros();
 void DRLG_InitTrans();
 void DRLG_MRectTrans(int x1, int y1, int x2, int y2);
 void DRLG_RectTrans(int x1, int y1, int x2, int y2);
-void DRLG_CopyTrans(int sx, int sy, int dx, int dy);
 void DRLG_ListTrans(int num, BYTE *List);
 void DRLG_AreaTrans(int num, BYTE *List);
-void DRLG_InitSetPC();
-void DRLG_SetPC();
-void Make_SetPC(int x, int y, int w, int h);
-void DRLG_PlaceThemeRooms(int minSize, int maxSize, int floor, int freq, bool rndSize);
 void DRLG_HoldThemeRooms();
-void DRLG_LPass3(int lv);
 void DRLG_Init_Globals();
 bool SkipThemeRoom(int x, int y);
 void InitLevels();
-void FloodTransparencyValues(uint8_t floorID);
+
+/**
+ * @brief Returns the path of the tile definitions used by the given level
+ * @return nullptr for levels that have no random layout
+ */
+const char *GetMegaTilesPath(dungeon_type levelType, int level);
 
 } // namespace devilution
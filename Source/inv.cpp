@@ -1008,7 +1008,7 @@ void CleanupItems(Item *item, int ii)
 
 bool PutItem(Player &player, Point &position)
 {
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return false;
 
 	Direction d = GetDirection(player.position.tile, position);
@@ -1664,7 +1664,7 @@ bool CanPut(Point position)
 			return false;
 	}
 
-	int8_t oi = dObject[position.x + 1][position.y + 1];
+	int oi = dObject[position.x + 1][position.y + 1];
 	if (oi > 0 && Objects[oi - 1]._oSelFlag != 0) {
 		return false;
 	}
@@ -1674,7 +1674,7 @@ bool CanPut(Point position)
 
 	oi = dObject[position.x + 1][position.y];
 	if (oi > 0) {
-		int8_t oi2 = dObject[position.x][position.y + 1];
+		int oi2 = dObject[position.x][position.y + 1];
 		if (oi2 > 0 && Objects[oi - 1]._oSelFlag != 0 && Objects[oi2 - 1]._oSelFlag != 0)
 			return false;
 	}
@@ -1689,7 +1689,7 @@ bool CanPut(Point position)
 
 bool TryInvPut()
 {
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return false;
 
 	auto &myPlayer = Players[MyPlayerId];
@@ -6,12 +6,15 @@
 #include "items.h"
 
 #include <algorithm>
+#include <array>
 #include <bitset>
 #ifdef _DEBUG
 #include <random>
 #endif
 #include <climits>
 #include <cstdint>
+#include <map>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -1316,26 +1319,53 @@ void GetItemBonus(Item &item, int minlvl, int maxlvl, bool onlygood, bool allows
 	}
 }
 
-int RndUItem(Monster *monster)
-{
-	if (monster != nullptr && (monster->MData->mTreasure & T_UNIQ) != 0)
-		return -((monster->MData->mTreasure & T_MASK) + 1);
+/**
+ * @brief Item indices a roll picks from, one list per level the roll can be made at
+ *
+ * The lists are built once by the same scan of AllItemsList the rolls used to do on every call, so a roll still picks
+ * the same item for the same random number.
+ */
+class ItemCandidateTable {
+public:
+	/** @param collect Called as collect(level, candidates) to append the candidates for the given level */
+	template <typename Collect>
+	explicit ItemCandidateTable(Collect collect)
+	{
+		std::vector<int16_t> candidates;
+		for (int level = MinLevel; level <= MaxLevel; level++) {
+			candidates.clear();
+			collect(level, candidates);
+			if (lists_.empty() || lists_.back() != candidates)
+				lists_.push_back(candidates);
+			listIndex_[level - MinLevel] = static_cast<uint16_t>(lists_.size() - 1);
+		}
+	}
 
-	int ril[512];
+	/** @brief Picks one of the candidates for the given level, 0 if there are none */
+	int Roll(int level) const
+	{
+		const std::vector<int16_t> &candidates = lists_[listIndex_[std::clamp(level, MinLevel, MaxLevel) - MinLevel]];
+		int r = GenerateRnd(static_cast<int>(candidates.size()));
+		return candidates.empty() ? 0 : candidates[r];
+	}
 
-	int curlv = ItemsGetCurrlevel();
-	int ri = 0;
+private:
+	/** iMinMLvl is a uint8_t, levels outside of this range see the same items as the closest one inside it */
+	static constexpr int MinLevel = -1;
+	static constexpr int MaxLevel = 255;
+
+	std::vector<std::vector<int16_t>> lists_;
+	std::array<uint16_t, MaxLevel - MinLevel + 1> listIndex_;
+};
+
+void CollectUniqueDropItems(int level, std::vector<int16_t> &candidates)
+{
 	for (int i = 0; AllItemsList[i].iLoc != ILOC_INVALID; i++) {
 		bool okflag = true;
 		if (AllItemsList[i].iRnd == IDROP_NEVER)
 			okflag = false;
-		if (monster != nullptr) {
-			if (monster->mLevel < AllItemsList[i].iMinMLvl)
-				okflag = false;
-		} else {
-			if (2 * curlv < AllItemsList[i].iMinMLvl)
-				okflag = false;
-		}
+		if (level < AllItemsList[i].iMinMLvl)
+			okflag = false;
 		if (AllItemsList[i].itype == ItemType::Misc)
 			okflag = false;
 		if (AllItemsList[i].itype == ItemType::Gold)
@@ -1346,13 +1376,34 @@ int RndUItem(Monster *monster)
 			okflag = false;
 		if (AllItemsList[i].iSpell == SPL_HEALOTHER)
 			okflag = false;
-		if (okflag && ri < 512) {
-			ril[ri] = i;
-			ri++;
-		}
+		if (okflag && candidates.size() < 512)
+			candidates.push_back(i);
 	}
+}
+
+int RndUItem(const MonsterStats *monster)
+{
+	if (monster != nullptr && (monster->MData->mTreasure & T_UNIQ) != 0)
+		return -((monster->MData->mTreasure & T_MASK) + 1);
+
+	static const ItemCandidateTable Candidates { CollectUniqueDropItems };
+
+	if (monster != nullptr)
+		return Candidates.Roll(monster->mLevel);
+	return Candidates.Roll(2 * ItemsGetCurrlevel());
+}
 
-	return ril[GenerateRnd(ri)];
+void CollectAllItems(int level, std::vector<int16_t> &candidates)
+{
+	for (int i = 0; AllItemsList[i].iLoc != ILOC_INVALID; i++) {
+		if (AllItemsList[i].iRnd != IDROP_NEVER && level >= AllItemsList[i].iMinMLvl && candidates.size() < 512)
+			candidates.push_back(i);
+		// Takes back the last candidate even if it wasn't this item
+		if (AllItemsList[i].iSpell == SPL_RESURRECT && !candidates.empty())
+			candidates.pop_back();
+		if (AllItemsList[i].iSpell == SPL_HEALOTHER && !candidates.empty())
+			candidates.pop_back();
+	}
 }
 
 int RndAllItems()
@@ -1360,46 +1411,39 @@ int RndAllItems()
 	if (GenerateRnd(100) > 25)
 		return 0;
 
-	int ril[512];
+	static const ItemCandidateTable Candidates { CollectAllItems };
 
-	int curlv = ItemsGetCurrlevel();
-	int ri = 0;
-	for (int i = 0; AllItemsList[i].iLoc != ILOC_INVALID; i++) {
-		if (AllItemsList[i].iRnd != IDROP_NEVER && 2 * curlv >= AllItemsList[i].iMinMLvl && ri < 512) {
-			ril[ri] = i;
-			ri++;
-		}
-		if (AllItemsList[i].iSpell == SPL_RESURRECT)
-			ri--;
-		if (AllItemsList[i].iSpell == SPL_HEALOTHER)
-			ri--;
-	}
-
-	return ril[GenerateRnd(ri)];
+	return Candidates.Roll(2 * ItemsGetCurrlevel());
 }
 
 int RndTypeItems(ItemType itemType, int imid, int lvl)
 {
-	int ril[512];
-
-	int ri = 0;
-	for (int i = 0; AllItemsList[i].iLoc != ILOC_INVALID; i++) {
-		bool okflag = true;
-		if (AllItemsList[i].iRnd == IDROP_NEVER)
-			okflag = false;
-		if (lvl * 2 < AllItemsList[i].iMinMLvl)
-			okflag = false;
-		if (AllItemsList[i].itype != itemType)
-			okflag = false;
-		if (imid != -1 && AllItemsList[i].iMiscId != imid)
-			okflag = false;
-		if (okflag && ri < 512) {
-			ril[ri] = i;
-			ri++;
+	static const auto CandidatesByType = []() {
+		std::map<std::pair<ItemType, int>, ItemCandidateTable> tables;
+		for (int i = 0; AllItemsList[i].iLoc != ILOC_INVALID; i++) {
+			for (int misc : { -1, static_cast<int>(AllItemsList[i].iMiscId) }) {
+				std::pair<ItemType, int> key { AllItemsList[i].itype, misc };
+				if (tables.count(key) != 0)
+					continue;
+				tables.emplace(key, ItemCandidateTable { [&key](int level, std::vector<int16_t> &candidates) {
+					for (int j = 0; AllItemsList[j].iLoc != ILOC_INVALID; j++) {
+						if (AllItemsList[j].iRnd == IDROP_NEVER || level < AllItemsList[j].iMinMLvl)
+							continue;
+						if (AllItemsList[j].itype != key.first || (key.second != -1 && AllItemsList[j].iMiscId != key.second))
+							continue;
+						if (candidates.size() < 512)
+							candidates.push_back(j);
+					}
+				} });
+			}
 		}
-	}
+		return tables;
+	}();
 
-	return ril[GenerateRnd(ri)];
+	auto candidates = CandidatesByType.find({ itemType, imid });
+	if (candidates == CandidatesByType.end())
+		return 0;
+	return candidates->second.Roll(lvl * 2);
 }
 
 _unique_items CheckUnique(Item &item, int lvl, int uper, bool recreate)
@@ -1518,7 +1562,7 @@ void SetupAllItems(Item &item, int idx, int iseed, int lvl, int uper, bool onlyg
 
 void SetupBaseItem(Point position, int idx, bool onlygood, bool sendmsg, bool delta)
 {
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return;
 
 	int ii = AllocateItem();
@@ -1589,7 +1633,7 @@ void Hex2bin(const char *src, int bytes, uint8_t *target)
 
 void SpawnRock()
 {
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return;
 
 	int oi;
@@ -1995,11 +2039,8 @@ bool SmithItemOk(int i)
 }
 
 template <bool (*Ok)(int), bool ConsiderDropRate = false>
-int RndVendorItem(int minlvl, int maxlvl)
+void CollectVendorItems(int minlvl, int maxlvl, std::vector<int16_t> &candidates)
 {
-	int ril[512];
-
-	int ri = 0;
 	for (int i = 1; AllItemsList[i].iLoc != ILOC_INVALID; i++) {
 		if (AllItemsList[i].iRnd == IDROP_NEVER)
 			continue;
@@ -2008,26 +2049,35 @@ int RndVendorItem(int minlvl, int maxlvl)
 		if (AllItemsList[i].iMinMLvl < minlvl || AllItemsList[i].iMinMLvl > maxlvl)
 			continue;
 
-		ril[ri] = i;
-		ri++;
-		if (ri == 512)
+		candidates.push_back(i);
+		if (candidates.size() == 512)
 			break;
 
 		if (!ConsiderDropRate || AllItemsList[i].iRnd != IDROP_DOUBLE)
 			continue;
 
-		ril[ri] = i;
-		ri++;
-		if (ri == 512)
+		candidates.push_back(i);
+		if (candidates.size() == 512)
 			break;
 	}
+}
+
+/**
+ * @brief Picks an item a vendor sells from the items of level 0 up to the given one
+ */
+template <bool (*Ok)(int), bool ConsiderDropRate = false>
+int RndVendorItem(int lvl)
+{
+	static const ItemCandidateTable Candidates { [](int level, std::vector<int16_t> &candidates) {
+		CollectVendorItems<Ok, ConsiderDropRate>(0, level, candidates);
+	} };
 
-	return ril[GenerateRnd(ri)] + 1;
+	return Candidates.Roll(lvl) + 1;
 }
 
 int RndSmithItem(int lvl)
 {
-	return RndVendorItem<SmithItemOk, true>(0, lvl);
+	return RndVendorItem<SmithItemOk, true>(lvl);
 }
 
 void SortVendor(Item *itemList)
@@ -2053,9 +2103,16 @@ bool PremiumItemOk(int i)
 	return true;
 }
 
-int RndPremiumItem(int minlvl, int maxlvl)
+/**
+ * @brief Picks a premium item from the items of level plvl / 4 up to plvl
+ */
+int RndPremiumItem(int plvl)
 {
-	return RndVendorItem<PremiumItemOk>(minlvl, maxlvl);
+	static const ItemCandidateTable Candidates { [](int level, std::vector<int16_t> &candidates) {
+		CollectVendorItems<PremiumItemOk>(level / 4, level, candidates);
+	} };
+
+	return Candidates.Roll(plvl) + 1;
 }
 
 void SpawnOnePremium(int i, int plvl, int playerId)
@@ -2082,7 +2139,7 @@ void SpawnOnePremium(int i, int plvl, int playerId)
 		memset(&Items[0], 0, sizeof(*Items));
 		Items[0]._iSeed = AdvanceRndSeed();
 		SetRndSeed(Items[0]._iSeed);
-		int itemType = RndPremiumItem(plvl / 4, plvl) - 1;
+		int itemType = RndPremiumItem(plvl) - 1;
 		GetItemAttrs(Items[0], itemType, plvl);
 		GetItemBonus(Items[0], plvl / 2, plvl, true, false);
 
@@ -2161,12 +2218,12 @@ bool WitchItemOk(int i)
 
 int RndWitchItem(int lvl)
 {
-	return RndVendorItem<WitchItemOk>(0, lvl);
+	return RndVendorItem<WitchItemOk>(lvl);
 }
 
 int RndBoyItem(int lvl)
 {
-	return RndVendorItem<PremiumItemOk>(0, lvl);
+	return RndVendorItem<PremiumItemOk>(lvl);
 }
 
 bool HealerItemOk(int i)
@@ -2193,7 +2250,7 @@ bool HealerItemOk(int i)
 
 int RndHealerItem(int lvl)
 {
-	return RndVendorItem<HealerItemOk>(0, lvl);
+	return RndVendorItem<HealerItemOk>(lvl);
 }
 
 void RecreateSmithItem(Item &item, int lvl, int iseed)
@@ -2210,7 +2267,7 @@ void RecreateSmithItem(Item &item, int lvl, int iseed)
 void RecreatePremiumItem(Item &item, int plvl, int iseed)
 {
 	SetRndSeed(iseed);
-	int itype = RndPremiumItem(plvl / 4, plvl) - 1;
+	int itype = RndPremiumItem(plvl) - 1;
 	GetItemAttrs(item, itype, plvl);
 	GetItemBonus(item, plvl / 2, plvl, true, false);
 
@@ -2313,7 +2370,7 @@ void RecalcStoreStats()
 
 void CreateMagicItem(Point position, int lvl, ItemType itemType, int imid, int icurs, bool sendmsg, bool delta)
 {
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return;
 
 	int ii = AllocateItem();
@@ -3095,7 +3152,7 @@ void SetupItem(Item &item)
 	item._iIdentified = false;
 }
 
-int RndItem(const Monster &monster)
+int RndItem(const MonsterStats &monster)
 {
 	if ((monster.MData->mTreasure & T_UNIQ) != 0)
 		return -((monster.MData->mTreasure & T_MASK) + 1);
@@ -3109,33 +3166,26 @@ int RndItem(const Monster &monster)
 	if (GenerateRnd(100) > 25)
 		return IDI_GOLD + 1;
 
-	int ril[512];
-
-	int ri = 0;
-	for (int i = 0; AllItemsList[i].iLoc != ILOC_INVALID; i++) {
-		if (AllItemsList[i].iRnd == IDROP_DOUBLE && monster.mLevel >= AllItemsList[i].iMinMLvl
-		    && ri < 512) {
-			ril[ri] = i;
-			ri++;
+	static const ItemCandidateTable Candidates { [](int level, std::vector<int16_t> &candidates) {
+		for (int i = 0; AllItemsList[i].iLoc != ILOC_INVALID; i++) {
+			if (AllItemsList[i].iRnd == IDROP_DOUBLE && level >= AllItemsList[i].iMinMLvl && candidates.size() < 512)
+				candidates.push_back(i);
+			if (AllItemsList[i].iRnd != IDROP_NEVER && level >= AllItemsList[i].iMinMLvl && candidates.size() < 512)
+				candidates.push_back(i);
+			// Takes back the last candidate even if it wasn't this item
+			if (AllItemsList[i].iSpell == SPL_RESURRECT && !candidates.empty())
+				candidates.pop_back();
+			if (AllItemsList[i].iSpell == SPL_HEALOTHER && !candidates.empty())
+				candidates.pop_back();
 		}
-		if (AllItemsList[i].iRnd != IDROP_NEVER && monster.mLevel >= AllItemsList[i].iMinMLvl
-		    && ri < 512) {
-			ril[ri] = i;
-			ri++;
-		}
-		if (AllItemsList[i].iSpell == SPL_RESURRECT)
-			ri--;
-		if (AllItemsList[i].iSpell == SPL_HEALOTHER)
-			ri--;
-	}
+	} };
 
-	int r = GenerateRnd(ri);
-	return ril[r] + 1;
+	return Candidates.Roll(monster.mLevel) + 1;
 }
 
 void SpawnUnique(_unique_items uid, Point position)
 {
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return;
 
 	int ii = AllocateItem();
@@ -3157,15 +3207,15 @@ void SpawnItem(Monster &monster, Point position, bool sendmsg)
 	int idx;
 	bool onlygood = true;
 
-	if (monster._uniqtype != 0) {
-		idx = RndUItem(&monster);
+	if (monster.Stats()._uniqtype != 0) {
+		idx = RndUItem(&monster.Stats());
 		if (idx < 0) {
 			SpawnUnique((_unique_items) - (idx + 1), position);
 			return;
 		}
 		onlygood = true;
 	} else if (Quests[Q_MUSHROOM]._qactive != QUEST_ACTIVE || Quests[Q_MUSHROOM]._qvar1 != QS_MUSHGIVEN) {
-		idx = RndItem(monster);
+		idx = RndItem(monster.Stats());
 		if (idx == 0)
 			return;
 		if (idx > 0) {
@@ -3180,15 +3230,15 @@ void SpawnItem(Monster &monster, Point position, bool sendmsg)
 		Quests[Q_MUSHROOM]._qvar1 = QS_BRAINSPAWNED;
 	}
 
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return;
 
 	int ii = AllocateItem();
 	auto &item = Items[ii];
 	GetSuperItemSpace(position, ii);
-	int uper = monster._uniqtype != 0 ? 15 : 1;
+	int uper = monster.Stats()._uniqtype != 0 ? 15 : 1;
 
-	int8_t mLevel = monster.mLevel;
+	int8_t mLevel = monster.Stats().mLevel;
 	if (mLevel > CF_LEVEL)
 		mLevel = CF_LEVEL;
 
@@ -3207,7 +3257,7 @@ void CreateRndItem(Point position, bool onlygood, bool sendmsg, bool delta)
 
 void CreateRndUseful(Point position, bool sendmsg)
 {
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return;
 
 	int ii = AllocateItem();
@@ -3380,7 +3430,7 @@ void SpawnQuestItem(int itemid, Point position, int randarea, int selflag)
 		}
 	}
 
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return;
 
 	int ii = AllocateItem();
@@ -3406,7 +3456,7 @@ void SpawnQuestItem(int itemid, Point position, int randarea, int selflag)
 
 void SpawnRewardItem(int itemid, Point position)
 {
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return;
 
 	int ii = AllocateItem();
@@ -4465,7 +4515,7 @@ void CreateSpellBook(Point position, spell_id ispell, bool sendmsg, bool delta)
 	}
 
 	int idx = RndTypeItems(ItemType::Misc, IMISC_BOOK, lvl);
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return;
 
 	int ii = AllocateItem();
@@ -4557,7 +4607,7 @@ void PutItemRecord(int nSeed, uint16_t wCI, int nIndex)
 std::mt19937 BetterRng;
 std::string DebugSpawnItem(std::string itemName, bool unique)
 {
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return "No space to generate the item!";
 
 	const int max_time = 3000;
@@ -4570,7 +4620,7 @@ std::string DebugSpawnItem(std::string itemName, bool unique)
 	std::transform(itemName.begin(), itemName.end(), itemName.begin(), [](unsigned char c) { return std::tolower(c); });
 
 	uint32_t begin = SDL_GetTicks();
-	Monster fake_m;
+	MonsterStats fake_m;
 	fake_m.MData = &MonstersData[0];
 	fake_m._uniqtype = 0;
 	int i = 0;
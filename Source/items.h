@@ -17,7 +17,8 @@
 
 namespace devilution {
 
-#define MAXITEMS 127
+/** Storage for items on the ground, the item limit option caps how many of them are in use */
+#define MAXITEMS 512
 #define ITEMTYPES 43
 
 #define GOLD_SMALL_LIMIT 1000
@@ -422,7 +423,7 @@ int AllocateItem();
 Point GetSuperItemLoc(Point position);
 void GetItemAttrs(Item &item, int itemData, int lvl);
 void SetupItem(Item &item);
-int RndItem(const Monster &monster);
+int RndItem(const MonsterStats &monster);
 void SpawnUnique(_unique_items uid, Point position);
 void SpawnItem(Monster &monster, Point position, bool sendmsg);
 void CreateRndItem(Point position, bool onlygood, bool sendmsg, bool delta);
@@ -0,0 +1,199 @@
+/**
+ * @file levelpregen.cpp
+ *
+ * Implementation of the background generation of the levels next to the active one.
+ */
+#include "levelpregen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "diablo.h"
+#include "drlg_l1.h"
+#include "drlg_l2.h"
+#include "drlg_l3.h"
+#include "drlg_l4.h"
+#include "engine/load_file.hpp"
+#include "engine/random.hpp"
+#include "lighting.h"
+#include "quests.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+namespace {
+
+struct PregeneratedLevel {
+	int level;
+	dungeon_type levelType;
+	uint32_t seed;
+	lvl_entry entry;
+	std::unique_ptr<LevelGenerationBuffers> buffers;
+	/** Set by the worker once the layout is complete, only read after the worker has been joined */
+	bool done;
+};
+
+/** Levels handed to the worker, the list is only changed while no worker is running */
+std::vector<PregeneratedLevel> PregeneratedLevels;
+SdlThread PregenerationThread;
+/** Tells the worker to stop before it starts on the next level */
+std::atomic_bool PregenerationCancelled;
+
+/**
+ * @brief Checks if the layout of the given level can be built away from the active level
+ *
+ * Quest set pieces are read from the MPQs and placed through the quest code, which only knows about the active level,
+ * so levels a quest can show up on are left to the regular path. Catacomb levels 7 and 8 replay the generation of the
+ * levels above them so those count as well. Diablo's level always loads its quadrants from the MPQs.
+ */
+bool CanPregenerate(int level)
+{
+	if (level == 16)
+		return false;
+
+	int firstGeneratedLevel = (level == 7 || level == 8) ? 6 : level;
+	for (auto &quest : Quests) {
+		if (quest._qactive != QUEST_NOTAVAIL && quest._qlevel >= firstGeneratedLevel && quest._qlevel <= level)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Copies the part of the level state written by the generators
+ *
+ * Not every generator writes all of it (e.g. the cathedral has no theme rooms), so pregenerated levels start out with
+ * the state of the active level like they would have when generated in place.
+ */
+void CopyLevelState(const LevelGenerationContext &source, LevelGenerationContext &target)
+{
+	memcpy(target.dungeon, source.dungeon, sizeof(target.dungeon));
+	memcpy(target.pdungeon, source.pdungeon, sizeof(target.pdungeon));
+	memcpy(target.dflags, source.dflags, sizeof(target.dflags));
+	target.setpc_x = source.setpc_x;
+	target.setpc_y = source.setpc_y;
+	target.setpc_w = source.setpc_w;
+	target.setpc_h = source.setpc_h;
+	target.dminPosition = source.dminPosition;
+	target.dmaxPosition = source.dmaxPosition;
+	target.ViewPosition = source.ViewPosition;
+	target.TransVal = source.TransVal;
+	memcpy(target.TransList, source.TransList, sizeof(target.TransList));
+	memcpy(target.dPiece, source.dPiece, sizeof(target.dPiece));
+	memcpy(target.dTransVal, source.dTransVal, sizeof(target.dTransVal));
+	memcpy(target.dLight, source.dLight, sizeof(target.dLight));
+	memcpy(target.dFlags, source.dFlags, sizeof(target.dFlags));
+	memcpy(target.dSpecial, source.dSpecial, sizeof(target.dSpecial));
+	target.themeCount = source.themeCount;
+	memcpy(target.themeLoc, source.themeLoc, sizeof(target.themeLoc));
+	target.UberRow = source.UberRow;
+	target.UberCol = source.UberCol;
+}
+
+void QueueLevel(int level, lvl_entry entry)
+{
+	dungeon_type levelType = gnLevelTypeTbl[level];
+	const char *megaTilesPath = GetMegaTilesPath(levelType, level);
+	if (megaTilesPath == nullptr || !CanPregenerate(level))
+		return;
+
+	auto buffers = std::make_unique<LevelGenerationBuffers>();
+	buffers->megaTiles = LoadFileInMem<MegaTile>(megaTilesPath);
+	buffers->currlevel = level;
+	buffers->leveltype = levelType;
+	buffers->disableLighting = DisableLighting;
+	memcpy(buffers->glSeedTbl, glSeedTbl, sizeof(buffers->glSeedTbl));
+
+	LevelGenerationContext target(*buffers);
+	CopyLevelState(LevelGenerationContext {}, target);
+
+	PregeneratedLevels.push_back({ level, levelType, glSeedTbl[level], entry, std::move(buffers), false });
+}
+
+void GenerateLevels()
+{
+	for (PregeneratedLevel &pregenerated : PregeneratedLevels) {
+		if (PregenerationCancelled)
+			return;
+
+		LevelGenerationContext context(*pregenerated.buffers);
+		switch (pregenerated.levelType) {
+		case DTYPE_CATHEDRAL:
+			GenerateL5Dungeon(context, pregenerated.seed, pregenerated.entry);
+			break;
+		case DTYPE_CATACOMBS:
+			GenerateL2Dungeon(context, pregenerated.seed, pregenerated.entry);
+			break;
+		case DTYPE_CAVES:
+			GenerateL3Dungeon(context, pregenerated.seed, pregenerated.entry);
+			break;
+		case DTYPE_HELL:
+			GenerateL4Dungeon(context, pregenerated.seed, pregenerated.entry);
+			break;
+		default:
+			continue;
+		}
+		pregenerated.done = true;
+	}
+}
+
+} // namespace
+
+void PregenerateAdjacentLevels()
+{
+	CancelLevelPregeneration();
+
+	if (setlevel)
+		return;
+
+	if (currlevel != 16 && currlevel != 20 && currlevel < NUMLEVELS - 1)
+		QueueLevel(currlevel + 1, ENTRY_MAIN);
+	if (currlevel != 0 && currlevel != 1 && currlevel != 17 && currlevel != 21)
+		QueueLevel(currlevel - 1, ENTRY_PREV);
+
+	if (PregeneratedLevels.empty())
+		return;
+
+	PregenerationCancelled = false;
+	PregenerationThread = SdlThread { GenerateLevels };
+}
+
+bool CommitPregeneratedLevel(uint32_t rseed, lvl_entry entry)
+{
+	auto pregenerated = std::find_if(PregeneratedLevels.begin(), PregeneratedLevels.end(), [&](const PregeneratedLevel &candidate) {
+		return candidate.level == currlevel && candidate.levelType == leveltype && candidate.seed == rseed && candidate.entry == entry;
+	});
+	if (pregenerated == PregeneratedLevels.end()) {
+		CancelLevelPregeneration();
+		return false;
+	}
+
+	// Let the worker finish, it is either on this level or on one queued before it
+	PregenerationThread.join();
+
+	// Quest state or the lighting setting may have changed since the level was queued
+	bool usable = pregenerated->done && CanPregenerate(currlevel) && pregenerated->buffers->disableLighting == DisableLighting;
+	if (usable) {
+		// The entity maps are not part of the layout but are expected to be empty afterwards
+		DRLG_Init_Globals();
+		LevelGenerationContext live;
+		CopyLevelState(LevelGenerationContext(*pregenerated->buffers), live);
+		SetRndSeed(pregenerated->buffers->rngState);
+	}
+
+	PregeneratedLevels.clear();
+	return usable;
+}
+
+void CancelLevelPregeneration()
+{
+	PregenerationCancelled = true;
+	PregenerationThread.join();
+	PregeneratedLevels.clear();
+}
+
+} // namespace devilution
@@ -0,0 +1,38 @@
+/**
+ * @file levelpregen.h
+ *
+ * Interface of the background generation of the levels next to the active one.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "gendung.h"
+
+namespace devilution {
+
+/**
+ * @brief Starts laying out the levels above and below the active one on a worker thread.
+ *
+ * Only the dungeon layout is built ahead of time, everything that depends on the player (monsters, items, objects)
+ * still happens when the level is entered.
+ */
+void PregenerateAdjacentLevels();
+
+/**
+ * @brief Moves a pregenerated layout of the level that is being created into the level globals.
+ *
+ * Waits for the worker if it is still busy. All other pregenerated levels are dropped.
+ *
+ * @param rseed Seed the level is generated from
+ * @param entry Method of entry, this decides the starting position on the level
+ * @return false if no layout matching the active level was pregenerated, the caller then generates it as usual
+ */
+bool CommitPregeneratedLevel(uint32_t rseed, lvl_entry entry);
+
+/**
+ * @brief Stops the worker thread and drops all pregenerated levels.
+ */
+void CancelLevelPregeneration();
+
+} // namespace devilution
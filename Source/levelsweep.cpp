@@ -0,0 +1,186 @@
+/**
+ * @file levelsweep.cpp
+ *
+ * Implementation of the seed sweeps that check the random level generators against recorded layouts.
+ */
+#include "levelsweep.h"
+
+#include <algorithm>
+#include <atomic>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+#include <SDL.h>
+#include <fmt/format.h>
+
+#include "drlg_l1.h"
+#include "drlg_l2.h"
+#include "drlg_l3.h"
+#include "drlg_l4.h"
+#include "engine/load_file.hpp"
+#include "gendung.h"
+#include "multi.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+namespace {
+
+struct SeedSweep {
+	std::vector<SeedSweepResult> results;
+	std::atomic_int nextResult;
+	std::vector<std::unique_ptr<LevelGenerationBuffers>> buffers;
+	std::atomic_int nextBuffers;
+};
+
+template <typename T, size_t N>
+void HashLevelData(uint64_t &hash, const T (&data)[N])
+{
+	// FNV-1a
+	const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+	for (size_t i = 0; i < sizeof(data); i++) {
+		hash ^= bytes[i];
+		hash *= 0x100000001B3;
+	}
+}
+
+int SDLCALL SweepSeeds(void *data)
+{
+	auto &sweep = *static_cast<SeedSweep *>(data);
+	LevelGenerationBuffers &buffers = *sweep.buffers[sweep.nextBuffers++];
+	LevelGenerationContext context(buffers);
+
+	for (int i = sweep.nextResult++; i < static_cast<int>(sweep.results.size()); i = sweep.nextResult++) {
+		SeedSweepResult &result = sweep.results[i];
+		buffers.layoutAttempts = 0;
+		// Levels 7 and 8 replay the levels above them, seed those from the swept seed so the layout only depends on it
+		context.SetRndSeed(result.seed);
+		for (uint32_t &levelSeed : buffers.glSeedTbl)
+			levelSeed = context.AdvanceRndSeed();
+
+		uint64_t start = SDL_GetPerformanceCounter();
+		switch (buffers.leveltype) {
+		case DTYPE_CATHEDRAL:
+			GenerateL5Dungeon(context, result.seed, ENTRY_MAIN);
+			break;
+		case DTYPE_CATACOMBS:
+			GenerateL2Dungeon(context, result.seed, ENTRY_MAIN);
+			break;
+		case DTYPE_CAVES:
+			GenerateL3Dungeon(context, result.seed, ENTRY_MAIN);
+			break;
+		case DTYPE_HELL:
+			GenerateL4Dungeon(context, result.seed, ENTRY_MAIN);
+			break;
+		default:
+			break;
+		}
+		result.ticks = SDL_GetPerformanceCounter() - start;
+		result.layoutAttempts = buffers.layoutAttempts;
+
+		// dPiece and the lights are only the tile definitions applied to the dungeon tiles
+		result.hash = 0xCBF29CE484222325;
+		HashLevelData(result.hash, buffers.dungeon);
+		HashLevelData(result.hash, buffers.dTransVal);
+	}
+
+	return 0;
+}
+
+} // namespace
+
+bool CanSweepLevel(int level)
+{
+	return level >= 1 && level < NUMLEVELS && level != 16;
+}
+
+std::vector<SeedSweepResult> SweepLevelSeeds(int level, uint32_t firstSeed, int count, bool loadTiles, int &threadCount)
+{
+	SeedSweep sweep;
+	sweep.results.resize(count);
+	for (int i = 0; i < count; i++)
+		sweep.results[i].seed = firstSeed + i;
+	sweep.nextResult = 0;
+	sweep.nextBuffers = 0;
+
+	// Every worker needs its own set of buffers, the tile definitions are loaded here as file access is not thread safe
+	threadCount = std::max(1, std::min(SDL_GetCPUCount(), count));
+	for (int i = 0; i < threadCount; i++) {
+		auto buffers = std::make_unique<LevelGenerationBuffers>();
+		buffers->currlevel = level;
+		buffers->leveltype = InitLevelType(level);
+		if (loadTiles)
+			buffers->megaTiles = LoadFileInMem<MegaTile>(GetMegaTilesPath(buffers->leveltype, level));
+		if (buffers->megaTiles == nullptr)
+			buffers->megaTiles = std::make_unique<MegaTile[]>(MAXTILES);
+		sweep.buffers.push_back(std::move(buffers));
+	}
+
+	std::vector<SdlThread> threads;
+	for (int i = 0; i < threadCount; i++)
+		threads.emplace_back(SweepSeeds, &sweep);
+	for (auto &thread : threads)
+		thread.join();
+
+	return std::move(sweep.results);
+}
+
+std::string DescribeSeedSweep(int level, const std::vector<SeedSweepResult> &results, uint64_t wallTicks, int threadCount)
+{
+	uint64_t ticksPerMicrosecond = std::max<uint64_t>(SDL_GetPerformanceFrequency() / 1000000, 1);
+	uint64_t totalTicks = 0;
+	int totalAttempts = 0;
+	const SeedSweepResult *slowest = &results[0];
+	const SeedSweepResult *mostAttempts = &results[0];
+	for (const SeedSweepResult &result : results) {
+		totalTicks += result.ticks;
+		totalAttempts += result.layoutAttempts;
+		if (result.ticks > slowest->ticks)
+			slowest = &result;
+		if (result.layoutAttempts > mostAttempts->layoutAttempts)
+			mostAttempts = &result;
+	}
+
+	const auto count = static_cast<int>(results.size());
+	return fmt::format("Generated {} layouts of level {} in {} ms on {} threads.\nAverage {} us, slowest {} us (seed {}).\nAverage {:.2f} layout attempts, most {} (seed {}).",
+	    count, level, wallTicks / ticksPerMicrosecond / 1000, threadCount,
+	    totalTicks / count / ticksPerMicrosecond, slowest->ticks / ticksPerMicrosecond, slowest->seed,
+	    static_cast<float>(totalAttempts) / count, mostAttempts->layoutAttempts, mostAttempts->seed);
+}
+
+bool ReadSeedSweep(std::istream &stream, SeedSweepRecording &recording)
+{
+	SeedSweepResult result {};
+	while (stream >> result.seed >> result.layoutAttempts >> std::hex >> result.hash >> std::dec)
+		recording[result.seed] = result;
+
+	return stream.eof();
+}
+
+void WriteSeedSweep(std::ostream &stream, const std::vector<SeedSweepResult> &results)
+{
+	for (const SeedSweepResult &result : results)
+		stream << fmt::format("{} {} {:016x}\n", result.seed, result.layoutAttempts, result.hash);
+}
+
+int CompareSeedSweep(const std::vector<SeedSweepResult> &results, const SeedSweepRecording &recording, int &compared, const SeedSweepResult **firstMismatch)
+{
+	compared = 0;
+	int mismatches = 0;
+	for (const SeedSweepResult &result : results) {
+		auto expected = recording.find(result.seed);
+		if (expected == recording.end())
+			continue;
+		compared++;
+		if (expected->second.layoutAttempts != result.layoutAttempts || expected->second.hash != result.hash) {
+			if (mismatches == 0)
+				*firstMismatch = &result;
+			mismatches++;
+		}
+	}
+
+	return mismatches;
+}
+
+} // namespace devilution
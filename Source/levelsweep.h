@@ -0,0 +1,73 @@
+/**
+ * @file levelsweep.h
+ *
+ * Interface of the seed sweeps that check the random level generators against recorded layouts.
+ */
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace devilution {
+
+struct SeedSweepResult {
+	uint32_t seed;
+	/** Number of times the generator started over on a new layout */
+	int layoutAttempts;
+	/** Hash of the layout, only covers the parts that don't depend on the tile definitions of the game data */
+	uint64_t hash;
+	/** Time spent on the layout in performance counter ticks */
+	uint64_t ticks;
+};
+
+/** Recorded layouts by seed */
+using SeedSweepRecording = std::map<uint32_t, SeedSweepResult>;
+
+/**
+ * @brief Checks if the layout of the given level is randomly generated and can be swept
+ *
+ * Diablo's lair is loaded from the game data.
+ */
+bool CanSweepLevel(int level);
+
+/**
+ * @brief Generates the layouts of a range of seeds for a dungeon level on one thread per core
+ *
+ * Quests are treated as unavailable. The seeds of the other levels, which catacomb levels 7 and 8 replay, are derived
+ * from the swept seed the same way a new game derives them from the game seed.
+ *
+ * @param level Dungeon level to generate, see CanSweepLevel()
+ * @param firstSeed Seed of the first layout
+ * @param count Number of consecutive seeds to generate
+ * @param loadTiles Load the tile definitions from the game data, without them dPiece is left blank
+ * @param threadCount Returns the number of worker threads that were used
+ */
+std::vector<SeedSweepResult> SweepLevelSeeds(int level, uint32_t firstSeed, int count, bool loadTiles, int &threadCount);
+
+/**
+ * @brief Describes how long the layouts of a sweep took and how often the generator started over
+ * @param wallTicks Time the whole sweep took in performance counter ticks
+ * @param threadCount Number of worker threads the sweep ran on
+ */
+std::string DescribeSeedSweep(int level, const std::vector<SeedSweepResult> &results, uint64_t wallTicks, int threadCount);
+
+/**
+ * @brief Reads a recording written by WriteSeedSweep()
+ * @return false if the stream holds anything but recorded layouts
+ */
+bool ReadSeedSweep(std::istream &stream, SeedSweepRecording &recording);
+
+void WriteSeedSweep(std::ostream &stream, const std::vector<SeedSweepResult> &results);
+
+/**
+ * @brief Compares the results of a sweep with a recording, seeds missing from the recording are skipped
+ * @param compared Returns the number of results that were found in the recording
+ * @param firstMismatch Returns the first result that differs from the recording, left untouched when all match
+ * @return Number of results that differ from the recording
+ */
+int CompareSeedSweep(const std::vector<SeedSweepResult> &results, const SeedSweepRecording &recording, int &compared, const SeedSweepResult **firstMismatch);
+
+} // namespace devilution
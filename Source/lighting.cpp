@@ -10,7 +10,9 @@
 #include "automap.h"
 #include "diablo.h"
 #include "engine/load_file.hpp"
+#include "options.h"
 #include "player.h"
+#include "engine/render/cl2_render.hpp"
 
 namespace devilution {
 
@@ -737,6 +739,8 @@ void DoVision(Point position, int nRadius, bool doautomap, bool visible)
 
 void MakeLightTable()
 {
+	Cl2ClearDecodeCache();
+
 	uint8_t *tbl = LightTables.data();
 	int shade = 0;
 	int lights = 15;
@@ -965,7 +969,7 @@ int AddLight(Point position, int r)
 
 	lid = NO_LIGHT;
 
-	if (ActiveLightCount < MAXLIGHTS) {
+	if (ActiveLightCount < sgGameInitInfo.nLightLimit) {
 		lid = ActiveLights[ActiveLightCount++];
 		Lights[lid].position.tile = position;
 		Lights[lid]._lradius = r;
@@ -1098,7 +1102,7 @@ void InitVision()
 
 int AddVision(Point position, int r, bool mine)
 {
-	if (VisionCount >= MAXVISION)
+	if (VisionCount >= sgGameInitInfo.nVisionLimit)
 		return -1;
 
 	auto &vision = VisionList[VisionCount];
@@ -1116,6 +1120,18 @@ int AddVision(Point position, int r, bool mine)
 	return vision._lid;
 }
 
+void AddUnVision(int id)
+{
+	for (int i = 0; i < VisionCount; i++) {
+		auto &vision = VisionList[i];
+		if (vision._lid != id)
+			continue;
+
+		vision._ldel = true;
+		dovision = true;
+	}
+}
+
 void ChangeVisionRadius(int id, int r)
 {
 	for (int i = 0; i < VisionCount; i++) {
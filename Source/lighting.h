@@ -13,8 +13,10 @@
 
 namespace devilution {
 
-#define MAXLIGHTS 32
-#define MAXVISION 32
+/** Storage for lights, the light limit option caps how many of them shine at once (ids have to fit Monster::mlid) */
+#define MAXLIGHTS 127
+/** Storage for vision sources, the vision limit option caps how many of them are active at once */
+#define MAXVISION 127
 #define LIGHTSIZE (27 * 256)
 #define NO_LIGHT -1
 
@@ -66,6 +68,7 @@ void ProcessLightList();
 void SavePreLighting();
 void InitVision();
 int AddVision(Point position, int r, bool mine);
+void AddUnVision(int id);
 void ChangeVisionRadius(int id, int r);
 void ChangeVisionXY(int id, Point position);
 void ProcessVisionList();
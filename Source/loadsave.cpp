@@ -21,6 +21,7 @@
 #include "engine/random.hpp"
 #include "init.h"
 #include "inv.h"
+#include "levelpregen.h"
 #include "lighting.h"
 #include "missiles.h"
 #include "mpqapi.h"
@@ -124,6 +125,17 @@ public:
 		return SwapLE(Next<T>());
 	}
 
+	template <class T>
+	T PeekLE()
+	{
+		if (!IsValid(sizeof(T)))
+			return 0;
+
+		T value;
+		memcpy(&value, &m_buffer_[m_cur_], sizeof(T));
+		return SwapLE(value);
+	}
+
 	template <class T>
 	T NextBE()
 	{
@@ -528,7 +540,7 @@ void LoadPlayer(LoadHelper &file, Player &player)
 	// Omit pointer pReserved
 }
 
-void LoadMonster(LoadHelper *file, Monster &monster)
+void LoadMonster(LoadHelper *file, Monster &monster, uint32_t version)
 {
 	monster._mMTidx = file->NextLE<int32_t>();
 	monster._mmode = static_cast<MonsterMode>(file->NextLE<int32_t>());
@@ -584,43 +596,44 @@ void LoadMonster(LoadHelper *file, Monster &monster)
 	file->Skip(4); // Unused
 	monster.position.last.x = file->NextLE<int32_t>();
 	monster.position.last.y = file->NextLE<int32_t>();
-	monster._mRndSeed = file->NextLE<uint32_t>();
-	monster._mAISeed = file->NextLE<uint32_t>();
+	monster.Stats()._mRndSeed = file->NextLE<uint32_t>();
+	monster.Stats()._mAISeed = file->NextLE<uint32_t>();
 	file->Skip(4); // Unused
 
-	monster._uniqtype = file->NextLE<uint8_t>();
-	monster._uniqtrans = file->NextLE<uint8_t>();
-	monster._udeadval = file->NextLE<int8_t>();
+	monster.Stats()._uniqtype = file->NextLE<uint8_t>();
+	monster.Stats()._uniqtrans = file->NextLE<uint8_t>();
+	monster.Stats()._udeadval = file->NextLE<int8_t>();
 
-	monster.mWhoHit = file->NextLE<int8_t>();
-	monster.mLevel = file->NextLE<int8_t>();
+	monster.Stats().mWhoHit = file->NextLE<int8_t>();
+	monster.Stats().mLevel = file->NextLE<int8_t>();
 	file->Skip(1); // Alignment
-	monster.mExp = file->NextLE<uint16_t>();
+	monster.Stats().mExp = file->NextLE<uint16_t>();
 
 	if ((monster._mFlags & MFLAG_GOLEM) != 0) // Don't skip for golems
-		monster.mHit = file->NextLE<uint8_t>();
+		monster.Stats().mHit = file->NextLE<uint8_t>();
 	else
 		file->Skip(1); // Skip mHit as it's already initialized
 
 	auto minDamage = file->NextLE<uint8_t>();
 	auto maxDamage = file->NextLE<uint8_t>();
-	monster.mDamage = { minDamage, maxDamage };
+	monster.Stats().mDamage = { minDamage, maxDamage };
 
 	file->Skip(1); // Skip mHit2 as it's already initialized
 
 	auto minDamage2 = file->NextLE<uint8_t>();
 	auto maxDamage2 = file->NextLE<uint8_t>();
-	monster.mDamage2 = { minDamage2, maxDamage2 };
+	monster.Stats().mDamage2 = { minDamage2, maxDamage2 };
 
-	monster.mArmorClass = file->NextLE<uint8_t>();
+	monster.Stats().mArmorClass = file->NextLE<uint8_t>();
 	file->Skip(1); // Alignment
-	monster.mMagicRes = file->NextLE<uint16_t>();
+	monster.Stats().mMagicRes = file->NextLE<uint16_t>();
 	file->Skip(2); // Alignment
 
 	monster.mtalkmsg = static_cast<_speech_id>(file->NextLE<int32_t>());
 	if (monster.mtalkmsg == TEXT_KING1) // Fix original bad mapping of NONE for monsters
 		monster.mtalkmsg = TEXT_NONE;
-	monster.leader = file->NextLE<uint8_t>();
+	// Version 1 saves stored the leader in a byte, which can't hold every monster id
+	monster.leader = version == 1 ? file->NextLE<uint8_t>() : file->NextLE<uint16_t>();
 	monster.leaderRelation = static_cast<LeaderRelation>(file->NextLE<uint8_t>());
 	monster.packsize = file->NextLE<uint8_t>();
 	monster.mlid = file->NextLE<int8_t>();
@@ -1177,32 +1190,32 @@ void SaveMonster(SaveHelper *file, Monster &monster)
 	file->Skip(4); // Unused
 	file->WriteLE<int32_t>(monster.position.last.x);
 	file->WriteLE<int32_t>(monster.position.last.y);
-	file->WriteLE<uint32_t>(monster._mRndSeed);
-	file->WriteLE<uint32_t>(monster._mAISeed);
+	file->WriteLE<uint32_t>(monster.Stats()._mRndSeed);
+	file->WriteLE<uint32_t>(monster.Stats()._mAISeed);
 	file->Skip(4); // Unused
 
-	file->WriteLE<uint8_t>(monster._uniqtype);
-	file->WriteLE<uint8_t>(monster._uniqtrans);
-	file->WriteLE<int8_t>(monster._udeadval);
+	file->WriteLE<uint8_t>(monster.Stats()._uniqtype);
+	file->WriteLE<uint8_t>(monster.Stats()._uniqtrans);
+	file->WriteLE<int8_t>(monster.Stats()._udeadval);
 
-	file->WriteLE<int8_t>(monster.mWhoHit);
-	file->WriteLE<int8_t>(monster.mLevel);
+	file->WriteLE<int8_t>(monster.Stats().mWhoHit);
+	file->WriteLE<int8_t>(monster.Stats().mLevel);
 	file->Skip(1); // Alignment
-	file->WriteLE<uint16_t>(monster.mExp);
-
-	file->WriteLE<uint8_t>(std::min<uint16_t>(monster.mHit, std::numeric_limits<uint8_t>::max())); // For backwards compatibility
-	file->WriteLE<uint8_t>(monster.mDamage.minValue);
-	file->WriteLE<uint8_t>(monster.mDamage.maxValue);
-	file->WriteLE<uint8_t>(std::min<uint16_t>(monster.mHit2, std::numeric_limits<uint8_t>::max())); // For backwards compatibility
-	file->WriteLE<uint8_t>(monster.mDamage2.minValue);
-	file->WriteLE<uint8_t>(monster.mDamage2.maxValue);
-	file->WriteLE<uint8_t>(monster.mArmorClass);
+	file->WriteLE<uint16_t>(monster.Stats().mExp);
+
+	file->WriteLE<uint8_t>(std::min<uint16_t>(monster.Stats().mHit, std::numeric_limits<uint8_t>::max())); // For backwards compatibility
+	file->WriteLE<uint8_t>(monster.Stats().mDamage.minValue);
+	file->WriteLE<uint8_t>(monster.Stats().mDamage.maxValue);
+	file->WriteLE<uint8_t>(std::min<uint16_t>(monster.Stats().mHit2, std::numeric_limits<uint8_t>::max())); // For backwards compatibility
+	file->WriteLE<uint8_t>(monster.Stats().mDamage2.minValue);
+	file->WriteLE<uint8_t>(monster.Stats().mDamage2.maxValue);
+	file->WriteLE<uint8_t>(monster.Stats().mArmorClass);
 	file->Skip(1); // Alignment
-	file->WriteLE<uint16_t>(monster.mMagicRes);
+	file->WriteLE<uint16_t>(monster.Stats().mMagicRes);
 	file->Skip(2); // Alignment
 
 	file->WriteLE<int32_t>(monster.mtalkmsg == TEXT_NONE ? 0 : monster.mtalkmsg); // Replicate original bad mapping of none for monsters
-	file->WriteLE<uint8_t>(monster.leader);
+	file->WriteLE<uint16_t>(monster.leader);
 	file->WriteLE<uint8_t>(static_cast<std::uint8_t>(monster.leaderRelation));
 	file->WriteLE<uint8_t>(monster.packsize);
 	file->WriteLE<int8_t>(monster.mlid);
@@ -1354,12 +1367,206 @@ void SavePortal(SaveHelper *file, int i)
 }
 
 const int ItemSaveSize = 372;
+const int MonsterSaveSize = 216;
+const int MissileSaveSize = 176;
+const int ObjectSaveSize = 120;
+const int LightSaveSize = 52;
+
+/** Version of the save format this build writes, saves from before versions were recorded are version 1 */
+constexpr uint32_t SaveVersion = 2;
+
+/** @brief Number of slots the entity pools had when a game or level was saved */
+struct PoolSizes {
+	int monsters;
+	int missiles;
+	int items;
+	int objects;
+	int lights;
+};
+
+/** Version 1 saves were written with the pools of the original game */
+constexpr PoolSizes Version1PoolSizes { 200, 125, 127, 127, 32 };
+
+/**
+ * The original 256 kilobytes (+ 3 bytes demo leftover, the final game uses a 4-byte magic instead) were sized for the
+ * original pools, room for full pools and the wider tile ids comes on top of it.
+ */
+constexpr size_t SaveBufferSize = (256 * 1024) + 3
+    + MAXMONSTERS * (MonsterSaveSize + 4)
+    + MAXMISSILES * (MissileSaveSize + 4)
+    + MAXITEMS * (ItemSaveSize + 4)
+    + MAXOBJECTS * (ObjectSaveSize + 4)
+    + (MAXLIGHTS + MAXVISION) * (LightSaveSize + 1)
+    + MAXDUNX * MAXDUNY * 2;
+
+/**
+ * @brief Reads the version of a level file, which precedes the level data since version 2
+ */
+uint32_t LoadLevelVersion(LoadHelper &file)
+{
+	// Version 1 levels start with the corpses on the edge of the map or with a big endian monster count, both begin with 0
+	if (file.PeekLE<uint32_t>() != LoadLE32("LVLV"))
+		return 1;
+	file.Skip<uint32_t>();
+	return file.NextLE<uint32_t>();
+}
+
+PoolSizes LoadPoolSizes(LoadHelper &file, uint32_t version)
+{
+	if (version == 1)
+		return Version1PoolSizes;
+
+	PoolSizes sizes;
+	sizes.monsters = file.NextBE<int32_t>();
+	sizes.missiles = file.NextBE<int32_t>();
+	sizes.items = file.NextBE<int32_t>();
+	sizes.objects = file.NextBE<int32_t>();
+	sizes.lights = file.NextBE<int32_t>();
+	if (sizes.monsters > MAXMONSTERS || sizes.missiles > MAXMISSILES || sizes.items > MAXITEMS || sizes.objects > MAXOBJECTS || sizes.lights > MAXLIGHTS)
+		app_fatal("%s", "Save file uses larger entity pools than this build supports");
+	return sizes;
+}
+
+void SavePoolSizes(SaveHelper &file)
+{
+	file.WriteBE<int32_t>(MAXMONSTERS);
+	file.WriteBE<int32_t>(MAXMISSILES);
+	file.WriteBE<int32_t>(MAXITEMS);
+	file.WriteBE<int32_t>(MAXOBJECTS);
+	file.WriteBE<int32_t>(MAXLIGHTS);
+}
+
+/**
+ * @brief Restores the entity limits the game was created with, version 1 saves were played with those of the original game
+ */
+void LoadEntityLimits(LoadHelper &file, uint32_t version)
+{
+	if (version == 1) {
+		sgGameInitInfo.nMonsterLimit = 200;
+		sgGameInitInfo.nMissileLimit = 125;
+		sgGameInitInfo.nItemLimit = 127;
+		sgGameInitInfo.nObjectLimit = 127;
+		sgGameInitInfo.nLightLimit = 32;
+		sgGameInitInfo.nVisionLimit = 32;
+		return;
+	}
+
+	sgGameInitInfo.nMonsterLimit = file.NextBE<uint16_t>();
+	sgGameInitInfo.nMissileLimit = file.NextBE<uint16_t>();
+	sgGameInitInfo.nItemLimit = file.NextBE<uint16_t>();
+	sgGameInitInfo.nObjectLimit = file.NextBE<uint16_t>();
+	sgGameInitInfo.nLightLimit = file.NextLE<uint8_t>();
+	sgGameInitInfo.nVisionLimit = file.NextLE<uint8_t>();
+	if (sgGameInitInfo.nMonsterLimit > MAXMONSTERS || sgGameInitInfo.nMissileLimit > MAXMISSILES || sgGameInitInfo.nItemLimit > MAXITEMS
+	    || sgGameInitInfo.nObjectLimit > MAXOBJECTS || sgGameInitInfo.nLightLimit > MAXLIGHTS || sgGameInitInfo.nVisionLimit > MAXVISION)
+		app_fatal("%s", "Save file uses higher entity limits than this build supports");
+}
+
+void SaveEntityLimits(SaveHelper &file)
+{
+	file.WriteBE<uint16_t>(sgGameInitInfo.nMonsterLimit);
+	file.WriteBE<uint16_t>(sgGameInitInfo.nMissileLimit);
+	file.WriteBE<uint16_t>(sgGameInitInfo.nItemLimit);
+	file.WriteBE<uint16_t>(sgGameInitInfo.nObjectLimit);
+	file.WriteLE<uint8_t>(sgGameInitInfo.nLightLimit);
+	file.WriteLE<uint8_t>(sgGameInitInfo.nVisionLimit);
+}
+
+/**
+ * @brief Reads an item or object id, version 1 saves stored those in a byte
+ */
+int LoadEntityId(LoadHelper &file, uint32_t version)
+{
+	if (version == 1)
+		return file.NextLE<int8_t>();
+	return file.NextLE<int16_t>();
+}
+
+/**
+ * @brief Reads the active and free lists of a pool
+ *
+ * Slots the pool gained since the save was written are put at the end of the free list.
+ * @param savedSize Number of slots the pool had when it was saved
+ * @param poolSize Number of slots the pool has now
+ * @param activeCount Number of entries in use
+ */
+void LoadPoolIds(LoadHelper &file, uint32_t version, int savedSize, int poolSize, int activeCount, int *activeIds, int *availableIds)
+{
+	for (int i = 0; i < savedSize; i++)
+		activeIds[i] = LoadEntityId(file, version);
+	for (int i = 0; i < savedSize; i++)
+		availableIds[i] = LoadEntityId(file, version);
+	for (int id = savedSize; id < poolSize; id++)
+		availableIds[id - activeCount] = id;
+}
+
+void SavePoolIds(SaveHelper &file, int poolSize, const int *activeIds, const int *availableIds)
+{
+	for (int i = 0; i < poolSize; i++)
+		file.WriteLE<int16_t>(activeIds[i]);
+	for (int i = 0; i < poolSize; i++)
+		file.WriteLE<int16_t>(availableIds[i]);
+}
+
+/**
+ * @brief Reads the monster order, monsters added since the save was written come last
+ */
+void LoadActiveMonsters(LoadHelper &file, int savedSize)
+{
+	for (int i = 0; i < savedSize; i++)
+		ActiveMonsters[i] = file.NextBE<int32_t>();
+	for (int i = savedSize; i < MAXMONSTERS; i++)
+		ActiveMonsters[i] = i;
+}
+
+/**
+ * @brief Reads the light order, lights added since the save was written come last
+ */
+void LoadActiveLights(LoadHelper &file, int savedSize)
+{
+	for (int i = 0; i < savedSize; i++)
+		ActiveLights[i] = file.NextLE<uint8_t>();
+	for (int i = savedSize; i < MAXLIGHTS; i++)
+		ActiveLights[i] = i;
+}
+
+void LoadItemGrid(LoadHelper &file, uint32_t version)
+{
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			dItem[i][j] = LoadEntityId(file, version);
+	}
+}
+
+void LoadObjectGrid(LoadHelper &file, uint32_t version)
+{
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			dObject[i][j] = LoadEntityId(file, version);
+	}
+}
+
+void SaveItemGrid(SaveHelper &file)
+{
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			file.WriteLE<int16_t>(dItem[i][j]);
+	}
+}
+
+void SaveObjectGrid(SaveHelper &file)
+{
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			file.WriteLE<int16_t>(dObject[i][j]);
+	}
+}
 
 } // namespace
 
 bool IsHeaderValid(uint32_t magicNumber)
 {
-	return magicNumber == LoadLE32("HELF");
+	return magicNumber == LoadLE32("HELF") || magicNumber == LoadLE32("HELV");
 }
 
 void LoadHotkeys()
@@ -1424,6 +1631,7 @@ void RemoveEmptyInventory(Player &player)
 
 void LoadGame(bool firstflag)
 {
+	CancelLevelPregeneration();
 	FreeGameMem();
 	pfile_remove_temp_files();
 
@@ -1431,8 +1639,14 @@ void LoadGame(bool firstflag)
 	if (!file.IsValid())
 		app_fatal("%s", "Unable to open save file archive");
 
-	if (!IsHeaderValid(file.NextLE<uint32_t>()))
+	uint32_t magicNumber = file.NextLE<uint32_t>();
+	if (!IsHeaderValid(magicNumber))
 		app_fatal("%s", "Invalid save file");
+	uint32_t version = magicNumber == LoadLE32("HELF") ? 1 : file.NextLE<uint32_t>();
+	if (version > SaveVersion)
+		app_fatal("%s", "Save file is from a newer version of the game");
+	PoolSizes poolSizes = LoadPoolSizes(file, version);
+	LoadEntityLimits(file, version);
 
 	giNumberOfLevels = 25;
 	giNumberQuests = 24;
@@ -1473,28 +1687,24 @@ void LoadGame(bool firstflag)
 
 	ViewPosition = { viewX, viewY };
 	ActiveMonsterCount = tmpNummonsters;
+	InvalidateMonsterIndex();
 	ActiveItemCount = tmpNumitems;
 	ActiveMissileCount = tmpNummissiles;
 	ActiveObjectCount = tmpNobjects;
 
 	for (int &monstkill : MonsterKillCounts)
 		monstkill = file.NextBE<int32_t>();
+	if (version == 1)
+		file.Skip((Version1PoolSizes.monsters - NUM_MTYPES) * sizeof(int32_t)); // Kill counts used to be kept per monster slot
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int &monsterId : ActiveMonsters)
-			monsterId = file.NextBE<int32_t>();
+		LoadActiveMonsters(file, poolSizes.monsters);
 		for (int i = 0; i < ActiveMonsterCount; i++)
-			LoadMonster(&file, Monsters[ActiveMonsters[i]]);
-		for (int &missileId : ActiveMissiles)
-			missileId = file.NextLE<int8_t>();
-		for (int &missileId : AvailableMissiles)
-			missileId = file.NextLE<int8_t>();
+			LoadMonster(&file, Monsters[ActiveMonsters[i]], version);
+		LoadPoolIds(file, version, poolSizes.missiles, MAXMISSILES, ActiveMissileCount, ActiveMissiles, AvailableMissiles);
 		for (int i = 0; i < ActiveMissileCount; i++)
 			LoadMissile(&file, Missiles[ActiveMissiles[i]]);
-		for (int &objectId : ActiveObjects)
-			objectId = file.NextLE<int8_t>();
-		for (int &objectId : AvailableObjects)
-			objectId = file.NextLE<int8_t>();
+		LoadPoolIds(file, version, poolSizes.objects, MAXOBJECTS, ActiveObjectCount, ActiveObjects, AvailableObjects);
 		for (int i = 0; i < ActiveObjectCount; i++)
 			LoadObject(file, Objects[ActiveObjects[i]]);
 		for (int i = 0; i < ActiveObjectCount; i++)
@@ -1502,8 +1712,7 @@ void LoadGame(bool firstflag)
 
 		ActiveLightCount = file.NextBE<int32_t>();
 
-		for (uint8_t &lightId : ActiveLights)
-			lightId = file.NextLE<uint8_t>();
+		LoadActiveLights(file, poolSizes.lights);
 		for (int i = 0; i < ActiveLightCount; i++)
 			LoadLighting(&file, &Lights[ActiveLights[i]]);
 
@@ -1514,10 +1723,7 @@ void LoadGame(bool firstflag)
 			LoadLighting(&file, &VisionList[i]);
 	}
 
-	for (int &itemId : ActiveItems)
-		itemId = file.NextLE<int8_t>();
-	for (int &itemId : AvailableItems)
-		itemId = file.NextLE<int8_t>();
+	LoadPoolIds(file, version, poolSizes.items, MAXITEMS, ActiveItemCount, ActiveItems, AvailableItems);
 	for (int i = 0; i < ActiveItemCount; i++)
 		LoadItem(file, Items[ActiveItems[i]]);
 	for (bool &uniqueItemFlag : UniqueItemFlags)
@@ -1535,10 +1741,7 @@ void LoadGame(bool firstflag)
 		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
 			dPlayer[i][j] = file.NextLE<int8_t>();
 	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			dItem[i][j] = file.NextLE<int8_t>();
-	}
+	LoadItemGrid(file, version);
 
 	if (leveltype != DTYPE_TOWN) {
 		for (int j = 0; j < MAXDUNY; j++) {
@@ -1549,10 +1752,7 @@ void LoadGame(bool firstflag)
 			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
 				dCorpse[i][j] = file.NextLE<int8_t>();
 		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dObject[i][j] = file.NextLE<int8_t>();
-		}
+		LoadObjectGrid(file, version);
 		for (int j = 0; j < MAXDUNY; j++) {
 			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
 				dLight[i][j] = file.NextLE<int8_t>();
@@ -1613,15 +1813,14 @@ void SaveHeroItems(Player &player)
 		SaveItem(file, item);
 }
 
-// 256 kilobytes + 3 bytes (demo leftover) for file magic (262147)
-// final game uses 4-byte magic instead of 3
-#define FILEBUFF ((256 * 1024) + 3)
-
 void SaveGameData()
 {
-	SaveHelper file("game", FILEBUFF);
+	SaveHelper file("game", SaveBufferSize);
 
-	file.WriteLE<uint32_t>(LoadLE32("HELF"));
+	file.WriteLE<uint32_t>(LoadLE32("HELV"));
+	file.WriteLE<uint32_t>(SaveVersion);
+	SavePoolSizes(file);
+	SaveEntityLimits(file);
 
 	giNumberOfLevels = 25;
 	giNumberQuests = 24;
@@ -1660,16 +1859,10 @@ void SaveGameData()
 			file.WriteBE<int32_t>(monsterId);
 		for (int i = 0; i < ActiveMonsterCount; i++)
 			SaveMonster(&file, Monsters[ActiveMonsters[i]]);
-		for (int missileId : ActiveMissiles)
-			file.WriteLE<int8_t>(missileId);
-		for (int missileId : AvailableMissiles)
-			file.WriteLE<int8_t>(missileId);
+		SavePoolIds(file, MAXMISSILES, ActiveMissiles, AvailableMissiles);
 		for (int i = 0; i < ActiveMissileCount; i++)
 			SaveMissile(&file, Missiles[ActiveMissiles[i]]);
-		for (int objectId : ActiveObjects)
-			file.WriteLE<int8_t>(objectId);
-		for (int objectId : AvailableObjects)
-			file.WriteLE<int8_t>(objectId);
+		SavePoolIds(file, MAXOBJECTS, ActiveObjects, AvailableObjects);
 		for (int i = 0; i < ActiveObjectCount; i++)
 			SaveObject(file, Objects[ActiveObjects[i]]);
 
@@ -1687,10 +1880,7 @@ void SaveGameData()
 			SaveLighting(&file, &VisionList[i]);
 	}
 
-	for (int itemId : ActiveItems)
-		file.WriteLE<int8_t>(itemId);
-	for (int itemId : AvailableItems)
-		file.WriteLE<int8_t>(itemId);
+	SavePoolIds(file, MAXITEMS, ActiveItems, AvailableItems);
 	for (int i = 0; i < ActiveItemCount; i++)
 		SaveItem(file, Items[ActiveItems[i]]);
 	for (bool uniqueItemFlag : UniqueItemFlags)
@@ -1708,10 +1898,7 @@ void SaveGameData()
 		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
 			file.WriteLE<int8_t>(dPlayer[i][j]);
 	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			file.WriteLE<int8_t>(dItem[i][j]);
-	}
+	SaveItemGrid(file);
 
 	if (leveltype != DTYPE_TOWN) {
 		for (int j = 0; j < MAXDUNY; j++) {
@@ -1722,10 +1909,7 @@ void SaveGameData()
 			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
 				file.WriteLE<int8_t>(dCorpse[i][j]);
 		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<int8_t>(dObject[i][j]);
-		}
+		SaveObjectGrid(file);
 		for (int j = 0; j < MAXDUNY; j++) {
 			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
 				file.WriteLE<int8_t>(dLight[i][j]);
@@ -1773,7 +1957,11 @@ void SaveLevel()
 
 	char szName[MAX_PATH];
 	GetTempLevelNames(szName);
-	SaveHelper file(szName, FILEBUFF);
+	SaveHelper file(szName, SaveBufferSize);
+
+	file.WriteLE<uint32_t>(LoadLE32("LVLV"));
+	file.WriteLE<uint32_t>(SaveVersion);
+	SavePoolSizes(file);
 
 	if (leveltype != DTYPE_TOWN) {
 		for (int j = 0; j < MAXDUNY; j++) {
@@ -1791,18 +1979,12 @@ void SaveLevel()
 			file.WriteBE<int32_t>(monsterId);
 		for (int i = 0; i < ActiveMonsterCount; i++)
 			SaveMonster(&file, Monsters[ActiveMonsters[i]]);
-		for (int objectId : ActiveObjects)
-			file.WriteLE<int8_t>(objectId);
-		for (int objectId : AvailableObjects)
-			file.WriteLE<int8_t>(objectId);
+		SavePoolIds(file, MAXOBJECTS, ActiveObjects, AvailableObjects);
 		for (int i = 0; i < ActiveObjectCount; i++)
 			SaveObject(file, Objects[ActiveObjects[i]]);
 	}
 
-	for (int itemId : ActiveItems)
-		file.WriteLE<int8_t>(itemId);
-	for (int itemId : AvailableItems)
-		file.WriteLE<int8_t>(itemId);
+	SavePoolIds(file, MAXITEMS, ActiveItems, AvailableItems);
 
 	for (int i = 0; i < ActiveItemCount; i++)
 		SaveItem(file, Items[ActiveItems[i]]);
@@ -1811,20 +1993,14 @@ void SaveLevel()
 		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
 			file.WriteLE<int8_t>(dFlags[i][j] & ~(BFLAG_MISSILE | BFLAG_VISIBLE | BFLAG_DEAD_PLAYER));
 	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			file.WriteLE<int8_t>(dItem[i][j]);
-	}
+	SaveItemGrid(file);
 
 	if (leveltype != DTYPE_TOWN) {
 		for (int j = 0; j < MAXDUNY; j++) {
 			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
 				file.WriteBE<int32_t>(dMonster[i][j]);
 		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<int8_t>(dObject[i][j]);
-		}
+		SaveObjectGrid(file);
 		for (int j = 0; j < MAXDUNY; j++) {
 			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
 				file.WriteLE<int8_t>(dLight[i][j]);
@@ -1853,6 +2029,11 @@ void LoadLevel()
 	if (!file.IsValid())
 		app_fatal("%s", "Unable to open save file archive");
 
+	uint32_t version = LoadLevelVersion(file);
+	if (version > SaveVersion)
+		app_fatal("%s", "Save file is from a newer version of the game");
+	PoolSizes poolSizes = LoadPoolSizes(file, version);
+
 	if (leveltype != DTYPE_TOWN) {
 		for (int j = 0; j < MAXDUNY; j++) {
 			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
@@ -1862,28 +2043,22 @@ void LoadLevel()
 	}
 
 	ActiveMonsterCount = file.NextBE<int32_t>();
+	InvalidateMonsterIndex();
 	ActiveItemCount = file.NextBE<int32_t>();
 	ActiveObjectCount = file.NextBE<int32_t>();
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int &monsterId : ActiveMonsters)
-			monsterId = file.NextBE<int32_t>();
+		LoadActiveMonsters(file, poolSizes.monsters);
 		for (int i = 0; i < ActiveMonsterCount; i++)
-			LoadMonster(&file, Monsters[ActiveMonsters[i]]);
-		for (int &objectId : ActiveObjects)
-			objectId = file.NextLE<int8_t>();
-		for (int &objectId : AvailableObjects)
-			objectId = file.NextLE<int8_t>();
+			LoadMonster(&file, Monsters[ActiveMonsters[i]], version);
+		LoadPoolIds(file, version, poolSizes.objects, MAXOBJECTS, ActiveObjectCount, ActiveObjects, AvailableObjects);
 		for (int i = 0; i < ActiveObjectCount; i++)
 			LoadObject(file, Objects[ActiveObjects[i]]);
 		for (int i = 0; i < ActiveObjectCount; i++)
 			SyncObjectAnim(Objects[ActiveObjects[i]]);
 	}
 
-	for (int &itemId : ActiveItems)
-		itemId = file.NextLE<int8_t>();
-	for (int &itemId : AvailableItems)
-		itemId = file.NextLE<int8_t>();
+	LoadPoolIds(file, version, poolSizes.items, MAXITEMS, ActiveItemCount, ActiveItems, AvailableItems);
 	for (int i = 0; i < ActiveItemCount; i++)
 		LoadItem(file, Items[ActiveItems[i]]);
 
@@ -1891,20 +2066,14 @@ void LoadLevel()
 		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
 			dFlags[i][j] = file.NextLE<int8_t>() & ~(BFLAG_PLAYERLR | BFLAG_MONSTLR);
 	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			dItem[i][j] = file.NextLE<int8_t>();
-	}
+	LoadItemGrid(file, version);
 
 	if (leveltype != DTYPE_TOWN) {
 		for (int j = 0; j < MAXDUNY; j++) {
 			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
 				dMonster[i][j] = file.NextBE<int32_t>();
 		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dObject[i][j] = file.NextLE<int8_t>();
-		}
+		LoadObjectGrid(file, version);
 		for (int j = 0; j < MAXDUNY; j++) {
 			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
 				dLight[i][j] = file.NextLE<int8_t>();
@@ -43,6 +43,12 @@ void FocusOnCharInfo();
 bool GetAsyncKeyState(int vKey);
 
 bool FetchMessage(tagMSG *lpMsg);
+/**
+ * @brief Sleeps until a message is available for FetchMessage
+ * @param timeout Longest time to wait in milliseconds
+ * @return False if the time ran out without a message arriving
+ */
+bool WaitForMessage(uint32_t timeout);
 
 bool TranslateMessage(const tagMSG *lpMsg);
 void PushMessage(const tagMSG *lpMsg);
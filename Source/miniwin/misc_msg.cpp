@@ -247,6 +247,14 @@ bool FalseAvail(const char *name, int value)
 
 } // namespace
 
+bool WaitForMessage(uint32_t timeout)
+{
+	if (!message_queue.empty())
+		return true;
+
+	return SDL_WaitEventTimeout(nullptr, timeout) != 0;
+}
+
 bool FetchMessage(tagMSG *lpMsg)
 {
 	if (!message_queue.empty()) {
@@ -20,6 +20,7 @@
 #include "inv.h"
 #include "lighting.h"
 #include "monster.h"
+#include "options.h"
 #include "spells.h"
 #include "trigs.h"
 
@@ -206,7 +207,7 @@ bool MonsterMHit(int pnum, int m, Damage damage, int dist, missile_id t, bool sh
 	bool resist = false;
 	if (monster.mtalkmsg != TEXT_NONE
 	    || monster._mhitpoints >> 6 <= 0
-	    || (t == MIS_HBOLT && monster.MType->mtype != MT_DIABLO && monster.MData->mMonstClass != MonsterClass::Undead)) {
+	    || (t == MIS_HBOLT && monster.MType->mtype != MT_DIABLO && monster.Stats().MData->mMonstClass != MonsterClass::Undead)) {
 		return false;
 	}
 	if (monster.MType->mtype == MT_ILLWEAV && monster._mgoal == MGOAL_RETREAT)
@@ -214,7 +215,7 @@ bool MonsterMHit(int pnum, int m, Damage damage, int dist, missile_id t, bool sh
 	if (monster._mmode == MonsterMode::Charge)
 		return false;
 
-	uint8_t mor = monster.mMagicRes;
+	uint8_t mor = monster.Stats().mMagicRes;
 	missile_resistance mir = MissilesData[t].mResist;
 
 	if (((mor & IMMUNE_MAGIC) != 0 && mir == MISR_MAGIC)
@@ -234,13 +235,13 @@ bool MonsterMHit(int pnum, int m, Damage damage, int dist, missile_id t, bool sh
 		const auto &player = Players[pnum];
 		if (MissilesData[t].mType == 0) {
 			hper = player.GetRangedToHit();
-			hper -= player.CalculateArmorPierce(monster.mArmorClass, false);
+			hper -= player.CalculateArmorPierce(monster.Stats().mArmorClass, false);
 			hper -= (dist * dist) / 2;
 		} else {
-			hper = player.GetMagicToHit() - (monster.mLevel * 2) - dist;
+			hper = player.GetMagicToHit() - (monster.Stats().mLevel * 2) - dist;
 		}
 	} else {
-		hper = GenerateRnd(75) - monster.mLevel * 2;
+		hper = GenerateRnd(75) - monster.Stats().mLevel * 2;
 	}
 
 	hper = std::clamp(hper, 5, 95);
@@ -1039,7 +1040,7 @@ bool MonsterTrapHit(int m, Damage damage, int dist, missile_id t, bool shift)
 		return false;
 
 	missile_resistance mir = MissilesData[t].mResist;
-	int mor = monster.mMagicRes;
+	int mor = monster.Stats().mMagicRes;
 	if (((mor & IMMUNE_MAGIC) != 0 && mir == MISR_MAGIC)
 	    || ((mor & IMMUNE_FIRE) != 0 && mir == MISR_FIRE)
 	    || ((mor & IMMUNE_LIGHTNING) != 0 && mir == MISR_LIGHTNING)) {
@@ -1053,7 +1054,7 @@ bool MonsterTrapHit(int m, Damage damage, int dist, missile_id t, bool shift)
 	}
 
 	int hit = GenerateRnd(100);
-	int hper = 90 - (BYTE)monster.mArmorClass - dist;
+	int hper = 90 - (BYTE)monster.Stats().mArmorClass - dist;
 	hper = std::clamp(hper, 5, 95);
 	bool ret;
 	if (CheckMonsterHit(monster, &ret)) {
@@ -1126,15 +1127,15 @@ bool PlayerMHit(int pnum, Monster *monster, int dist, Damage damage, missile_id
 	if (MissilesData[mtype].mType == 0) {
 		int tac = player.GetArmor();
 		if (monster != nullptr) {
-			hper = monster->mHit
-			    + ((monster->mLevel - player._pLevel) * 2)
+			hper = monster->Stats().mHit
+			    + ((monster->Stats().mLevel - player._pLevel) * 2)
 			    + 30
 			    - (dist * 2) - tac;
 		} else {
 			hper = 100 - (tac / 2) - (dist * 2);
 		}
 	} else if (monster != nullptr) {
-		hper += (monster->mLevel * 2) - (player._pLevel * 2) - (dist * 2);
+		hper += (monster->Stats().mLevel * 2) - (player._pLevel * 2) - (dist * 2);
 	}
 
 	int minhit = 10;
@@ -1158,7 +1159,7 @@ bool PlayerMHit(int pnum, Monster *monster, int dist, Damage damage, missile_id
 
 	int blkper = player.GetBlockChance(false);
 	if (monster != nullptr)
-		blkper -= (monster->mLevel - player._pLevel) * 2;
+		blkper -= (monster->Stats().mLevel - player._pLevel) * 2;
 	blkper = std::clamp(blkper, 0, 100);
 
 	int8_t resper;
@@ -1369,13 +1370,13 @@ void AddBerserk(Missile &missile, Point dst, Direction /*midir*/)
 				continue;
 			auto &monster = Monsters[dm];
 
-			if (monster._uniqtype != 0 || monster._mAi == AI_DIABLO)
+			if (monster.Stats()._uniqtype != 0 || monster._mAi == AI_DIABLO)
 				continue;
 			if (monster._mmode == AnyOf(MonsterMode::FadeIn, MonsterMode::FadeOut))
 				continue;
-			if ((monster.mMagicRes & IMMUNE_MAGIC) != 0)
+			if ((monster.Stats().mMagicRes & IMMUNE_MAGIC) != 0)
 				continue;
-			if ((monster.mMagicRes & RESIST_MAGIC) != 0 && ((monster.mMagicRes & RESIST_MAGIC) != 1 || GenerateRnd(2) != 0))
+			if ((monster.Stats().mMagicRes & RESIST_MAGIC) != 0 && ((monster.Stats().mMagicRes & RESIST_MAGIC) != 1 || GenerateRnd(2) != 0))
 				continue;
 			if (monster._mmode == MonsterMode::Charge)
 				continue;
@@ -1383,8 +1384,9 @@ void AddBerserk(Missile &missile, Point dst, Direction /*midir*/)
 			i = 6;
 			auto slvl = GetSpellLevel(missile._misource, SPL_BERSERK);
 			monster._mFlags |= MFLAG_BERSERK | MFLAG_GOLEM;
-			monster.mDamage = { (GenerateRnd(10) + 120) * monster.mDamage.minValue / 100 + slvl, (GenerateRnd(10) + 120) * monster.mDamage.maxValue / 100 + slvl };
-			monster.mDamage2 = { (GenerateRnd(10) + 120) * monster.mDamage2.minValue / 100 + slvl, (GenerateRnd(10) + 120) * monster.mDamage2.maxValue / 100 + slvl };
+			InvalidateMonsterIndex();
+			monster.Stats().mDamage = { (GenerateRnd(10) + 120) * monster.Stats().mDamage.minValue / 100 + slvl, (GenerateRnd(10) + 120) * monster.Stats().mDamage.maxValue / 100 + slvl };
+			monster.Stats().mDamage2 = { (GenerateRnd(10) + 120) * monster.Stats().mDamage2.minValue / 100 + slvl, (GenerateRnd(10) + 120) * monster.Stats().mDamage2.maxValue / 100 + slvl };
 			int r = (currlevel < 17 || currlevel > 20) ? 3 : 9;
 			monster.mlid = AddLight(monster.position.tile, r);
 			UseMana(missile._misource, SPL_BERSERK);
@@ -2087,7 +2089,7 @@ void AddFlash(Missile &missile, Point /*dst*/, Direction /*midir*/)
 			missile._midam += missile._midam / 2;
 			UseMana(missile._misource, SPL_FLASH);
 		} else {
-			missile._midam = Monsters[missile._misource].mLevel * 2;
+			missile._midam = Monsters[missile._misource].Stats().mLevel * 2;
 		}
 	} else {
 		missile._midam = currlevel / 2;
@@ -2230,8 +2232,8 @@ void AddRhino(Missile &missile, Point dst, Direction midir)
 	InitMissileAnimationFromMonster(missile, midir, monster, graphic);
 	if (monster.MType->mtype >= MT_NSNAKE && monster.MType->mtype <= MT_GSNAKE)
 		missile._miAnimFrame = 7;
-	if (monster._uniqtype != 0) {
-		missile._miUniqTrans = monster._uniqtrans + 1;
+	if (monster.Stats()._uniqtype != 0) {
+		missile._miUniqTrans = monster.Stats()._uniqtrans + 1;
 		missile._mlid = monster.mlid;
 	}
 	PutMissile(missile);
@@ -2606,7 +2608,7 @@ void AddFlame(Missile &missile, Point dst, Direction /*midir*/)
 		missile._midam = 8 * i + 16 + ((8 * i + 16) / 2);
 	} else {
 		auto &monster = Monsters[missile._misource];
-		missile._midam = monster.mDamage.GetValue();
+		missile._midam = monster.Stats().mDamage.GetValue();
 	}
 }
 
@@ -2728,7 +2730,7 @@ void AddDiabApoca(Missile &missile, Point /*dst*/, Direction /*midir*/)
 
 int AddMissile(Point src, Point dst, Direction midir, missile_id mitype, mienemy_type micaster, int id, int midam, int spllvl)
 {
-	if (ActiveMissileCount >= MAXMISSILES - 1)
+	if (ActiveMissileCount >= sgGameInitInfo.nMissileLimit - 1)
 		return -1;
 
 	int mi = AvailableMissiles[0];
@@ -2801,7 +2803,7 @@ void MI_LArrow(Missile &missile)
 			if (missile._micaster == TARGET_MONSTERS) {
 				damage = Players[p]._pIDamage;
 			} else {
-				damage = Monsters[p].mDamage;
+				damage = Monsters[p].Stats().mDamage;
 			}
 		} else {
 			damage = { GenerateRnd(10) + 1 + currlevel, GenerateRnd(10) + 1 + currlevel * 2 };
@@ -2846,7 +2848,7 @@ void MI_Arrow(Missile &missile)
 		if (missile._micaster == TARGET_MONSTERS) {
 			damage = Players[p]._pIDamage;
 		} else {
-			damage = Monsters[p].mDamage;
+			damage = Monsters[p].Stats().mDamage;
 		}
 	} else {
 		damage = { currlevel, 2 * currlevel };
@@ -2882,7 +2884,7 @@ void MI_Firebolt(Missile &missile)
 				}
 			} else {
 				auto &monster = Monsters[p];
-				d = monster.mDamage.GetValue();
+				d = monster.Stats().mDamage.GetValue();
 			}
 		} else {
 			d = currlevel + GenerateRnd(2 * currlevel);
@@ -2960,7 +2962,7 @@ void MI_Lightball(Missile &missile)
 	MoveMissileAndCheckMissileCol(missile, { missile._midam }, false, false);
 	if (missile._miHitFlag)
 		missile._mirange = j;
-	int8_t obj = dObject[tx][ty];
+	int obj = dObject[tx][ty];
 	if (obj != 0 && missile.position.tile == Point { tx, ty }) {
 		int oi = (obj > 0) ? (obj - 1) : -(obj + 1);
 		if (Objects[oi]._otype == OBJ_SHRINEL || Objects[oi]._otype == OBJ_SHRINER)
@@ -3314,7 +3316,7 @@ void MI_Lightctrl(Missile &missile)
 		dam = (GenerateRnd(2) + GenerateRnd(Players[missile._misource]._pLevel) + 2) << 6;
 	} else {
 		auto &monster = Monsters[missile._misource];
-		dam = 2 * monster.mDamage.GetValue();
+		dam = 2 * monster.Stats().mDamage.GetValue();
 	}
 
 	SpawnLightning(missile, dam);
@@ -3589,7 +3591,7 @@ void MI_Acidsplat(Missile &missile)
 	if (missile._mirange == 0) {
 		missile._miDelFlag = true;
 		int monst = missile._misource;
-		int dam = (Monsters[monst].MData->mLevel >= 2 ? 2 : 1);
+		int dam = (Monsters[monst].Stats().MData->mLevel >= 2 ? 2 : 1);
 		AddMissile(missile.position.tile, { 0, 0 }, Direction::South, MIS_ACIDPUD, TARGET_PLAYERS, monst, dam, missile._mispllvl);
 	} else {
 		PutMissile(missile);
@@ -3695,7 +3697,7 @@ void MI_Rhino(Missile &missile)
 	monster.position.old = newPos;
 	monster.position.tile = newPos;
 	dMonster[newPos.x][newPos.y] = -(monst + 1);
-	if (monster._uniqtype != 0)
+	if (monster.Stats()._uniqtype != 0)
 		ChangeLightXY(missile._mlid, newPos);
 	MoveMissilePos(missile);
 	PutMissile(missile);
@@ -4153,6 +4155,7 @@ void ProcessManaShield()
 
 void ProcessMissiles()
 {
+	InvalidateMonsterIndex();
 	for (int i = 0; i < ActiveMissileCount; i++) {
 		auto &missile = Missiles[ActiveMissiles[i]];
 		const auto &position = missile.position.tile;
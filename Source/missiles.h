@@ -17,7 +17,8 @@
 
 namespace devilution {
 
-#define MAXMISSILES 125
+/** Storage for missiles, the missile limit option caps how many of them are in use */
+#define MAXMISSILES 1024
 
 constexpr Point GolemHoldingCell = Point { 1, 0 };
 
@@ -41,11 +41,11 @@ namespace devilution {
 CMonster LevelMonsterTypes[MAX_LVLMTYPES];
 int LevelMonsterTypeCount;
 Monster Monsters[MAXMONSTERS];
+MonsterStats MonstersStats[MAXMONSTERS];
 int ActiveMonsters[MAXMONSTERS];
 int ActiveMonsterCount;
-// BUGFIX: replace MonsterKillCounts[MAXMONSTERS] with MonsterKillCounts[NUM_MTYPES].
 /** Tracks the total number of monsters killed per monster_id. */
-int MonsterKillCounts[MAXMONSTERS];
+int MonsterKillCounts[NUM_MTYPES];
 bool sgbSaveSoundOn;
 
 namespace {
@@ -153,42 +153,42 @@ void InitMonster(Monster &monster, Direction rd, int mtype, Point position)
 	monster._mMTidx = mtype;
 	monster._mmode = MonsterMode::Stand;
 	monster.MType = &LevelMonsterTypes[mtype];
-	monster.MData = monster.MType->MData;
-	monster.mName = monster.MData->mName;
+	monster.Stats().MData = monster.MType->MData;
+	monster.Stats().mName = monster.Stats().MData->mName;
 	monster.AnimInfo = {};
 	monster.ChangeAnimationData(MonsterGraphic::Stand);
 	monster.AnimInfo.TickCounterOfCurrentFrame = GenerateRnd(monster.AnimInfo.TicksPerFrame - 1);
 	monster.AnimInfo.CurrentFrame = GenerateRnd(monster.AnimInfo.NumberOfFrames - 1) + 1;
 
-	monster.mLevel = monster.MData->mLevel;
+	monster.Stats().mLevel = monster.Stats().MData->mLevel;
 	monster._mmaxhp = (monster.MType->mMinHP + GenerateRnd(monster.MType->mMaxHP - monster.MType->mMinHP + 1)) << 6;
 	monster._mmaxhp = std::max(monster._mmaxhp / 2, 64);
 
 	monster._mhitpoints = monster._mmaxhp;
-	monster._mAi = monster.MData->mAi;
-	monster._mint = monster.MData->mInt;
+	monster._mAi = monster.Stats().MData->mAi;
+	monster._mint = monster.Stats().MData->mInt;
 	monster._mgoal = MGOAL_NORMAL;
 	monster._mgoalvar1 = 0;
 	monster._mgoalvar2 = 0;
 	monster._mgoalvar3 = 0;
 	monster._pathcount = 0;
 	monster._mDelFlag = false;
-	monster._uniqtype = 0;
+	monster.Stats()._uniqtype = 0;
 	monster._msquelch = 0;
 	monster.mlid = NO_LIGHT; // BUGFIX monsters initial light id should be -1 (fixed)
-	monster._mRndSeed = AdvanceRndSeed();
-	monster._mAISeed = AdvanceRndSeed();
-	monster.mWhoHit = 0;
-	monster.mExp = monster.MData->mExp;
-	monster.mHit = monster.MData->mHit;
-	monster.mDamage = monster.MData->mDamage;
-	monster.mHit2 = monster.MData->mHit2;
-	monster.mDamage2 = monster.MData->mDamage2;
-	monster.mArmorClass = monster.MData->mArmorClass;
-	monster.mMagicRes = monster.MData->mMagicRes;
+	monster.Stats()._mRndSeed = AdvanceRndSeed();
+	monster.Stats()._mAISeed = AdvanceRndSeed();
+	monster.Stats().mWhoHit = 0;
+	monster.Stats().mExp = monster.Stats().MData->mExp;
+	monster.Stats().mHit = monster.Stats().MData->mHit;
+	monster.Stats().mDamage = monster.Stats().MData->mDamage;
+	monster.Stats().mHit2 = monster.Stats().MData->mHit2;
+	monster.Stats().mDamage2 = monster.Stats().MData->mDamage2;
+	monster.Stats().mArmorClass = monster.Stats().MData->mArmorClass;
+	monster.Stats().mMagicRes = monster.Stats().MData->mMagicRes;
 	monster.leader = 0;
 	monster.leaderRelation = LeaderRelation::None;
-	monster._mFlags = monster.MData->mFlags;
+	monster._mFlags = monster.Stats().MData->mFlags;
 	monster.mtalkmsg = TEXT_NONE;
 
 	if (monster._mAi == AI_GARG) {
@@ -414,24 +414,24 @@ void PlaceUniqueMonst(int uniqindex, int miniontype, int bosspacksize)
 		UberDiabloMonsterIndex = ActiveMonsterCount;
 	}
 	PlaceMonster(ActiveMonsterCount, uniqtype, xp, yp);
-	monster._uniqtype = uniqindex + 1;
+	monster.Stats()._uniqtype = uniqindex + 1;
 
 	if (uniqueMonsterData.mlevel != 0) {
-		monster.mLevel = 2 * uniqueMonsterData.mlevel;
+		monster.Stats().mLevel = 2 * uniqueMonsterData.mlevel;
 	} else {
-		monster.mLevel = monster.MData->mLevel + 5;
+		monster.Stats().mLevel = monster.Stats().MData->mLevel + 5;
 	}
 
-	monster.mExp *= 2;
-	monster.mName = uniqueMonsterData.mName;
+	monster.Stats().mExp *= 2;
+	monster.Stats().mName = uniqueMonsterData.mName;
 	monster._mmaxhp = uniqueMonsterData.mmaxhp << 6;
 	monster._mmaxhp = std::max(monster._mmaxhp / 2, 64);
 	monster._mhitpoints = monster._mmaxhp;
 	monster._mAi = uniqueMonsterData.mAi;
 	monster._mint = uniqueMonsterData.mint;
-	monster.mDamage = uniqueMonsterData.mDamage;
-	monster.mDamage2 = uniqueMonsterData.mDamage;
-	monster.mMagicRes = uniqueMonsterData.mMagicRes;
+	monster.Stats().mDamage = uniqueMonsterData.mDamage;
+	monster.Stats().mDamage2 = uniqueMonsterData.mDamage;
+	monster.Stats().mMagicRes = uniqueMonsterData.mMagicRes;
 	monster.mtalkmsg = uniqueMonsterData.mtalkmsg;
 	if (uniqindex == UMT_HORKDMN)
 		monster.mlid = NO_LIGHT; // BUGFIX monsters initial light id should be -1 (fixed)
@@ -446,14 +446,14 @@ void PlaceUniqueMonst(int uniqindex, int miniontype, int bosspacksize)
 	sprintf(filestr, "Monsters\\Monsters\\%s.TRN", uniqueMonsterData.mTrnName);
 	LoadFileInMem(filestr, &LightTables[256 * (uniquetrans + 19)], 256);
 
-	monster._uniqtrans = uniquetrans++;
+	monster.Stats()._uniqtrans = uniquetrans++;
 
 	if (uniqueMonsterData.customHitpoints != 0) {
-		monster.mHit = uniqueMonsterData.customHitpoints;
-		monster.mHit2 = uniqueMonsterData.customHitpoints;
+		monster.Stats().mHit = uniqueMonsterData.customHitpoints;
+		monster.Stats().mHit2 = uniqueMonsterData.customHitpoints;
 	}
 	if (uniqueMonsterData.customArmorClass != 0) {
-		monster.mArmorClass = uniqueMonsterData.customArmorClass;
+		monster.Stats().mArmorClass = uniqueMonsterData.customArmorClass;
 	}
 
 	ActiveMonsterCount++;
@@ -505,9 +505,10 @@ void ClearMVars(Monster &monster)
 
 void ClrAllMonsters()
 {
+	InvalidateMonsterIndex();
 	for (auto &monster : Monsters) {
 		ClearMVars(monster);
-		monster.mName = "Invalid Monster";
+		monster.Stats().mName = "Invalid Monster";
 		monster._mgoal = MGOAL_NONE;
 		monster._mmode = MonsterMode::Stand;
 		monster._mVar1 = 0;
@@ -600,7 +601,7 @@ void PlaceQuestMonsters()
 			if (i1 < LevelMonsterTypeCount) {
 				for (int i2 = 0; i2 < ActiveMonsterCount; i2++) {
 					auto &monster = Monsters[i2];
-					if (monster._uniqtype != 0 || monster._mMTidx == i1) {
+					if (monster.Stats()._uniqtype != 0 || monster._mMTidx == i1) {
 						UberDiabloMonsterIndex = i2;
 						break;
 					}
@@ -636,6 +637,7 @@ void LoadDiabMonsts()
 
 void DeleteMonster(int i)
 {
+	InvalidateMonsterIndex();
 	ActiveMonsterCount--;
 	std::swap(ActiveMonsters[i], ActiveMonsters[ActiveMonsterCount]); // This ensures alive monsters are before ActiveMonsterCount in the array and any deleted monster after
 }
@@ -669,6 +671,45 @@ bool IsRanged(Monster &monster)
 	return monster._mAi == AnyOf(AI_SKELBOW, AI_GOATBOW, AI_SUCC, AI_LAZHELP);
 }
 
+/**
+ * @brief The golems and berserk monsters among the active monsters, the only ones regular monsters ever fight
+ *
+ * Only depends on the monster flags and the order of ActiveMonsters, not on where the monsters are.
+ */
+struct MonsterIndex {
+	bool valid;
+	/** ActiveMonsterCount at the time of the build, monsters added after that are checked separately */
+	int indexedCount;
+	/** Golems and berserk monsters in ActiveMonsters order */
+	uint16_t golemSide[MAXMONSTERS];
+	int golemSideCount;
+};
+
+MonsterIndex ActiveMonsterIndex;
+
+void BuildMonsterIndex()
+{
+	MonsterIndex &index = ActiveMonsterIndex;
+	index.golemSideCount = 0;
+
+	for (int j = 0; j < ActiveMonsterCount; j++) {
+		int mi = ActiveMonsters[j];
+		if ((Monsters[mi]._mFlags & MFLAG_GOLEM) != 0)
+			index.golemSide[index.golemSideCount++] = mi;
+	}
+
+	index.indexedCount = ActiveMonsterCount;
+	index.valid = true;
+}
+
+MonsterIndex &GetMonsterIndex()
+{
+	// Monsters are only appended between rebuilds, fewer of them means the list was reset
+	if (!ActiveMonsterIndex.valid || ActiveMonsterCount < ActiveMonsterIndex.indexedCount)
+		BuildMonsterIndex();
+	return ActiveMonsterIndex;
+}
+
 void UpdateEnemy(Monster &monster)
 {
 	Point target;
@@ -694,19 +735,20 @@ void UpdateEnemy(Monster &monster)
 			}
 		}
 	}
-	for (int j = 0; j < ActiveMonsterCount; j++) {
-		int mi = ActiveMonsters[j];
+
+	// Candidates have to be visited in ActiveMonsters order, ties in distance go to the first one
+	const auto considerMonster = [&](int mi) {
 		auto &otherMonster = Monsters[mi];
 		if (&otherMonster == &monster)
-			continue;
+			return;
 		if ((otherMonster._mhitpoints >> 6) <= 0)
-			continue;
+			return;
 		if (otherMonster.position.tile == GolemHoldingCell)
-			continue;
+			return;
 		if (M_Talker(otherMonster) && otherMonster.mtalkmsg != TEXT_NONE)
-			continue;
+			return;
 		if ((monster._mFlags & MFLAG_GOLEM) != 0 && (otherMonster._mFlags & MFLAG_GOLEM) != 0) // prevent golems from fighting each other
-			continue;
+			return;
 
 		int dist = otherMonster.position.tile.WalkingDistance(position);
 		if (((monster._mFlags & MFLAG_GOLEM) == 0
@@ -716,7 +758,7 @@ void UpdateEnemy(Monster &monster)
 		    || ((monster._mFlags & MFLAG_GOLEM) == 0
 		        && (monster._mFlags & MFLAG_BERSERK) == 0
 		        && (otherMonster._mFlags & MFLAG_GOLEM) == 0)) {
-			continue;
+			return;
 		}
 		bool sameroom = dTransVal[position.x][position.y] == dTransVal[otherMonster.position.tile.x][otherMonster.position.tile.y];
 		if ((sameroom && !bestsameroom)
@@ -728,7 +770,21 @@ void UpdateEnemy(Monster &monster)
 			bestDist = dist;
 			bestsameroom = sameroom;
 		}
+	};
+
+	if ((monster._mFlags & MFLAG_GOLEM) == 0) {
+		// Other monsters only ever fight golems and berserk monsters
+		const MonsterIndex &index = GetMonsterIndex();
+		for (int i = 0; i < index.golemSideCount; i++)
+			considerMonster(index.golemSide[i]);
+		for (int j = index.indexedCount; j < ActiveMonsterCount; j++)
+			considerMonster(ActiveMonsters[j]);
+	} else {
+		// Golems and berserk monsters are few, they look at every monster where it stands right now
+		for (int j = 0; j < ActiveMonsterCount; j++)
+			considerMonster(ActiveMonsters[j]);
 	}
+
 	if (menemy != -1) {
 		monster._mFlags &= ~MFLAG_NO_ENEMY;
 		monster._menemy = menemy;
@@ -870,7 +926,7 @@ void StartRangedSpecialAttack(Monster &monster, missile_id missileType, int dam)
 	Direction md = GetMonsterDirection(monster);
 	int distributeFramesBeforeFrame = 0;
 	if (monster._mAi == AI_MEGA)
-		distributeFramesBeforeFrame = monster.MData->mAFNum2;
+		distributeFramesBeforeFrame = monster.Stats().MData->mAFNum2;
 	NewMonsterAnim(monster, MonsterGraphic::Special, md, AnimationDistributionFlags::ProcessAnimationPending, 0, distributeFramesBeforeFrame);
 	monster._mmode = MonsterMode::SpecialRangedAttack;
 	monster._mVar1 = missileType;
@@ -937,14 +993,14 @@ void DiabloDeath(Monster &diablo, bool sendmsg)
 
 void SpawnLoot(Monster &monster, bool sendmsg)
 {
-	if (Quests[Q_GARBUD].IsAvailable() && monster._uniqtype - 1 == UMT_GARBUD) {
+	if (Quests[Q_GARBUD].IsAvailable() && monster.Stats()._uniqtype - 1 == UMT_GARBUD) {
 		CreateTypeItem(monster.position.tile + Displacement { 1, 1 }, true, ItemType::Mace, IMISC_NONE, true, false);
-	} else if (monster._uniqtype - 1 == UMT_DEFILER) {
+	} else if (monster.Stats()._uniqtype - 1 == UMT_DEFILER) {
 		if (effect_is_playing(USFX_DEFILER8))
 			stream_stop();
 		Quests[Q_DEFILER]._qlog = false;
 		SpawnMapOfDoom(monster.position.tile);
-	} else if (monster._uniqtype - 1 == UMT_HORKDMN) {
+	} else if (monster.Stats()._uniqtype - 1 == UMT_HORKDMN) {
 		CreateAmulet(monster.position.tile, 13, false, true);
 	} else if (monster.MType->mtype == MT_HORKSPWN) {
 	} else if (monster.MType->mtype == MT_NAKRUL) {
@@ -1012,12 +1068,12 @@ void MonsterHitMonster(int mid, int i, int dam)
 	assert(monster.MType != nullptr);
 
 	if (i >= 0 && i < MAX_PLRS)
-		monster.mWhoHit |= 1 << i;
+		monster.Stats().mWhoHit |= 1 << i;
 
 	NetSendCmdMonDmg(false, mid, dam);
 	PlayEffect(monster, 1);
 
-	if ((monster.MType->mtype >= MT_SNEAK && monster.MType->mtype <= MT_ILLWEAV) || dam >> 6 >= monster.mLevel + 3) {
+	if ((monster.MType->mtype >= MT_SNEAK && monster.MType->mtype <= MT_ILLWEAV) || dam >> 6 >= monster.Stats().mLevel + 3) {
 		if (i >= 0)
 			monster._mdir = Opposite(Monsters[i]._mdir);
 
@@ -1043,12 +1099,12 @@ void StartMonsterDeath(int i, int pnum, bool sendmsg)
 	assert(monster.MType != nullptr);
 
 	if (pnum >= 0)
-		monster.mWhoHit |= 1 << pnum;
+		monster.Stats().mWhoHit |= 1 << pnum;
 	if (pnum < MAX_PLRS && i >= MAX_PLRS) /// BUGFIX: i >= MAX_PLRS (fixed)
-		AddPlrMonstExper(monster.mLevel, monster.mExp, monster.mWhoHit);
+		AddPlrMonstExper(monster.Stats().mLevel, monster.Stats().mExp, monster.Stats().mWhoHit);
 	MonsterKillCounts[monster.MType->mtype]++;
 	monster._mhitpoints = 0;
-	SetRndSeed(monster._mRndSeed);
+	SetRndSeed(monster.Stats()._mRndSeed);
 	SpawnLoot(monster, sendmsg);
 	if (monster.MType->mtype == MT_DIABLO)
 		DiabloDeath(monster, true);
@@ -1087,14 +1143,14 @@ void StartDeathFromMonster(int i, int mid)
 	NetSendCmdLocParam1(false, CMD_MONSTDEATH, monster.position.tile, mid);
 
 	if (i < MAX_PLRS) {
-		monster.mWhoHit |= 1 << i;
+		monster.Stats().mWhoHit |= 1 << i;
 		if (mid >= MAX_PLRS)
-			AddPlrMonstExper(monster.mLevel, monster.mExp, monster.mWhoHit);
+			AddPlrMonstExper(monster.Stats().mLevel, monster.Stats().mExp, monster.Stats().mWhoHit);
 	}
 
 	MonsterKillCounts[monster.MType->mtype]++;
 	monster._mhitpoints = 0;
-	SetRndSeed(monster._mRndSeed);
+	SetRndSeed(monster.Stats()._mRndSeed);
 
 	SpawnLoot(monster, true);
 
@@ -1303,11 +1359,11 @@ void MonsterAttackPlayer(int i, int pnum, int hit, Damage damage)
 		hper = 1000;
 #endif
 	int ac = player.GetArmor();
-	if ((player.pDamAcFlags & ISPLHF_ACDEMON) != 0 && monster.MData->mMonstClass == MonsterClass::Demon)
+	if ((player.pDamAcFlags & ISPLHF_ACDEMON) != 0 && monster.Stats().MData->mMonstClass == MonsterClass::Demon)
 		ac += 40;
-	if ((player.pDamAcFlags & ISPLHF_ACUNDEAD) != 0 && monster.MData->mMonstClass == MonsterClass::Undead)
+	if ((player.pDamAcFlags & ISPLHF_ACUNDEAD) != 0 && monster.Stats().MData->mMonstClass == MonsterClass::Undead)
 		ac += 20;
-	hit += 2 * (monster.mLevel - player._pLevel)
+	hit += 2 * (monster.Stats().mLevel - player._pLevel)
 	    + 30
 	    - ac;
 	int minhit = 15;
@@ -1322,7 +1378,7 @@ void MonsterAttackPlayer(int i, int pnum, int hit, Damage damage)
 	if ((player._pmode == PM_STAND || player._pmode == PM_ATTACK) && player._pBlockFlag) {
 		blkper = GenerateRnd(100);
 	}
-	int blk = player.GetBlockChance() - (monster.mLevel * 2);
+	int blk = player.GetBlockChance() - (monster.Stats().mLevel * 2);
 	blk = std::clamp(blk, 0, 100);
 	if (hper >= hit)
 		return;
@@ -1390,19 +1446,19 @@ bool MonsterAttack(int i)
 	assert(i >= 0 && i < MAXMONSTERS);
 	auto &monster = Monsters[i];
 	assert(monster.MType != nullptr);
-	assert(monster.MData != nullptr);
+	assert(monster.Stats().MData != nullptr);
 
-	if (monster.AnimInfo.CurrentFrame == monster.MData->mAFNum) {
-		MonsterAttackPlayer(i, monster._menemy, monster.mHit, monster.mDamage);
+	if (monster.AnimInfo.CurrentFrame == monster.Stats().MData->mAFNum) {
+		MonsterAttackPlayer(i, monster._menemy, monster.Stats().mHit, monster.Stats().mDamage);
 		if (monster._mAi != AI_SNAKE)
 			PlayEffect(monster, 0);
 	}
 	if (monster.MType->mtype >= MT_NMAGMA && monster.MType->mtype <= MT_WMAGMA && monster.AnimInfo.CurrentFrame == 9) {
-		MonsterAttackPlayer(i, monster._menemy, monster.mHit + 10, monster.mDamage - Damage { 2 });
+		MonsterAttackPlayer(i, monster._menemy, monster.Stats().mHit + 10, monster.Stats().mDamage - Damage { 2 });
 		PlayEffect(monster, 0);
 	}
 	if (monster.MType->mtype >= MT_STORM && monster.MType->mtype <= MT_MAEL && monster.AnimInfo.CurrentFrame == 13) {
-		MonsterAttackPlayer(i, monster._menemy, monster.mHit - 20, monster.mDamage + Damage { 4 });
+		MonsterAttackPlayer(i, monster._menemy, monster.Stats().mHit - 20, monster.Stats().mDamage + Damage { 4 });
 		PlayEffect(monster, 0);
 	}
 	if (monster._mAi == AI_SNAKE && monster.AnimInfo.CurrentFrame == 1)
@@ -1420,9 +1476,9 @@ bool MonaterRangedAttack(int i)
 	assert(i >= 0 && i < MAXMONSTERS);
 	auto &monster = Monsters[i];
 	assert(monster.MType != nullptr);
-	assert(monster.MData != nullptr);
+	assert(monster.Stats().MData != nullptr);
 
-	if (monster.AnimInfo.CurrentFrame == monster.MData->mAFNum) {
+	if (monster.AnimInfo.CurrentFrame == monster.Stats().MData->mAFNum) {
 		const auto &missileType = static_cast<missile_id>(monster._mVar1);
 		if (missileType != MIS_NULL) {
 			int multimissiles = 1;
@@ -1456,9 +1512,9 @@ bool MonsterRangedSpecialAttack(int i)
 	assert(i >= 0 && i < MAXMONSTERS);
 	auto &monster = Monsters[i];
 	assert(monster.MType != nullptr);
-	assert(monster.MData != nullptr);
+	assert(monster.Stats().MData != nullptr);
 
-	if (monster.AnimInfo.CurrentFrame == monster.MData->mAFNum2 && monster.AnimInfo.TickCounterOfCurrentFrame == 0) {
+	if (monster.AnimInfo.CurrentFrame == monster.Stats().MData->mAFNum2 && monster.AnimInfo.TickCounterOfCurrentFrame == 0) {
 		AddMissile(
 		    monster.position.tile,
 		    monster.enemyPosition,
@@ -1471,7 +1527,7 @@ bool MonsterRangedSpecialAttack(int i)
 		PlayEffect(monster, 3);
 	}
 
-	if (monster._mAi == AI_MEGA && monster.AnimInfo.CurrentFrame == monster.MData->mAFNum2) {
+	if (monster._mAi == AI_MEGA && monster.AnimInfo.CurrentFrame == monster.Stats().MData->mAFNum2) {
 		if (monster._mVar2++ == 0) {
 			monster._mFlags |= MFLAG_ALLOW_SPECIAL;
 		} else if (monster._mVar2 == 15) {
@@ -1492,10 +1548,10 @@ bool MonsterSpecialAttack(int i)
 	assert(i >= 0 && i < MAXMONSTERS);
 	auto &monster = Monsters[i];
 	assert(monster.MType != nullptr);
-	assert(monster.MData != nullptr);
+	assert(monster.Stats().MData != nullptr);
 
-	if (monster.AnimInfo.CurrentFrame == monster.MData->mAFNum2)
-		MonsterAttackPlayer(i, monster._menemy, monster.mHit2, monster.mDamage2);
+	if (monster.AnimInfo.CurrentFrame == monster.Stats().MData->mAFNum2)
+		MonsterAttackPlayer(i, monster._menemy, monster.Stats().mHit2, monster.Stats().mDamage2);
 
 	if (monster.AnimInfo.CurrentFrame == monster.AnimInfo.NumberOfFrames) {
 		M_StartStand(monster, monster._mdir);
@@ -1567,7 +1623,7 @@ bool MonsterTalk(Monster &monster)
 	if (effect_is_playing(Speeches[monster.mtalkmsg].sfxnr))
 		return false;
 	InitQTextMsg(monster.mtalkmsg);
-	if (monster._uniqtype - 1 == UMT_GARBUD) {
+	if (monster.Stats()._uniqtype - 1 == UMT_GARBUD) {
 		if (monster.mtalkmsg == TEXT_GARBUD1) {
 			Quests[Q_GARBUD]._qactive = QUEST_ACTIVE;
 			Quests[Q_GARBUD]._qlog = true; // BUGFIX: (?) for other quests qactive and qlog go together, maybe this should actually go into the if above (fixed)
@@ -1577,7 +1633,7 @@ bool MonsterTalk(Monster &monster)
 			monster._mFlags |= MFLAG_QUEST_COMPLETE;
 		}
 	}
-	if (monster._uniqtype - 1 == UMT_ZHAR
+	if (monster.Stats()._uniqtype - 1 == UMT_ZHAR
 	    && monster.mtalkmsg == TEXT_ZHAR1
 	    && (monster._mFlags & MFLAG_QUEST_COMPLETE) == 0) {
 		Quests[Q_ZHAR]._qactive = QUEST_ACTIVE;
@@ -1585,7 +1641,7 @@ bool MonsterTalk(Monster &monster)
 		CreateTypeItem(monster.position.tile + Displacement { 1, 1 }, false, ItemType::Misc, IMISC_BOOK, true, false);
 		monster._mFlags |= MFLAG_QUEST_COMPLETE;
 	}
-	if (monster._uniqtype - 1 == UMT_SNOTSPIL) {
+	if (monster.Stats()._uniqtype - 1 == UMT_SNOTSPIL) {
 		if (monster.mtalkmsg == TEXT_BANNER10 && (monster._mFlags & MFLAG_QUEST_COMPLETE) == 0) {
 			ObjChangeMap(setpc_x, setpc_y, (setpc_w / 2) + setpc_x + 2, (setpc_h / 2) + setpc_y - 2);
 			auto tren = TransVal;
@@ -1601,7 +1657,7 @@ bool MonsterTalk(Monster &monster)
 			app_fatal("SS Talk = %i, Flags = %i", monster.mtalkmsg, monster._mFlags);
 		}
 	}
-	if (monster._uniqtype - 1 == UMT_LACHDAN) {
+	if (monster.Stats()._uniqtype - 1 == UMT_LACHDAN) {
 		if (monster.mtalkmsg == TEXT_VEIL9) {
 			Quests[Q_VEIL]._qactive = QUEST_ACTIVE;
 			Quests[Q_VEIL]._qlog = true;
@@ -1611,7 +1667,7 @@ bool MonsterTalk(Monster &monster)
 			monster._mFlags |= MFLAG_QUEST_COMPLETE;
 		}
 	}
-	if (monster._uniqtype - 1 == UMT_WARLORD)
+	if (monster.Stats()._uniqtype - 1 == UMT_WARLORD)
 		Quests[Q_WARLORD]._qvar1 = 2;
 	
 	return false;
@@ -1651,10 +1707,10 @@ bool MonsterDeath(int i)
 		if (monster._mVar1 == 140)
 			PrepDoEnding();
 	} else if (monster.AnimInfo.CurrentFrame == monster.AnimInfo.NumberOfFrames) {
-		if (monster._uniqtype == 0)
+		if (monster.Stats()._uniqtype == 0)
 			AddCorpse(monster.position.tile, monster.MType->mdeadval, monster._mdir);
 		else
-			AddCorpse(monster.position.tile, monster._udeadval, monster._mdir);
+			AddCorpse(monster.position.tile, monster.Stats()._udeadval, monster._mdir);
 
 		dMonster[monster.position.tile.x][monster.position.tile.y] = 0;
 		monster._mDelFlag = true;
@@ -1666,7 +1722,7 @@ bool MonsterDeath(int i)
 
 bool MonsterSpecialStand(Monster &monster)
 {
-	if (monster.AnimInfo.CurrentFrame == monster.MData->mAFNum2)
+	if (monster.AnimInfo.CurrentFrame == monster.Stats().MData->mAFNum2)
 		PlayEffect(monster, 3);
 
 	if (monster.AnimInfo.CurrentFrame == monster.AnimInfo.NumberOfFrames) {
@@ -1733,9 +1789,47 @@ void SpawnSkeleton(Point position, Direction dir)
 		StartSpecialStand(Monsters[skel], dir);
 }
 
+/** Lines whose result only depends on the tile pieces, so they can be remembered until a piece changes */
+enum class SightLine : uint8_t {
+	Missile,
+	Solid,
+};
+
+constexpr int LineOfSightCacheBits = 12;
+
+struct LineOfSightEntry {
+	uint32_t key;
+	uint32_t generation;
+	bool clear;
+};
+
+LineOfSightEntry LineOfSightCache[1 << LineOfSightCacheBits];
+/** Entries of an older generation are stale, starts at 1 so the zeroed table is empty */
+uint32_t LineOfSightGeneration = 1;
+
+/**
+ * @brief Looks up the line in the cache, walking it only if the same line wasn't checked since the pieces last changed
+ */
+template <typename F>
+bool IsLineClearCached(SightLine kind, const F &clear, Point startPoint, Point endPoint)
+{
+	// Coordinates are packed into 7 bits each, anything outside of that isn't worth remembering
+	if (((startPoint.x | startPoint.y | endPoint.x | endPoint.y) & ~0x7F) != 0)
+		return LineClear(clear, startPoint, endPoint);
+
+	uint32_t key = static_cast<uint32_t>(kind) << 28 | startPoint.x << 21 | startPoint.y << 14 | endPoint.x << 7 | endPoint.y;
+	LineOfSightEntry &entry = LineOfSightCache[(key * 2654435761U) >> (32 - LineOfSightCacheBits)];
+	if (entry.generation != LineOfSightGeneration || entry.key != key) {
+		entry.key = key;
+		entry.generation = LineOfSightGeneration;
+		entry.clear = LineClear(clear, startPoint, endPoint);
+	}
+	return entry.clear;
+}
+
 bool IsLineNotSolid(Point startPoint, Point endPoint)
 {
-	return LineClear(IsTileNotSolid, startPoint, endPoint);
+	return IsLineClearCached(SightLine::Solid, IsTileNotSolid, startPoint, endPoint);
 }
 
 void GroupUnity(Monster &monster)
@@ -1746,7 +1840,7 @@ void GroupUnity(Monster &monster)
 	// Someone with a leaderRelation should have a leader ...
 	assert(monster.leader >= 0);
 	// And no unique monster would be a minion of someone else!
-	assert(monster._uniqtype == 0);
+	assert(monster.Stats()._uniqtype == 0);
 
 	auto &leader = Monsters[monster.leader];
 	if (IsLineNotSolid(monster.position.tile, leader.position.future)) {
@@ -1814,17 +1908,27 @@ bool RandomWalk2(int i, Direction md)
 /**
  * @brief Check if a tile is affected by a spell we are vunerable to
  */
+bool FearsFireWalls(const Monster &monster)
+{
+	return (monster.Stats().mMagicRes & IMMUNE_FIRE) == 0 || monster.MType->mtype == MT_DIABLO;
+}
+
+bool FearsLightningWalls(const Monster &monster)
+{
+	return (monster.Stats().mMagicRes & IMMUNE_LIGHTNING) == 0 || monster.MType->mtype == MT_DIABLO;
+}
+
 bool IsTileSafe(const Monster &monster, Point position)
 {
 	if ((dFlags[position.x][position.y] & BFLAG_MISSILE) == 0) {
 		return true;
 	}
 
-	bool fearsFire = (monster.mMagicRes & IMMUNE_FIRE) == 0 || monster.MType->mtype == MT_DIABLO;
-	bool fearsLightning = (monster.mMagicRes & IMMUNE_LIGHTNING) == 0 || monster.MType->mtype == MT_DIABLO;
+	bool fearsFire = FearsFireWalls(monster);
+	bool fearsLightning = FearsLightningWalls(monster);
 
 	for (int j = 0; j < ActiveMissileCount; j++) {
-		uint8_t mi = ActiveMissiles[j];
+		int mi = ActiveMissiles[j];
 		auto &missile = Missiles[mi];
 		if (missile.position.tile == position) {
 			if (fearsFire && missile._mitype == MIS_FIREWALL) {
@@ -1867,6 +1971,56 @@ bool IsTileAccessible(const Monster &monster, Point position)
 	return IsTileSafe(monster, position);
 }
 
+/** Enough flow fields for each player to be chased by monsters of two path classes */
+constexpr int MaxMonsterFlowFields = MAX_PLRS * 2;
+
+struct MonsterFlowField {
+	uint8_t pathClass;
+	FlowField field;
+};
+
+/** Flow fields built during the current tick, dropped by ProcessMonsters */
+MonsterFlowField MonsterFlowFields[MaxMonsterFlowFields];
+int MonsterFlowFieldCount;
+
+/**
+ * @brief Groups monsters by the rules IsTileAccessible applies to them, monsters of the same class walk the same tiles
+ */
+uint8_t GetPathClass(const Monster &monster)
+{
+	uint8_t pathClass = 0;
+	if ((monster._mFlags & MFLAG_CAN_OPEN_DOOR) != 0)
+		pathClass |= 1;
+	if (FearsFireWalls(monster))
+		pathClass |= 2;
+	if (FearsLightningWalls(monster))
+		pathClass |= 4;
+	return pathClass;
+}
+
+/**
+ * @brief Returns the flow field toward the monster's enemy for its path class, building it on the first request of the tick
+ * @return nullptr if there is no room for another flow field this tick
+ */
+const FlowField *GetMonsterFlowField(const Monster &monster)
+{
+	uint8_t pathClass = GetPathClass(monster);
+	for (int i = 0; i < MonsterFlowFieldCount; i++) {
+		MonsterFlowField &flowField = MonsterFlowFields[i];
+		if (flowField.pathClass == pathClass && flowField.field.Destination() == monster.enemyPosition)
+			return &flowField.field;
+	}
+
+	if (MonsterFlowFieldCount == MaxMonsterFlowFields)
+		return nullptr;
+
+	MonsterFlowField &flowField = MonsterFlowFields[MonsterFlowFieldCount];
+	MonsterFlowFieldCount++;
+	flowField.pathClass = pathClass;
+	flowField.field.Build([&monster](Point position) { return IsTileAccessible(monster, position); }, monster.enemyPosition);
+	return &flowField.field;
+}
+
 bool AiPlanWalk(int i)
 {
 	int8_t path[MAX_PATH_LENGTH];
@@ -1877,6 +2031,17 @@ bool AiPlanWalk(int i)
 	assert(i >= 0 && i < MAXMONSTERS);
 	auto &monster = Monsters[i];
 
+	if (sgOptions.Gameplay.bMonsterFlowFields) {
+		const FlowField *flowField = GetMonsterFlowField(monster);
+		if (flowField != nullptr) {
+			std::optional<Direction> step = flowField->FindStep([&monster](Point position) { return IsTileAccessible(monster, position); }, monster.position.tile);
+			if (!step)
+				return false;
+			RandomWalk(i, *step);
+			return true;
+		}
+	}
+
 	if (FindPath([&monster](Point position) { return IsTileAccessible(monster, position); }, monster.position.tile, monster.enemyPosition, path) == 0) {
 		return false;
 	}
@@ -2376,7 +2541,7 @@ void RhinoAi(int i)
 		    && v < 2 * monster._mint + 43
 		    && LineClear([&monster](Point position) { return IsTileAvailable(monster, position); }, monster.position.tile, { fx, fy })) {
 			if (AddMissile(monster.position.tile, { fx, fy }, md, MIS_RHINO, TARGET_PLAYERS, i, 0, 0) != -1) {
-				if (monster.MData->snd_special)
+				if (monster.Stats().MData->snd_special)
 					PlayEffect(monster, 3);
 				dMonster[monster.position.tile.x][monster.position.tile.y] = -(i + 1);
 				monster._mmode = MonsterMode::Charge;
@@ -2520,7 +2685,7 @@ void LeoricAi(int i)
 		if (((dist >= 3 && v < 4 * monster._mint + 35) || v < 6)
 		    && LineClearMissile(monster.position.tile, { fx, fy })) {
 			Point newPosition = monster.position.tile + md;
-			if (IsTileAvailable(monster, newPosition) && ActiveMonsterCount < MAXMONSTERS) {
+			if (IsTileAvailable(monster, newPosition) && ActiveMonsterCount < sgGameInitInfo.nMonsterLimit) {
 				SpawnSkeleton(newPosition, md);
 				StartSpecialStand(monster, md);
 			}
@@ -2934,7 +3099,7 @@ void CounselorAi(int i)
 		if (std::abs(mx) >= 2 || std::abs(my) >= 2) {
 			if (v < 5 * (monster._mint + 10) && LineClearMissile(monster.position.tile, { fx, fy })) {
 				constexpr missile_id MissileTypes[4] = { MIS_FIREBOLT, MIS_CBOLT, MIS_LIGHTCTRL, MIS_FIREBALL };
-				StartRangedAttack(monster, MissileTypes[monster._mint], monster.mDamage);
+				StartRangedAttack(monster, MissileTypes[monster._mint], monster.Stats().mDamage);
 			} else if (GenerateRnd(100) < 30) {
 				monster._mgoal = MGOAL_MOVE;
 				monster._mgoalvar1 = 0;
@@ -3246,7 +3411,7 @@ void HorkDemonAi(int i)
 	if (monster._mgoal == 1) {
 		if ((std::abs(mx) >= 3 || std::abs(my) >= 3) && v < 2 * monster._mint + 43) {
 			Point position = monster.position.tile + monster._mdir;
-			if (IsTileAvailable(monster, position) && ActiveMonsterCount < MAXMONSTERS) {
+			if (IsTileAvailable(monster, position) && ActiveMonsterCount < sgGameInitInfo.nMonsterLimit) {
 				StartRangedSpecialAttack(monster, MIS_HORKDMN, 0);
 			}
 		} else if (std::abs(mx) < 2 && std::abs(my) < 2) {
@@ -3374,7 +3539,7 @@ void InitLevelMonsters()
 
 	ClrAllMonsters();
 	ActiveMonsterCount = 0;
-	totalmonsters = MAXMONSTERS;
+	totalmonsters = sgGameInitInfo.nMonsterLimit;
 
 	for (int i = 0; i < MAXMONSTERS; i++) {
 		ActiveMonsters[i] = i;
@@ -3471,6 +3636,9 @@ void GetLevelMTypes()
 
 void InitMonsterGFX(int monst)
 {
+	// Loading replaces any graphics the type already had
+	Cl2ClearDecodeCache();
+
 	int mtype = LevelMonsterTypes[monst].mtype;
 	int width = MonstersData[mtype].width;
 
@@ -3564,9 +3732,9 @@ void monster_some_crypt()
 	auto &monster = Monsters[UberDiabloMonsterIndex];
 	PlayEffect(monster, 2);
 	Quests[Q_NAKRUL]._qlog = false;
-	monster.mArmorClass -= 50;
+	monster.Stats().mArmorClass -= 50;
 	int hp = monster._mmaxhp / 2;
-	monster.mMagicRes = 0;
+	monster.Stats().mMagicRes = 0;
 	monster._mhitpoints = hp;
 	monster._mmaxhp = hp;
 }
@@ -3601,8 +3769,8 @@ void InitMonsters()
 			}
 		}
 		int numplacemonsters = na / 30;
-		if (ActiveMonsterCount + numplacemonsters > MAXMONSTERS - 10)
-			numplacemonsters = MAXMONSTERS - 10 - ActiveMonsterCount;
+		if (ActiveMonsterCount + numplacemonsters > sgGameInitInfo.nMonsterLimit - 10)
+			numplacemonsters = sgGameInitInfo.nMonsterLimit - 10 - ActiveMonsterCount;
 		totalmonsters = ActiveMonsterCount + numplacemonsters;
 		int numscattypes = 0;
 		int scattertypes[NUM_MTYPES];
@@ -3671,7 +3839,7 @@ void SetMapMonsters(const uint16_t *dunData, Point startPosition)
 
 int AddMonster(Point position, Direction dir, int mtype, bool inMap)
 {
-	if (ActiveMonsterCount < MAXMONSTERS) {
+	if (ActiveMonsterCount < sgGameInitInfo.nMonsterLimit) {
 		int i = ActiveMonsters[ActiveMonsterCount++];
 		if (inMap)
 			dMonster[position.x][position.y] = i + 1;
@@ -3764,12 +3932,12 @@ void M_StartHit(int i, int pnum, int dam)
 	auto &monster = Monsters[i];
 
 	if (pnum >= 0)
-		monster.mWhoHit |= 1 << pnum;
+		monster.Stats().mWhoHit |= 1 << pnum;
 	if (pnum == MyPlayerId) {
 		NetSendCmdMonDmg(false, i, dam);
 	}
 	PlayEffect(monster, 1);
-	if ((monster.MType->mtype >= MT_SNEAK && monster.MType->mtype <= MT_ILLWEAV) || dam >> 6 >= monster.mLevel + 3) {
+	if ((monster.MType->mtype >= MT_SNEAK && monster.MType->mtype <= MT_ILLWEAV) || dam >> 6 >= monster.Stats().mLevel + 3) {
 		if (pnum >= 0) {
 			monster._menemy = pnum;
 			monster.enemyPosition = Players[pnum].position.future;
@@ -4013,6 +4181,8 @@ void DeleteMonsterList()
 void ProcessMonsters()
 {
 	DeleteMonsterList();
+	InvalidateMonsterIndex();
+	MonsterFlowFieldCount = 0;
 
 	assert(ActiveMonsterCount >= 0 && ActiveMonsterCount <= MAXMONSTERS);
 	for (int i = 0; i < ActiveMonsterCount; i++) {
@@ -4020,10 +4190,10 @@ void ProcessMonsters()
 		auto &monster = Monsters[mi];
 		bool raflag = false;
 		if ((monster._mFlags & MFLAG_NOHEAL) == 0 && monster._mhitpoints < monster._mmaxhp && monster._mhitpoints >> 6 > 0) {
-			if (monster.mLevel > 1) {
-				monster._mhitpoints += monster.mLevel / 2;
+			if (monster.Stats().mLevel > 1) {
+				monster._mhitpoints += monster.Stats().mLevel / 2;
 			} else {
-				monster._mhitpoints += monster.mLevel;
+				monster._mhitpoints += monster.Stats().mLevel;
 			}
 		}
 		int mx = monster.position.tile.x;
@@ -4162,7 +4332,7 @@ bool DirOK(int i, Direction mdir)
 	if (monster.leaderRelation == LeaderRelation::Leashed) {
 		return futurePosition.WalkingDistance(Monsters[monster.leader].position.future) < 4;
 	}
-	if (monster._uniqtype == 0 || UniqueMonstersData[monster._uniqtype - 1].monsterPack != UniqueMonsterPack::Leashed)
+	if (monster.Stats()._uniqtype == 0 || UniqueMonstersData[monster.Stats()._uniqtype - 1].monsterPack != UniqueMonsterPack::Leashed)
 		return true;
 	int mcount = 0;
 	for (int x = futurePosition.x - 3; x <= futurePosition.x + 3; x++) {
@@ -4191,81 +4361,21 @@ bool PosOkMissile(Point position)
 
 bool LineClearMissile(Point startPoint, Point endPoint)
 {
-	return LineClear(PosOkMissile, startPoint, endPoint);
+	return IsLineClearCached(SightLine::Missile, PosOkMissile, startPoint, endPoint);
 }
 
-bool LineClear(const std::function<bool(Point)> &clear, Point startPoint, Point endPoint)
+void InvalidateMonsterIndex()
 {
-	Point position = startPoint;
+	ActiveMonsterIndex.valid = false;
+}
 
-	int dx = endPoint.x - position.x;
-	int dy = endPoint.y - position.y;
-	if (std::abs(dx) > std::abs(dy)) {
-		if (dx < 0) {
-			std::swap(position, endPoint);
-			dx = -dx;
-			dy = -dy;
-		}
-		int d;
-		int yincD;
-		int dincD;
-		int dincH;
-		if (dy > 0) {
-			d = 2 * dy - dx;
-			dincD = 2 * dy;
-			dincH = 2 * (dy - dx);
-			yincD = 1;
-		} else {
-			d = 2 * dy + dx;
-			dincD = 2 * dy;
-			dincH = 2 * (dx + dy);
-			yincD = -1;
-		}
-		bool done = false;
-		while (!done && position != endPoint) {
-			if ((d <= 0) ^ (yincD < 0)) {
-				d += dincD;
-			} else {
-				d += dincH;
-				position.y += yincD;
-			}
-			position.x++;
-			done = position != startPoint && !clear(position);
-		}
-	} else {
-		if (dy < 0) {
-			std::swap(position, endPoint);
-			dy = -dy;
-			dx = -dx;
-		}
-		int d;
-		int xincD;
-		int dincD;
-		int dincH;
-		if (dx > 0) {
-			d = 2 * dx - dy;
-			dincD = 2 * dx;
-			dincH = 2 * (dx - dy);
-			xincD = 1;
-		} else {
-			d = 2 * dx + dy;
-			dincD = 2 * dx;
-			dincH = 2 * (dy + dx);
-			xincD = -1;
-		}
-		bool done = false;
-		while (!done && position != endPoint) {
-			if ((d <= 0) ^ (xincD < 0)) {
-				d += dincD;
-			} else {
-				d += dincH;
-				position.x += xincD;
-			}
-			position.y++;
-			done = position != startPoint && !clear(position);
-		}
+void InvalidateLineOfSightCache()
+{
+	LineOfSightGeneration++;
+	if (LineOfSightGeneration == 0) {
+		memset(LineOfSightCache, 0, sizeof(LineOfSightCache));
+		LineOfSightGeneration = 1;
 	}
-	return position == endPoint;
 }
 
 void SyncMonsterAnim(Monster &monster)
@@ -4278,11 +4388,11 @@ void SyncMonsterAnim(Monster &monster)
 		LevelMonsterTypes[monster._mMTidx].mdeadval = 1;
 	}
 #endif
-	monster.MData = LevelMonsterTypes[monster._mMTidx].MData;
-	if (monster._uniqtype != 0)
-		monster.mName = UniqueMonstersData[monster._uniqtype - 1].mName;
+	monster.Stats().MData = LevelMonsterTypes[monster._mMTidx].MData;
+	if (monster.Stats()._uniqtype != 0)
+		monster.Stats().mName = UniqueMonstersData[monster.Stats()._uniqtype - 1].mName;
 	else
-		monster.mName = monster.MData->mName;
+		monster.Stats().mName = monster.Stats().MData->mName;
 
 	MonsterGraphic graphic = MonsterGraphic::Stand;
 
@@ -4424,11 +4534,11 @@ void PrintUniqueHistory()
 {
 	auto &monster = Monsters[pcursmonst];
 	if (sgOptions.Gameplay.bShowMonsterType) {
-		strcpy(tempstr, fmt::format("Type: {:s}", GetMonsterTypeText(*monster.MData)).c_str());
+		strcpy(tempstr, fmt::format("Type: {:s}", GetMonsterTypeText(*monster.Stats().MData)).c_str());
 		AddPanelString(tempstr);
 	}
 
-	int res = monster.mMagicRes & (RESIST_MAGIC | RESIST_FIRE | RESIST_LIGHTNING | IMMUNE_MAGIC | IMMUNE_FIRE | IMMUNE_LIGHTNING);
+	int res = monster.Stats().mMagicRes & (RESIST_MAGIC | RESIST_FIRE | RESIST_LIGHTNING | IMMUNE_MAGIC | IMMUNE_FIRE | IMMUNE_LIGHTNING);
 	if (res == 0) {
 		strcpy(tempstr, "No resistances");
 		AddPanelString(tempstr);
@@ -4498,7 +4608,7 @@ void MissToMonst(Missile &missile, Point position)
 		int pnum = dPlayer[oldPosition.x][oldPosition.y] - 1;
 		if (dPlayer[oldPosition.x][oldPosition.y] > 0) {
 			if (monster.MType->mtype != MT_GLOOM && (monster.MType->mtype < MT_INCIN || monster.MType->mtype > MT_HELLBURN)) {
-				MonsterAttackPlayer(m, dPlayer[oldPosition.x][oldPosition.y] - 1, 500, monster.mDamage2);
+				MonsterAttackPlayer(m, dPlayer[oldPosition.x][oldPosition.y] - 1, 500, monster.Stats().mDamage2);
 				if (pnum == dPlayer[oldPosition.x][oldPosition.y] - 1 && (monster.MType->mtype < MT_NSNAKE || monster.MType->mtype > MT_GSNAKE)) {
 					auto &player = Players[pnum];
 					if (player._pmode != PM_GOTHIT && player._pmode != PM_DEATH)
@@ -4519,7 +4629,7 @@ void MissToMonst(Missile &missile, Point position)
 
 	if (dMonster[oldPosition.x][oldPosition.y] > 0) {
 		if (monster.MType->mtype != MT_GLOOM && (monster.MType->mtype < MT_INCIN || monster.MType->mtype > MT_HELLBURN)) {
-			MonsterAttackMonster(m, dMonster[oldPosition.x][oldPosition.y] - 1, 500, monster.mDamage2);
+			MonsterAttackMonster(m, dMonster[oldPosition.x][oldPosition.y] - 1, 500, monster.Stats().mDamage2);
 			if (monster.MType->mtype < MT_NSNAKE || monster.MType->mtype > MT_GSNAKE) {
 				Point newPosition = oldPosition + monster._mdir;
 				if (IsTileAvailable(Monsters[dMonster[oldPosition.x][oldPosition.y] - 1], newPosition)) {
@@ -4653,10 +4763,11 @@ void SpawnGolem(int i, Point position, Missile &missile)
 	golem._pathcount = 0;
 	golem._mmaxhp = 2 * (320 * missile._mispllvl + player._pMaxMana / 3);
 	golem._mhitpoints = golem._mmaxhp;
-	golem.mArmorClass = 25;
-	golem.mHit = 5 * (missile._mispllvl + 8) + 2 * player._pLevel;
-	golem.mDamage = (Damage { 4, 8 } + Damage { missile._mispllvl }) * 2;
+	golem.Stats().mArmorClass = 25;
+	golem.Stats().mHit = 5 * (missile._mispllvl + 8) + 2 * player._pLevel;
+	golem.Stats().mDamage = (Damage { 4, 8 } + Damage { missile._mispllvl }) * 2;
 	golem._mFlags |= MFLAG_GOLEM;
+	InvalidateMonsterIndex();
 	StartSpecialStand(golem, Direction::South);
 	UpdateEnemy(golem);
 	if (i == MyPlayerId) {
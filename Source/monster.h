@@ -5,9 +5,10 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <array>
-#include <functional>
 #include <optional>
 
 #include "damage.hpp"
@@ -26,7 +27,8 @@ namespace devilution {
 
 struct Missile;
 
-#define MAXMONSTERS 200
+/** Storage for monsters, the monster limit option caps how many of them are in use */
+#define MAXMONSTERS 1024
 #define MAX_LVLMTYPES 24
 
 enum monster_flag : uint16_t {
@@ -165,35 +167,12 @@ struct CMonster {
 	const MonsterData *MData;
 };
 
-struct Monster { // note: missing field _mAFNum
-	int _mMTidx;
-	MonsterMode _mmode;
-	monster_goal _mgoal;
-	int _mgoalvar1;
-	int _mgoalvar2;
-	int _mgoalvar3;
-	uint8_t _pathcount;
-	ActorPosition position;
-	/** Direction faced by monster (direction enum) */
-	Direction _mdir;
-	/** The current target of the mosnter. An index in to either the plr or monster array based on the _meflag value. */
-	int _menemy;
-	/** Usually correspond's to the enemy's future position */
-	Point enemyPosition;
-	/**
-	 * @brief Contains Information for current Animation
-	 */
-	AnimationInfo AnimInfo;
-	bool _mDelFlag;
-	int _mVar1;
-	int _mVar2;
-	int _mVar3;
-	int _mmaxhp;
-	int _mhitpoints;
-	_mai_id _mAi;
-	uint8_t _mint;
-	uint32_t _mFlags;
-	uint8_t _msquelch;
+/**
+ * @brief The part of a monster that is only read when it spawns, fights or dies
+ *
+ * Kept in MonstersStats next to Monsters, see Monster::Stats().
+ */
+struct MonsterStats {
 	/** Seed used to determine item drops on death */
 	uint32_t _mRndSeed;
 	/** Seed used to determine AI behaviour/sync sounds in multiplayer games? */
@@ -203,21 +182,64 @@ struct Monster { // note: missing field _mAFNum
 	int8_t _udeadval;
 	int8_t mWhoHit;
 	int8_t mLevel;
+	uint8_t mArmorClass;
+	uint16_t mMagicRes;
 	uint16_t mExp;
 	uint16_t mHit;
-	Damage mDamage;
 	uint16_t mHit2;
+	Damage mDamage;
 	Damage mDamage2;
-	uint8_t mArmorClass;
-	uint16_t mMagicRes;
-	_speech_id mtalkmsg;
-	uint8_t leader;
-	LeaderRelation leaderRelation;
-	uint8_t packsize;
-	int8_t mlid; // BUGFIX -1 is used when not emitting light this should be signed (fixed)
 	const char *mName;
-	CMonster *MType;
 	const MonsterData *MData;
+};
+
+/**
+ * @brief A monster on the current level
+ *
+ * Holds what the monster loop, the enemy search and the snapshot for the renderer read every game tick. The rest is in
+ * MonsterStats.
+ */
+struct Monster { // note: missing field _mAFNum
+	ActorPosition position;
+	/**
+	 * @brief Contains Information for current Animation
+	 */
+	AnimationInfo AnimInfo;
+	CMonster *MType;
+	MonsterMode _mmode;
+	int _mhitpoints;
+	uint32_t _mFlags;
+	/** The current target of the mosnter. An index in to either the plr or monster array based on the _meflag value. */
+	int _menemy;
+	/** Usually correspond's to the enemy's future position */
+	Point enemyPosition;
+	int _mVar1;
+	int _mVar2;
+	int _mVar3;
+	int _mmaxhp;
+	int _mgoalvar1;
+	int _mgoalvar2;
+	int _mgoalvar3;
+	int _mMTidx;
+	monster_goal _mgoal;
+	/** Direction faced by monster (direction enum) */
+	Direction _mdir;
+	_mai_id _mAi;
+	uint8_t _mint;
+	uint8_t _msquelch;
+	uint8_t _pathcount;
+	bool _mDelFlag;
+	int8_t mlid; // BUGFIX -1 is used when not emitting light this should be signed (fixed)
+	uint16_t leader;
+	LeaderRelation leaderRelation;
+	uint8_t packsize;
+	_speech_id mtalkmsg;
+
+	/**
+	 * @brief Returns the part of the monster that isn't needed every game tick
+	 */
+	MonsterStats &Stats();
+	const MonsterStats &Stats() const;
 
 	/**
 	 * @brief Sets the current cell sprite to match the desired direction and animation sequence
@@ -262,11 +284,22 @@ struct Monster { // note: missing field _mAFNum
 extern CMonster LevelMonsterTypes[MAX_LVLMTYPES];
 extern int LevelMonsterTypeCount;
 extern Monster Monsters[MAXMONSTERS];
+extern MonsterStats MonstersStats[MAXMONSTERS];
 extern int ActiveMonsters[MAXMONSTERS];
 extern int ActiveMonsterCount;
-extern int MonsterKillCounts[MAXMONSTERS];
+extern int MonsterKillCounts[NUM_MTYPES];
 extern bool sgbSaveSoundOn;
 
+inline MonsterStats &Monster::Stats()
+{
+	return MonstersStats[this - Monsters];
+}
+
+inline const MonsterStats &Monster::Stats() const
+{
+	return MonstersStats[this - Monsters];
+}
+
 void InitLevelMonsters();
 void GetLevelMTypes();
 void InitMonsterGFX(int monst);
@@ -293,7 +326,15 @@ void FreeMonsters();
 bool DirOK(int i, Direction mdir);
 bool PosOkMissile(Point position);
 bool LineClearMissile(Point startPoint, Point endPoint);
-bool LineClear(const std::function<bool(Point)> &clear, Point startPoint, Point endPoint);
+/**
+ * @brief Forgets the remembered results of LineClearMissile and IsLineNotSolid, must be called when tile pieces change
+ */
+void InvalidateLineOfSightCache();
+/**
+ * @brief Makes the next targeting query list the golems and berserk monsters again, must be called when monsters were
+ * removed or became golems
+ */
+void InvalidateMonsterIndex();
 void SyncMonsterAnim(Monster &monster);
 void M_FallenFear(Point position);
 void PrintMonstHistory(int mt);
@@ -316,4 +357,83 @@ bool CheckMonsterHit(Monster &monster, bool *ret);
 int encode_enemy(Monster &monster);
 void decode_enemy(Monster &monster, int enemy);
 
+/**
+ * @brief Walks the line between two points and checks every tile on it after startPoint with clear
+ * @return True if the line reaches endPoint
+ */
+template <typename F>
+bool LineClear(const F &clear, Point startPoint, Point endPoint)
+{
+	Point position = startPoint;
+
+	int dx = endPoint.x - position.x;
+	int dy = endPoint.y - position.y;
+	if (std::abs(dx) > std::abs(dy)) {
+		if (dx < 0) {
+			std::swap(position, endPoint);
+			dx = -dx;
+			dy = -dy;
+		}
+		int d;
+		int yincD;
+		int dincD;
+		int dincH;
+		if (dy > 0) {
+			d = 2 * dy - dx;
+			dincD = 2 * dy;
+			dincH = 2 * (dy - dx);
+			yincD = 1;
+		} else {
+			d = 2 * dy + dx;
+			dincD = 2 * dy;
+			dincH = 2 * (dx + dy);
+			yincD = -1;
+		}
+		bool done = false;
+		while (!done && position != endPoint) {
+			if ((d <= 0) ^ (yincD < 0)) {
+				d += dincD;
+			} else {
+				d += dincH;
+				position.y += yincD;
+			}
+			position.x++;
+			done = position != startPoint && !clear(position);
+		}
+	} else {
+		if (dy < 0) {
+			std::swap(position, endPoint);
+			dy = -dy;
+			dx = -dx;
+		}
+		int d;
+		int xincD;
+		int dincD;
+		int dincH;
+		if (dx > 0) {
+			d = 2 * dx - dy;
+			dincD = 2 * dx;
+			dincH = 2 * (dx - dy);
+			xincD = 1;
+		} else {
+			d = 2 * dx + dy;
+			dincD = 2 * dx;
+			dincH = 2 * (dy + dx);
+			xincD = -1;
+		}
+		bool done = false;
+		while (!done && position != endPoint) {
+			if ((d <= 0) ^ (xincD < 0)) {
+				d += dincD;
+			} else {
+				d += dincH;
+				position.x += xincD;
+			}
+			position.y++;
+			done = position != startPoint && !clear(position);
+		}
+	}
+	return position == endPoint;
+}
+
 } // namespace devilution
@@ -5,14 +5,18 @@
  */
 #include "mpqapi.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <type_traits>
+#include <vector>
 
 #include "appfat.h"
 #include "encrypt.h"
@@ -20,6 +24,9 @@
 #include "utils/endian.hpp"
 #include "utils/file_util.h"
 #include "utils/log.hpp"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
 
 namespace devilution {
 
@@ -112,6 +119,12 @@ public:
 		return CheckError("seekp({}, {})", pos, DirToString(dir));
 	}
 
+	bool Seekg(std::streampos pos)
+	{
+		s_->seekg(pos);
+		return CheckError("seekg({})", pos);
+	}
+
 	bool Tellp(std::streampos *result)
 	{
 		*result = s_->tellp();
@@ -130,6 +143,12 @@ public:
 		return CheckError("read(out, {})", size);
 	}
 
+	bool Flush()
+	{
+		s_->flush();
+		return CheckError("flush()");
+	}
+
 private:
 	template <typename... PrintFArgs>
 	bool CheckError(const char *fmt, PrintFArgs... args)
@@ -155,6 +174,165 @@ constexpr std::size_t HashEntrySize = INDEX_ENTRIES * sizeof(_HASHENTRY);
 constexpr std::ios::off_type MpqBlockEntryOffset = sizeof(_FILEHEADER);
 constexpr std::ios::off_type MpqHashEntryOffset = MpqBlockEntryOffset + BlockEntrySize;
 
+constexpr uint32_t SectorSize = 4096;
+/** Space reserved for each compressed sector, the compressor may need more room than the input takes up */
+constexpr uint32_t SectorSlotSize = 2 * SectorSize;
+/** Upper limit on the number of threads helping the main thread compress sectors */
+constexpr int MaxCompressionWorkers = 3;
+
+/**
+ * @brief Compresses the sectors of a file spread over a few worker threads
+ *
+ * The workers are started with the first file that has more than one sector and keep running until the archive is
+ * closed, so writing all files of a save only starts them once. Every thread keeps its own compression work buffer.
+ */
+class SectorCompressor {
+public:
+	/**
+	 * @brief Compresses the sectors of a file, each into its own slot of SectorSlotSize bytes
+	 * @param data Contents of the file
+	 * @param size Size of the file
+	 * @param slots Receives the compressed sectors
+	 * @param sectorSizes Receives the compressed size of each sector
+	 */
+	void Compress(const std::byte *data, uint32_t size, std::byte *slots, uint32_t *sectorSizes)
+	{
+		if (mainWorkBuffer_ == nullptr)
+			mainWorkBuffer_.reset(new char[PkwareWorkBufferSize]);
+
+		const uint32_t numSectors = (size + (SectorSize - 1)) / SectorSize;
+		if (numSectors > 1)
+			StartWorkers();
+		const int helpers = std::min(workerCount_, static_cast<int>(numSectors) - 1);
+
+		{
+			const std::lock_guard<SdlMutex> lock(mutex_);
+			data_ = data;
+			size_ = size;
+			slots_ = slots;
+			sectorSizes_ = sectorSizes;
+			sectorCount_ = numSectors;
+			nextSector_ = 0;
+			sectorsDone_ = 0;
+		}
+		for (int i = 0; i < helpers; i++)
+			workAvailable_.signal();
+
+		CompressSectors(mainWorkBuffer_.get());
+
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		while (sectorsDone_ < sectorCount_)
+			workDone_.wait(mutex_);
+	}
+
+	/**
+	 * @brief Lets the workers finish and waits for them to exit
+	 */
+	void Stop()
+	{
+		if (workerCount_ == 0)
+			return;
+
+		{
+			const std::lock_guard<SdlMutex> lock(mutex_);
+			stopping_ = true;
+		}
+		for (int i = 0; i < workerCount_; i++)
+			workAvailable_.signal();
+		for (int i = 0; i < workerCount_; i++)
+			workers_[i].join();
+
+		workerCount_ = 0;
+		stopping_ = false;
+	}
+
+	~SectorCompressor()
+	{
+		Stop();
+	}
+
+private:
+	SdlMutex mutex_;
+	SdlCond workAvailable_;
+	SdlCond workDone_;
+	SdlThread workers_[MaxCompressionWorkers];
+	int workerCount_ = 0;
+	bool stopping_ = false;
+	std::unique_ptr<char[]> mainWorkBuffer_;
+
+	const std::byte *data_ = nullptr;
+	uint32_t size_ = 0;
+	std::byte *slots_ = nullptr;
+	uint32_t *sectorSizes_ = nullptr;
+	uint32_t sectorCount_ = 0;
+	uint32_t nextSector_ = 0;
+	uint32_t sectorsDone_ = 0;
+
+	static void RunWorker();
+
+	void StartWorkers()
+	{
+		if (workerCount_ != 0)
+			return;
+
+		int count = std::clamp(SDL_GetCPUCount() - 1, 0, MaxCompressionWorkers);
+		for (; workerCount_ < count; workerCount_++)
+			workers_[workerCount_] = SdlThread { RunWorker };
+	}
+
+	/**
+	 * @brief Takes sectors of the current file until none are left
+	 * @return false if the thread should exit
+	 */
+	bool CompressSectors(char *workBuffer)
+	{
+		while (true) {
+			uint32_t sector;
+			{
+				const std::lock_guard<SdlMutex> lock(mutex_);
+				if (nextSector_ >= sectorCount_)
+					return !stopping_;
+				sector = nextSector_++;
+			}
+
+			uint32_t offset = sector * SectorSize;
+			uint32_t len = std::min(size_ - offset, SectorSize);
+			uint32_t compressedSize = PkwareCompress(data_ + offset, len, slots_ + sector * SectorSlotSize, workBuffer);
+
+			const std::lock_guard<SdlMutex> lock(mutex_);
+			sectorSizes_[sector] = compressedSize;
+			sectorsDone_++;
+			if (sectorsDone_ == sectorCount_)
+				workDone_.signal();
+		}
+	}
+
+	void WorkerLoop()
+	{
+		std::unique_ptr<char[]> workBuffer { new char[PkwareWorkBufferSize] };
+
+		while (true) {
+			{
+				const std::lock_guard<SdlMutex> lock(mutex_);
+				while (!stopping_ && nextSector_ >= sectorCount_)
+					workAvailable_.wait(mutex_);
+				if (stopping_)
+					return;
+			}
+			if (!CompressSectors(workBuffer.get()))
+				return;
+		}
+	}
+};
+
+SectorCompressor sectorCompressor;
+
+void SectorCompressor::RunWorker()
+{
+	sectorCompressor.WorkerLoop();
+}
+
+
 struct Archive {
 	FStreamWrapper stream;
 	std::string name;
@@ -168,6 +346,22 @@ struct Archive {
 
 	_HASHENTRY *sgpHashTbl;
 	_BLOCKENTRY *sgpBlockTbl;
+	/** Free blocks ordered by size and then by index, so the first one that is large enough is the best fit */
+	std::set<std::pair<uint32_t, int>> freeBlocks;
+
+	static bool IsFreeBlock(const _BLOCKENTRY &block)
+	{
+		return block.offset != 0 && block.flags == 0 && block.sizefile == 0;
+	}
+
+	void IndexFreeBlocks()
+	{
+		freeBlocks.clear();
+		for (int i = 0; i < INDEX_ENTRIES; i++) {
+			if (IsFreeBlock(sgpBlockTbl[i]))
+				freeBlocks.emplace(sgpBlockTbl[i].sizealloc, i);
+		}
+	}
 
 	bool Open(const char *path)
 	{
@@ -199,12 +393,29 @@ struct Archive {
 		if (!stream.IsOpen())
 			return true;
 		LogDebug("Closing {}", name);
+		sectorCompressor.Stop();
 
 		bool result = true;
 		if (modified && !(stream.Seekp(0, std::ios::beg) && WriteHeaderAndTables()))
 			result = false;
+		// The archive is complete now, a compacted copy only replaces it once the copy was written in full
+		const std::string copyPath = name + ".tmp";
+		std::unique_ptr<_BLOCKENTRY[]> copyBlocks;
+		uint32_t copySize;
+		bool compacted = modified && result && WriteCompactedCopy(copyPath, copyBlocks, &copySize);
 		stream.Close();
-		if (modified && result && size != 0) {
+		if (compacted) {
+			LogDebug("RenameFile(\"{}\", \"{}\")", copyPath, name);
+			compacted = RenameFile(copyPath.c_str(), name.c_str());
+			if (compacted) {
+				memcpy(sgpBlockTbl, copyBlocks.get(), BlockEntrySize);
+				IndexFreeBlocks();
+				size = copySize;
+			} else {
+				RemoveFile(copyPath.c_str());
+			}
+		}
+		if (modified && result && !compacted && size != 0) {
 			LogDebug("ResizeFile(\"{}\", {})", name, size);
 			result = ResizeFile(name.c_str(), size);
 		}
@@ -214,13 +425,14 @@ struct Archive {
 			sgpHashTbl = nullptr;
 			delete[] sgpBlockTbl;
 			sgpBlockTbl = nullptr;
+			freeBlocks.clear();
 		}
 		return result;
 	}
 
 	bool WriteHeaderAndTables()
 	{
-		return WriteHeader() && WriteBlockTable() && WriteHashTable();
+		return WriteHeader(stream, static_cast<uint32_t>(size)) && WriteBlockTable(stream, sgpBlockTbl) && WriteHashTable(stream);
 	}
 
 	~Archive()
@@ -229,14 +441,90 @@ struct Archive {
 	}
 
 private:
-	bool WriteHeader()
+	/**
+	 * @brief Returns the space a file takes up in the archive
+	 *
+	 * The last entry of the sector offset table of a compressed file is its real size, the rest of its allocation is unused.
+	 */
+	bool GetStoredSize(const _BLOCKENTRY &block, uint32_t *storedSize)
+	{
+		*storedSize = block.sizealloc;
+		if ((block.flags & 0x100) == 0)
+			return true;
+
+		const uint32_t numSectors = (block.sizefile + 4095) / 4096;
+		uint32_t tableEnd;
+		if (!stream.Seekg(block.offset + numSectors * sizeof(uint32_t)) || !stream.Read(reinterpret_cast<char *>(&tableEnd), sizeof(tableEnd)))
+			return false;
+		tableEnd = SDL_SwapLE32(tableEnd);
+		if (tableEnd <= block.sizealloc && tableEnd >= (numSectors + 1) * sizeof(uint32_t))
+			*storedSize = tableEnd;
+		return true;
+	}
+
+	/**
+	 * @brief Writes a copy of the archive without the free blocks and the unused space at the end of each file
+	 *
+	 * Only done once at least a quarter of the archive is unused. The archive itself is only read, so a copy that fails
+	 * halfway leaves it intact.
+	 * @param path Where to write the copy
+	 * @param blocks Receives the block table of the copy
+	 * @param copySize Receives the size of the copy
+	 * @return true if the copy was written in full
+	 */
+	bool WriteCompactedCopy(const std::string &path, std::unique_ptr<_BLOCKENTRY[]> &blocks, uint32_t *copySize)
+	{
+		std::vector<int> files;
+		for (int i = 0; i < INDEX_ENTRIES; i++) {
+			if (sgpBlockTbl[i].flags != 0)
+				files.push_back(i);
+		}
+		std::sort(files.begin(), files.end(), [&](int a, int b) {
+			return sgpBlockTbl[a].offset < sgpBlockTbl[b].offset;
+		});
+
+		blocks.reset(new _BLOCKENTRY[INDEX_ENTRIES] {});
+		uint32_t end = MpqHashEntryOffset + HashEntrySize;
+		for (int i : files) {
+			uint32_t storedSize;
+			if (!GetStoredSize(sgpBlockTbl[i], &storedSize))
+				return false;
+			blocks[i] = sgpBlockTbl[i];
+			blocks[i].offset = end;
+			blocks[i].sizealloc = storedSize;
+			end += storedSize;
+		}
+		if (end + size / 4 > size)
+			return false;
+
+		FStreamWrapper copy;
+		if (!copy.Open(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc))
+			return false;
+		bool success = WriteHeader(copy, end) && WriteBlockTable(copy, blocks.get()) && WriteHashTable(copy);
+		std::vector<char> buffer;
+		for (auto it = files.begin(); success && it != files.end(); it++) {
+			buffer.resize(blocks[*it].sizealloc);
+			success = stream.Seekg(sgpBlockTbl[*it].offset) && stream.Read(buffer.data(), buffer.size()) && copy.Write(buffer.data(), buffer.size());
+		}
+		success = success && copy.Flush();
+		copy.Close();
+		if (!success) {
+			RemoveFile(path.c_str());
+			return false;
+		}
+
+		*copySize = end;
+		return true;
+	}
+
+	bool WriteHeader(FStreamWrapper &out, uint32_t fileSize)
 	{
 		_FILEHEADER fhdr;
 
 		memset(&fhdr, 0, sizeof(fhdr));
 		fhdr.signature = SDL_SwapLE32(LoadLE32("MPQ\x1A"));
 		fhdr.headersize = SDL_SwapLE32(32);
-		fhdr.filesize = SDL_SwapLE32(static_cast<uint32_t>(size));
+		fhdr.filesize = SDL_SwapLE32(fileSize);
 		fhdr.version = SDL_SwapLE16(0);
 		fhdr.sectorsizeid = SDL_SwapLE16(3);
 		fhdr.hashoffset = SDL_SwapLE32(static_cast<uint32_t>(MpqHashEntryOffset));
@@ -244,21 +532,21 @@ private:
 		fhdr.hashcount = SDL_SwapLE32(INDEX_ENTRIES);
 		fhdr.blockcount = SDL_SwapLE32(INDEX_ENTRIES);
 
-		return stream.Write(reinterpret_cast<const char *>(&fhdr), sizeof(fhdr));
+		return out.Write(reinterpret_cast<const char *>(&fhdr), sizeof(fhdr));
 	}
 
-	bool WriteBlockTable()
+	bool WriteBlockTable(FStreamWrapper &out, _BLOCKENTRY *blockTbl)
 	{
-		Encrypt((DWORD *)sgpBlockTbl, BlockEntrySize, Hash("(block table)", 3));
-		const bool success = stream.Write(reinterpret_cast<const char *>(sgpBlockTbl), BlockEntrySize);
-		Decrypt((DWORD *)sgpBlockTbl, BlockEntrySize, Hash("(block table)", 3));
+		Encrypt((DWORD *)blockTbl, BlockEntrySize, Hash("(block table)", 3));
+		const bool success = out.Write(reinterpret_cast<const char *>(blockTbl), BlockEntrySize);
+		Decrypt((DWORD *)blockTbl, BlockEntrySize, Hash("(block table)", 3));
 		return success;
 	}
 
-	bool WriteHashTable()
+	bool WriteHashTable(FStreamWrapper &out)
 	{
 		Encrypt((DWORD *)sgpHashTbl, HashEntrySize, Hash("(hash table)", 3));
-		const bool success = stream.Write(reinterpret_cast<const char *>(sgpHashTbl), HashEntrySize);
+		const bool success = out.Write(reinterpret_cast<const char *>(sgpHashTbl), HashEntrySize);
 		Decrypt((DWORD *)sgpHashTbl, HashEntrySize, Hash("(hash table)", 3));
 		return success;
 	}
@@ -348,16 +636,18 @@ void AllocBlock(uint32_t blockOffset, uint32_t blockSize)
 	block = cur_archive.sgpBlockTbl;
 	i = INDEX_ENTRIES;
 	while (i-- != 0) {
-		if (block->offset != 0 && block->flags == 0 && block->sizefile == 0) {
+		if (Archive::IsFreeBlock(*block)) {
 			if (block->offset + block->sizealloc == blockOffset) {
 				blockOffset = block->offset;
 				blockSize += block->sizealloc;
+				cur_archive.freeBlocks.erase({ block->sizealloc, static_cast<int>(block - cur_archive.sgpBlockTbl) });
 				memset(block, 0, sizeof(_BLOCKENTRY));
 				AllocBlock(blockOffset, blockSize);
 				return;
 			}
 			if (blockOffset + blockSize == block->offset) {
 				blockSize += block->sizealloc;
+				cur_archive.freeBlocks.erase({ block->sizealloc, static_cast<int>(block - cur_archive.sgpBlockTbl) });
 				memset(block, 0, sizeof(_BLOCKENTRY));
 				AllocBlock(blockOffset, blockSize);
 				return;
@@ -371,43 +661,40 @@ void AllocBlock(uint32_t blockOffset, uint32_t blockSize)
 	if (blockOffset + blockSize == cur_archive.size) {
 		cur_archive.size = blockOffset;
 	} else {
-		block = NewBlock(nullptr);
+		int blockIndex;
+		block = NewBlock(&blockIndex);
 		block->offset = blockOffset;
 		block->sizealloc = blockSize;
 		block->sizefile = 0;
 		block->flags = 0;
+		cur_archive.freeBlocks.emplace(blockSize, blockIndex);
 	}
 }
 
 int FindFreeBlock(uint32_t size, uint32_t *blockSize)
 {
-	int result;
+	*blockSize = size;
 
-	_BLOCKENTRY *pBlockTbl = cur_archive.sgpBlockTbl;
-	for (int i = 0; i < INDEX_ENTRIES; i++, pBlockTbl++) {
-		if (pBlockTbl->offset == 0)
-			continue;
-		if (pBlockTbl->flags != 0)
-			continue;
-		if (pBlockTbl->sizefile != 0)
-			continue;
-		if (pBlockTbl->sizealloc < size)
-			continue;
+	auto bestFit = cur_archive.freeBlocks.lower_bound({ size, 0 });
+	if (bestFit == cur_archive.freeBlocks.end()) {
+		int result = cur_archive.size;
+		cur_archive.size += size;
+		return result;
+	}
 
-		result = pBlockTbl->offset;
-		*blockSize = size;
-		pBlockTbl->offset += size;
-		pBlockTbl->sizealloc -= size;
+	int blockIndex = bestFit->second;
+	cur_archive.freeBlocks.erase(bestFit);
 
-		if (pBlockTbl->sizealloc == 0)
-			memset(pBlockTbl, 0, sizeof(*pBlockTbl));
+	_BLOCKENTRY &block = cur_archive.sgpBlockTbl[blockIndex];
+	int result = block.offset;
+	block.offset += size;
+	block.sizealloc -= size;
 
-		return result;
-	}
+	if (block.sizealloc == 0)
+		memset(&block, 0, sizeof(block));
+	else
+		cur_archive.freeBlocks.emplace(block.sizealloc, blockIndex);
 
-	*blockSize = size;
-	result = cur_archive.size;
-	cur_archive.size += size;
 	return result;
 }
 
@@ -475,20 +762,33 @@ bool WriteFileContents(const char *pszName, const std::byte *pbData, size_t dwLe
 		pszName = tmp + 1;
 	Hash(pszName, 3);
 
-	constexpr size_t SectorSize = 4096;
 	const uint32_t numSectors = (dwLen + (SectorSize - 1)) / SectorSize;
 	const uint32_t offsetTableByteSize = sizeof(uint32_t) * (numSectors + 1);
 	pBlk->offset = FindFreeBlock(dwLen + offsetTableByteSize, &pBlk->sizealloc);
 	pBlk->sizefile = dwLen;
 	pBlk->flags = 0x80000100;
 
-	// We populate the table of sector offset while we write the data.
-	// We can't pre-populate it because we don't know the compressed sector sizes yet.
+	// The sectors are compressed into slots behind the sector offset table and then moved up against each other, so
+	// the offset table and the data go out in a single write. The buffer is kept for the next file.
+	static std::vector<std::byte> fileBuffer;
+	static std::vector<uint32_t> sectorSizes;
+	fileBuffer.resize(offsetTableByteSize + numSectors * SectorSlotSize);
+	sectorSizes.resize(numSectors);
+	std::byte *slots = &fileBuffer[offsetTableByteSize];
+	sectorCompressor.Compress(pbData, dwLen, slots, sectorSizes.data());
+
 	// First offset is the start of the first sector, last offset is the end of the last sector.
-	std::unique_ptr<uint32_t[]> sectoroffsettable { new uint32_t[numSectors + 1] };
+	auto *sectoroffsettable = reinterpret_cast<uint32_t *>(fileBuffer.data());
+	uint32_t destsize = offsetTableByteSize;
+	for (uint32_t i = 0; i < numSectors; i++) {
+		sectoroffsettable[i] = SDL_SwapLE32(destsize);
+		memmove(&fileBuffer[destsize], slots + i * SectorSlotSize, sectorSizes[i]);
+		destsize += sectorSizes[i];
+	}
+	sectoroffsettable[numSectors] = SDL_SwapLE32(destsize);
 
 #ifdef CAN_SEEKP_BEYOND_EOF
-	if (!cur_archive.stream.Seekp(pBlk->offset + offsetTableByteSize, std::ios::beg))
+	if (!cur_archive.stream.Seekp(pBlk->offset, std::ios::beg))
 		return false;
 #else
 	// Ensure we do not Seekp beyond EOF by filling the missing space.
@@ -496,44 +796,17 @@ bool WriteFileContents(const char *pszName, const std::byte *pbData, size_t dwLe
 	if (!cur_archive.stream.Seekp(0, std::ios::end) || !cur_archive.stream.Tellp(&stream_end))
 		return false;
 	const std::uintmax_t cur_size = stream_end - cur_archive.stream_begin;
-	if (cur_size < pBlk->offset + offsetTableByteSize) {
-		if (cur_size < pBlk->offset) {
-			std::unique_ptr<char[]> filler { new char[pBlk->offset - cur_size] };
-			if (!cur_archive.stream.Write(filler.get(), pBlk->offset - cur_size))
-				return false;
-		}
-		if (!cur_archive.stream.Write(reinterpret_cast<const char *>(sectoroffsettable.get()), offsetTableByteSize))
+	if (cur_size < pBlk->offset) {
+		std::unique_ptr<char[]> filler { new char[pBlk->offset - cur_size] };
+		if (!cur_archive.stream.Write(filler.get(), pBlk->offset - cur_size))
 			return false;
 	} else {
-		if (!cur_archive.stream.Seekp(pBlk->offset + offsetTableByteSize, std::ios::beg))
+		if (!cur_archive.stream.Seekp(pBlk->offset, std::ios::beg))
 			return false;
 	}
 #endif
 
-	uint32_t destsize = offsetTableByteSize;
-	std::byte mpqBuf[SectorSize];
-	std::size_t curSector = 0;
-	while (true) {
-		uint32_t len = std::min(dwLen, SectorSize);
-		memcpy(mpqBuf, pbData, len);
-		pbData += len;
-		len = PkwareCompress(mpqBuf, len);
-		if (!cur_archive.stream.Write((char *)mpqBuf, len))
-			return false;
-		sectoroffsettable[curSector++] = SDL_SwapLE32(destsize);
-		destsize += len; // compressed length
-		if (dwLen > SectorSize)
-			dwLen -= SectorSize;
-		else
-			break;
-	}
-
-	sectoroffsettable[numSectors] = SDL_SwapLE32(destsize);
-	if (!cur_archive.stream.Seekp(pBlk->offset, std::ios::beg))
-		return false;
-	if (!cur_archive.stream.Write(reinterpret_cast<const char *>(sectoroffsettable.get()), offsetTableByteSize))
-		return false;
-	if (!cur_archive.stream.Seekp(destsize - offsetTableByteSize, std::ios::cur))
+	if (!cur_archive.stream.Write(reinterpret_cast<const char *>(fileBuffer.data()), destsize))
 		return false;
 
 	if (destsize < pBlk->sizealloc) {
@@ -629,6 +902,7 @@ bool OpenMPQ(const char *pszArchive)
 			uint32_t key = Hash("(block table)", 3);
 			Decrypt((DWORD *)cur_archive.sgpBlockTbl, BlockEntrySize, key);
 		}
+		cur_archive.IndexFreeBlocks();
 		cur_archive.sgpHashTbl = new _HASHENTRY[HashEntrySize / sizeof(_HASHENTRY)];
 		std::memset(cur_archive.sgpHashTbl, 255, HashEntrySize);
 		if (fhdr.hashcount > 0) {
@@ -49,12 +49,15 @@ struct TMegaPkt {
 
 #define MAX_CHUNKS (NUMLEVELS + 4)
 
+/** Version of the level delta chunks, version 2 widened the monster enemy to 16 bits */
+constexpr uint8_t DeltaFormatVersion = 2;
+
 uint32_t sgdwOwnerWait;
 uint32_t sgdwRecvOffset;
 int sgnCurrMegaPlayer;
 DLevel sgLevels[NUMLEVELS];
 BYTE sbLastCmd;
-std::byte sgRecvBuf[sizeof(DLevel) + 1];
+std::byte sgRecvBuf[sizeof(DLevel) + 2];
 BYTE sgbRecvCmd;
 LocalLevel sgLocals[NUMLEVELS];
 DJunk sgJunk;
@@ -268,6 +271,8 @@ void DeltaImportData(BYTE cmd, DWORD recvOffset)
 		DeltaImportJunk(src);
 	} else if (cmd >= CMD_DLEVEL_0 && cmd <= CMD_DLEVEL_24) {
 		BYTE i = cmd - CMD_DLEVEL_0;
+		if (*src++ != std::byte { DeltaFormatVersion })
+			app_fatal("%s", "Level data is from an incompatible version of the game");
 		src = DeltaImportItem(src, sgLevels[i].item);
 		src = DeltaImportObject(src, sgLevels[i].object);
 		DeltaImportMonster(src, sgLevels[i].monster);
@@ -687,7 +692,7 @@ DWORD OnRequestAutoGetItem(TCmd *pCmd, Player &player)
 				if (p->bPnum != MyPlayerId)
 					SyncGetItem({ p->x, p->y }, p->wIndx, p->wCI, p->dwSeed);
 				else
-					AutoGetItem(MyPlayerId, &Items[p->bCursitem], p->bCursitem);
+					AutoGetItem(MyPlayerId, &Items[p->wCursitem], p->wCursitem);
 				SetItemRecord(p->dwSeed, p->wCI, p->wIndx);
 			} else if (!NetSendCmdReq2(CMD_REQUESTAGITEM, MyPlayerId, p->bPnum, p)) {
 				NetSendCmdExtra(p);
@@ -715,7 +720,7 @@ DWORD OnAutoGetItem(TCmd *pCmd, int pnum)
 						if (ii != -1)
 							AutoGetItem(MyPlayerId, &Items[ii], ii);
 					} else {
-						AutoGetItem(MyPlayerId, &Items[p->bCursitem], p->bCursitem);
+						AutoGetItem(MyPlayerId, &Items[p->wCursitem], p->wCursitem);
 					}
 				} else {
 					SyncGetItem({ p->x, p->y }, p->wIndx, p->wCI, p->dwSeed);
@@ -1241,7 +1246,7 @@ DWORD OnMonstDamage(TCmd *pCmd, int pnum)
 		int playerLevel = Players[pnum].plrlevel;
 		if (currlevel == playerLevel) {
 			auto &monster = Monsters[p->wMon];
-			monster.mWhoHit |= 1 << pnum;
+			monster.Stats().mWhoHit |= 1 << pnum;
 			if (monster._mhitpoints > 0) {
 				monster._mhitpoints -= p->dwDam;
 				if ((monster._mhitpoints >> 6) < 1)
@@ -1759,8 +1764,9 @@ void DeltaExportData(int pnum)
 {
 	if (sgbDeltaChanged) {
 		for (int i = 0; i < NUMLEVELS; i++) {
-			std::unique_ptr<std::byte[]> dst { new std::byte[sizeof(DLevel) + 1] };
+			std::unique_ptr<std::byte[]> dst { new std::byte[sizeof(DLevel) + 2] };
 			std::byte *dstEnd = &dst.get()[1];
+			*dstEnd++ = std::byte { DeltaFormatVersion };
 			dstEnd = DeltaExportItem(dstEnd, sgLevels[i].item);
 			dstEnd = DeltaExportObject(dstEnd, sgLevels[i].object);
 			dstEnd = DeltaExportMonster(dstEnd, sgLevels[i].monster);
@@ -1872,7 +1878,7 @@ void NetSendCmd(bool bHiPri, _cmd_id bCmd)
 		NetSendLoPri(MyPlayerId, (std::byte *)&cmd, sizeof(cmd));
 }
 
-void NetSendCmdGolem(BYTE mx, BYTE my, Direction dir, BYTE menemy, int hp, BYTE cl)
+void NetSendCmdGolem(BYTE mx, BYTE my, Direction dir, uint16_t menemy, int hp, BYTE cl)
 {
 	TCmdGolem cmd;
 
@@ -2030,7 +2036,7 @@ void NetSendCmdQuest(bool bHiPri, const Quest &quest)
 		NetSendLoPri(MyPlayerId, (std::byte *)&cmd, sizeof(cmd));
 }
 
-void NetSendCmdGItem(bool bHiPri, _cmd_id bCmd, BYTE mast, BYTE pnum, BYTE ii)
+void NetSendCmdGItem(bool bHiPri, _cmd_id bCmd, BYTE mast, BYTE pnum, int ii)
 {
 	TCmdGItem cmd;
 
@@ -2038,7 +2044,7 @@ void NetSendCmdGItem(bool bHiPri, _cmd_id bCmd, BYTE mast, BYTE pnum, BYTE ii)
 	cmd.bPnum = pnum;
 	cmd.bMaster = mast;
 	cmd.bLevel = currlevel;
-	cmd.bCursitem = ii;
+	cmd.wCursitem = ii;
 	cmd.dwTime = 0;
 	cmd.x = Items[ii].position.x;
 	cmd.y = Items[ii].position.y;
@@ -205,7 +205,7 @@ struct TCmdGolem {
 	uint8_t _mx;
 	uint8_t _my;
 	Direction _mdir;
-	int8_t _menemy;
+	uint16_t _menemy;
 	int32_t _mhitpoints;
 	uint8_t _currlevel;
 };
@@ -222,7 +222,7 @@ struct TCmdGItem {
 	_cmd_id bCmd;
 	uint8_t bMaster;
 	uint8_t bPnum;
-	uint8_t bCursitem;
+	uint16_t wCursitem;
 	uint8_t bLevel;
 	uint8_t x;
 	uint8_t y;
@@ -345,10 +345,10 @@ struct TSyncHeader {
 };
 
 struct TSyncMonster {
-	uint8_t _mndx;
+	uint16_t _mndx;
 	uint8_t _mx;
 	uint8_t _my;
-	uint8_t _menemy;
+	uint16_t _menemy;
 	uint8_t _mdelta;
 };
 
@@ -375,7 +375,7 @@ struct DMonsterStr {
 	uint8_t _mx;
 	uint8_t _my;
 	Direction _mdir;
-	uint8_t _menemy;
+	uint16_t _menemy;
 	uint8_t _mactive;
 	int32_t _mhitpoints;
 };
@@ -430,7 +430,7 @@ bool delta_portal_inited(int i);
 bool delta_quest_inited(int i);
 void DeltaAddItem(int ii);
 void NetSendCmd(bool bHiPri, _cmd_id bCmd);
-void NetSendCmdGolem(BYTE mx, BYTE my, Direction dir, BYTE menemy, int hp, BYTE cl);
+void NetSendCmdGolem(BYTE mx, BYTE my, Direction dir, uint16_t menemy, int hp, BYTE cl);
 void NetSendCmdLoc(int playerId, bool bHiPri, _cmd_id bCmd, Point position);
 void NetSendCmdLocParam1(bool bHiPri, _cmd_id bCmd, Point position, uint16_t wParam1);
 void NetSendCmdLocParam2(bool bHiPri, _cmd_id bCmd, Point position, uint16_t wParam1, uint16_t wParam2);
@@ -441,7 +441,7 @@ void NetSendCmdParam2(bool bHiPri, _cmd_id bCmd, uint16_t wParam1, uint16_t wPar
 void NetSendCmdParam3(bool bHiPri, _cmd_id bCmd, uint16_t wParam1, uint16_t wParam2, uint16_t wParam3);
 void NetSendCmdParam4(bool bHiPri, _cmd_id bCmd, uint16_t wParam1, uint16_t wParam2, uint16_t wParam3, uint16_t wParam4);
 void NetSendCmdQuest(bool bHiPri, const Quest &quest);
-void NetSendCmdGItem(bool bHiPri, _cmd_id bCmd, BYTE mast, BYTE pnum, BYTE ii);
+void NetSendCmdGItem(bool bHiPri, _cmd_id bCmd, BYTE mast, BYTE pnum, int ii);
 void NetSendCmdPItem(bool bHiPri, _cmd_id bCmd, Point position);
 void NetSendCmdChItem(bool bHiPri, BYTE bLoc);
 void NetSendCmdDelItem(bool bHiPri, BYTE bLoc);
@@ -127,7 +127,7 @@ void MonsterSeeds()
 	sgdwGameLoops++;
 	uint32_t l = (sgdwGameLoops >> 8) | (sgdwGameLoops << 24); // _rotr(sgdwGameLoops, 8)
 	for (int i = 0; i < MAXMONSTERS; i++)
-		Monsters[i]._mAISeed = l + i;
+		Monsters[i].Stats()._mAISeed = l + i;
 }
 
 void HandleTurnUpperBit(int pnum)
@@ -289,26 +289,6 @@ void SendPlayerInfo(int pnum, _cmd_id cmd)
 	PackPlayer(reinterpret_cast<PlayerPack *>(pkplr.get()), Players[MyPlayerId], true);
 }
 
-dungeon_type InitLevelType(int l)
-{
-	if (l == 0)
-		return DTYPE_TOWN;
-	if (l >= 1 && l <= 4)
-		return DTYPE_CATHEDRAL;
-	if (l >= 5 && l <= 8)
-		return DTYPE_CATACOMBS;
-	if (l >= 9 && l <= 12)
-		return DTYPE_CAVES;
-	if (l >= 13 && l <= 16)
-		return DTYPE_HELL;
-	if (l >= 21 && l <= 24)
-		return DTYPE_CATHEDRAL; // Crypt
-	if (l >= 17 && l <= 20)
-		return DTYPE_CAVES; // Hive
-
-	return DTYPE_CATHEDRAL;
-}
-
 void SetupLocalPositions()
 {
 	currlevel = 0;
@@ -351,6 +331,26 @@ bool InitSingle(GameData *gameData)
 
 } // namespace
 
+dungeon_type InitLevelType(int l)
+{
+	if (l == 0)
+		return DTYPE_TOWN;
+	if (l >= 1 && l <= 4)
+		return DTYPE_CATHEDRAL;
+	if (l >= 5 && l <= 8)
+		return DTYPE_CATACOMBS;
+	if (l >= 9 && l <= 12)
+		return DTYPE_CAVES;
+	if (l >= 13 && l <= 16)
+		return DTYPE_HELL;
+	if (l >= 21 && l <= 24)
+		return DTYPE_CATHEDRAL; // Crypt
+	if (l >= 17 && l <= 20)
+		return DTYPE_CAVES; // Hive
+
+	return DTYPE_CATHEDRAL;
+}
+
 void multi_msg_add(std::byte *pbMsg, BYTE bLen)
 {
 	if (pbMsg != nullptr && bLen != 0) {
@@ -534,6 +534,12 @@ bool NetInit()
 		sgGameInitInfo.dwSeed = time(nullptr);
 		sgGameInitInfo.nTickRate = sgOptions.Gameplay.nTickRate;
 		sgGameInitInfo.bRunInTown = sgOptions.Gameplay.bRunInTown ? 1 : 0;
+		sgGameInitInfo.nMonsterLimit = sgOptions.Gameplay.nMonsterLimit;
+		sgGameInitInfo.nMissileLimit = sgOptions.Gameplay.nMissileLimit;
+		sgGameInitInfo.nItemLimit = sgOptions.Gameplay.nItemLimit;
+		sgGameInitInfo.nObjectLimit = sgOptions.Gameplay.nObjectLimit;
+		sgGameInitInfo.nLightLimit = sgOptions.Gameplay.nLightLimit;
+		sgGameInitInfo.nVisionLimit = sgOptions.Gameplay.nVisionLimit;
 		memset(sgbPlayerTurnBitTbl, 0, sizeof(sgbPlayerTurnBitTbl));
 		gbGameDestroyed = false;
 		memset(sgbPlayerLeftGameTbl, 0, sizeof(sgbPlayerLeftGameTbl));
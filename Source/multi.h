@@ -20,6 +20,13 @@ struct GameData {
 	uint32_t dwSeed;
 	uint8_t nTickRate;
 	uint8_t bRunInTown;
+	/** Entity limits of the game, taken from the options when the game is created and kept in its saves */
+	uint16_t nMonsterLimit;
+	uint16_t nMissileLimit;
+	uint16_t nItemLimit;
+	uint16_t nObjectLimit;
+	uint8_t nLightLimit;
+	uint8_t nVisionLimit;
 };
 
 extern bool gbSomebodyWonGameKludge;
@@ -49,4 +56,9 @@ void NetClose();
 bool NetInit();
 void recv_plrinfo(int pnum, TCmdPlrInfoHdr *p, bool recv);
 
+/**
+ * @brief Returns the type of the given dungeon level, this is the same for every game
+ */
+dungeon_type InitLevelType(int l);
+
 } // namespace devilution
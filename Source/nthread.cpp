@@ -4,12 +4,16 @@
  * Implementation of functions for managing game ticks.
  */
 
+#include <algorithm>
+#include <atomic>
+
 #include "diablo.h"
 #include "gmenu.h"
 #include "nthread.h"
 #include "storm/storm.h"
 #include "utils/sdl_mutex.h"
 #include "utils/sdl_thread.h"
+#include "utils/timing.h"
 
 namespace devilution {
 
@@ -19,7 +23,6 @@ uint32_t gdwTurnsInTransit;
 uintptr_t glpMsgTbl[MAX_PLRS];
 uint32_t gdwLargestMsgSize;
 uint32_t gdwNormalMsgSize;
-int last_tick;
 float gfProgressToNextGameTick = 0.0;
 
 namespace {
@@ -33,6 +36,15 @@ bool sgbTicsOutOfSync;
 char sgbPacketCountdown;
 bool sgbThreadIsRunning;
 SdlThread Thread;
+/** Performance counter value at which the next game tick is due, read by the turn thread while the game loop moves it */
+std::atomic<uint64_t> NextTickTime;
+/** Number of game ticks that may be owed before the missed ones are dropped instead of caught up on */
+constexpr int MaxTicksBehind = 10;
+
+uint64_t GetTickDuration()
+{
+	return MicrosecondsToPerformanceTicks(gnTickDelay * 1000);
+}
 
 void NthreadHandler()
 {
@@ -47,12 +59,11 @@ void NthreadHandler()
 			break;
 		}
 		nthread_send_and_recv_turn(0, 0);
-		int delta = gnTickDelay;
+		uint64_t wakeUpTime = SDL_GetPerformanceCounter() + GetTickDuration();
 		if (nthread_recv_turns())
-			delta = last_tick - SDL_GetTicks();
+			wakeUpTime = NextTickTime;
 		MemCrit.unlock();
-		if (delta > 0)
-			SDL_Delay(delta);
+		DelayUntil(wakeUpTime);
 		if (!nthread_should_run)
 			return;
 	}
@@ -95,7 +106,7 @@ bool nthread_recv_turns(bool *pfSendAsync)
 		*pfSendAsync = false;
 	sgbPacketCountdown--;
 	if (sgbPacketCountdown > 0) {
-		last_tick += gnTickDelay;
+		NextTickTime += GetTickDuration();
 		return true;
 	}
 	sgbSyncCountdown--;
@@ -103,7 +114,7 @@ bool nthread_recv_turns(bool *pfSendAsync)
 	if (sgbSyncCountdown != 0) {
 		if (pfSendAsync != nullptr)
 			*pfSendAsync = true;
-		last_tick += gnTickDelay;
+		NextTickTime += GetTickDuration();
 		return true;
 	}
 	if (!SNetReceiveTurns(MAX_PLRS, (char **)glpMsgTbl, gdwMsgLenTbl)) {
@@ -116,13 +127,13 @@ bool nthread_recv_turns(bool *pfSendAsync)
 	}
 	if (!sgbTicsOutOfSync) {
 		sgbTicsOutOfSync = true;
-		last_tick = SDL_GetTicks();
+		NextTickTime = SDL_GetPerformanceCounter();
 	}
 	sgbSyncCountdown = 4;
 	multi_msg_countdown();
 	if (pfSendAsync != nullptr)
 		*pfSendAsync = true;
-	last_tick += gnTickDelay;
+	NextTickTime += GetTickDuration();
 	return true;
 }
 
@@ -133,7 +144,7 @@ void nthread_set_turn_upper_bit()
 
 void nthread_start(bool setTurnUpperBit)
 {
-	last_tick = SDL_GetTicks();
+	NextTickTime = SDL_GetPerformanceCounter();
 	sgbPacketCountdown = 1;
 	sgbSyncCountdown = 1;
 	sgbTicsOutOfSync = true;
@@ -197,32 +208,28 @@ void nthread_ignore_mutex(bool bStart)
 
 bool nthread_has_500ms_passed()
 {
-	int currentTickCount = SDL_GetTicks();
-	int ticksElapsed = currentTickCount - last_tick;
-	if (ticksElapsed > gnTickDelay * 10) {
-		last_tick = currentTickCount;
-		ticksElapsed = 0;
-	}
-	return ticksElapsed >= 0;
+	const uint64_t now = SDL_GetPerformanceCounter();
+	const uint64_t nextTickTime = NextTickTime;
+	if (now < nextTickTime)
+		return false;
+	// After a stall (loading, a dragged window) the missed ticks are dropped, running them all would stall again
+	if (now - nextTickTime > GetTickDuration() * MaxTicksBehind)
+		NextTickTime = now;
+	return true;
 }
 
 void nthread_UpdateProgressToNextGameTick()
 {
 	if (!gbRunGame || PauseMode != 0 || gmenu_is_active() || !gbProcessPlayers) // if game is not running or paused there is no next gametick in the near future
 		return;
-	int currentTickCount = SDL_GetTicks();
-	int ticksElapsed = last_tick - currentTickCount;
-	if (ticksElapsed <= 0) {
+	const uint64_t now = SDL_GetPerformanceCounter();
+	const uint64_t nextTickTime = NextTickTime;
+	if (now >= nextTickTime) {
 		gfProgressToNextGameTick = 1.0; // game tick is due
 		return;
 	}
-	int ticksAdvanced = gnTickDelay - ticksElapsed;
-	float fraction = (float)ticksAdvanced / (float)gnTickDelay;
-	if (fraction > 1.0)
-		gfProgressToNextGameTick = 1.0;
-	if (fraction < 0.0)
-		gfProgressToNextGameTick = 0.0;
-	gfProgressToNextGameTick = fraction;
+	float fraction = 1.0F - static_cast<float>(nextTickTime - now) / static_cast<float>(GetTickDuration());
+	gfProgressToNextGameTick = std::clamp(fraction, 0.0F, 1.0F);
 }
 
 } // namespace devilution
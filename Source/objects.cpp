@@ -587,7 +587,7 @@ void AddObjTraps()
 			if (dObject[i][j] <= 0 || GenerateRnd(100) >= rndv)
 				continue;
 
-			int8_t oi = dObject[i][j] - 1;
+			int oi = dObject[i][j] - 1;
 			if (!AllObjects[Objects[oi]._otype].oTrapFlag)
 				continue;
 
@@ -600,7 +600,7 @@ void AddObjTraps()
 					continue;
 
 				AddObject(OBJ_TRAPL, { xp, j });
-				int8_t oiTrap = dObject[xp][j] - 1;
+				int oiTrap = dObject[xp][j] - 1;
 				Objects[oiTrap]._oVar1 = i;
 				Objects[oiTrap]._oVar2 = j;
 				Objects[oi]._oTrapFlag = true;
@@ -613,7 +613,7 @@ void AddObjTraps()
 					continue;
 
 				AddObject(OBJ_TRAPR, { i, yp });
-				int8_t oiTrap = dObject[i][yp] - 1;
+				int oiTrap = dObject[i][yp] - 1;
 				Objects[oiTrap]._oVar1 = i;
 				Objects[oiTrap]._oVar2 = j;
 				Objects[oi]._oTrapFlag = true;
@@ -627,7 +627,7 @@ void AddChestTraps()
 	for (int j = 0; j < MAXDUNY; j++) {
 		for (int i = 0; i < MAXDUNX; i++) { // NOLINT(modernize-loop-convert)
 			if (dObject[i][j] > 0) {
-				int8_t oi = dObject[i][j] - 1;
+				int oi = dObject[i][j] - 1;
 				if (Objects[oi]._otype >= OBJ_CHEST1 && Objects[oi]._otype <= OBJ_CHEST3 && !Objects[oi]._oTrapFlag && GenerateRnd(100) < 10) {
 					switch (Objects[oi]._otype) {
 					case OBJ_CHEST1:
@@ -846,7 +846,7 @@ void SetupObject(int i, Point position, _object_id ot)
 
 void AddCryptBook(_object_id ot, int v2, int ox, int oy)
 {
-	if (ActiveObjectCount >= MAXOBJECTS)
+	if (ActiveObjectCount >= sgGameInitInfo.nObjectLimit)
 		return;
 
 	int oi = AvailableObjects[0];
@@ -1112,6 +1112,8 @@ void AddChest(int i, int t)
 
 void ObjSetMicro(Point position, int pn)
 {
+	InvalidateLineOfSightCache();
+
 	dPiece[position.x][position.y] = pn;
 	pn--;
 
@@ -1393,7 +1395,7 @@ void AddMushPatch()
 	int y;
 	int x;
 
-	if (ActiveObjectCount < MAXOBJECTS) {
+	if (ActiveObjectCount < sgGameInitInfo.nObjectLimit) {
 		int i = AvailableObjects[0];
 		GetRndObjLoc(5, &x, &y);
 		dObject[x + 1][y + 1] = -(i + 1);
@@ -2218,7 +2220,7 @@ void OperateBookLever(int pnum, int i)
 {
 	int x = 2 * setpc_x + 16;
 	int y = 2 * setpc_y + 16;
-	if (ActiveItemCount >= MAXITEMS) {
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit) {
 		return;
 	}
 	if (Objects[i]._oSelFlag != 0 && !qtextflag) {
@@ -2356,7 +2358,7 @@ void OperateChest(int pnum, int i, bool sendmsg)
 
 void OperateMushPatch(int pnum, int i)
 {
-	if (ActiveItemCount >= MAXITEMS) {
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit) {
 		return;
 	}
 
@@ -2379,7 +2381,7 @@ void OperateMushPatch(int pnum, int i)
 
 void OperateInnSignChest(int pnum, int i)
 {
-	if (ActiveItemCount >= MAXITEMS) {
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit) {
 		return;
 	}
 
@@ -2495,7 +2497,7 @@ void OperateL3Door(int pnum, int i, bool sendflag)
 
 void OperatePedistal(int pnum, int i)
 {
-	if (ActiveItemCount >= MAXITEMS) {
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit) {
 		return;
 	}
 
@@ -3611,7 +3613,7 @@ void OperateBookCase(int pnum, int i, bool sendmsg)
 	if (Quests[Q_ZHAR].IsAvailable()) {
 		auto &zhar = Monsters[MAX_PLRS];
 		if (zhar._mmode == MonsterMode::Stand // prevents playing the "angry" message for the second time if zhar got aggroed by losing vision and talking again
-		    && zhar._uniqtype - 1 == UMT_ZHAR
+		    && zhar.Stats()._uniqtype - 1 == UMT_ZHAR
 		    && zhar._msquelch == UINT8_MAX
 		    && zhar._mhitpoints > 0) {
 			zhar.mtalkmsg = TEXT_ZHAR2;
@@ -3860,7 +3862,7 @@ void OperateStoryBook(int pnum, int i)
 
 void OperateLazStand(int pnum, int i)
 {
-	if (ActiveItemCount >= MAXITEMS) {
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit) {
 		return;
 	}
 
@@ -4460,7 +4462,7 @@ void SetMapObjects(const uint16_t *dunData, int startx, int starty)
 
 void AddObject(_object_id objType, Point objPos)
 {
-	if (ActiveObjectCount >= MAXOBJECTS)
+	if (ActiveObjectCount >= sgGameInitInfo.nObjectLimit)
 		return;
 
 	int oi = AvailableObjects[0];
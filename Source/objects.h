@@ -16,7 +16,8 @@
 
 namespace devilution {
 
-#define MAXOBJECTS 127
+/** Storage for objects, the object limit option caps how many of them are in use */
+#define MAXOBJECTS 512
 
 struct Object {
 	_object_id _otype;
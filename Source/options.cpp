@@ -4,6 +4,7 @@
  * Load and save options from the diablo.ini file.
  */
 
+#include <algorithm>
 #include <cstdint>
 #include <fstream>
 #include <locale>
@@ -12,6 +13,11 @@
 #include <SimpleIni.h>
 
 #include "diablo.h"
+#include "items.h"
+#include "lighting.h"
+#include "missiles.h"
+#include "monster.h"
+#include "objects.h"
 #include "options.h"
 #include "utils/file_util.h"
 #include "utils/paths.h"
@@ -188,6 +194,7 @@ void LoadOptions()
 	sgOptions.Graphics.nGammaCorrection = GetIniInt("Graphics", "Gamma Correction", 100);
 	sgOptions.Graphics.bFPSLimit = GetIniBool("Graphics", "FPS Limiter", true);
 	sgOptions.Graphics.bShowFPS = (GetIniInt("Graphics", "Show FPS", 0) != 0);
+	sgOptions.Graphics.bRenderThread = GetIniBool("Graphics", "Render Thread", false);
 
 	sgOptions.Gameplay.nTickRate = GetIniInt("Game", "Speed", 20);
 	sgOptions.Gameplay.bRunInTown = GetIniBool("Game", "Run in Town", false);
@@ -199,6 +206,14 @@ void LoadOptions()
 	sgOptions.Gameplay.bAutoEquipShields = GetIniBool("Game", "Auto Equip Shields", false);
 	sgOptions.Gameplay.bAutoEquipJewelry = GetIniBool("Game", "Auto Equip Jewelry", false);
 	sgOptions.Gameplay.bShowMonsterType = GetIniBool("Game", "Show Monster Type", false);
+	sgOptions.Gameplay.bMonsterFlowFields = GetIniBool("Game", "Shared Monster Pathing", false);
+	// The limits can't go below those of the original game, the quests and level layouts were made with them in mind
+	sgOptions.Gameplay.nMonsterLimit = std::clamp(GetIniInt("Game", "Monster Limit", 200), 200, MAXMONSTERS);
+	sgOptions.Gameplay.nMissileLimit = std::clamp(GetIniInt("Game", "Missile Limit", 500), 125, MAXMISSILES);
+	sgOptions.Gameplay.nItemLimit = std::clamp(GetIniInt("Game", "Item Limit", 255), 127, MAXITEMS);
+	sgOptions.Gameplay.nObjectLimit = std::clamp(GetIniInt("Game", "Object Limit", 127), 127, MAXOBJECTS);
+	sgOptions.Gameplay.nLightLimit = std::clamp(GetIniInt("Game", "Light Limit", 64), 32, MAXLIGHTS);
+	sgOptions.Gameplay.nVisionLimit = std::clamp(GetIniInt("Game", "Vision Limit", 64), 32, MAXVISION);
 
 	keymapper.Load();
 
@@ -224,6 +239,7 @@ void SaveOptions()
 	SetIniValue("Graphics", "Gamma Correction", sgOptions.Graphics.nGammaCorrection);
 	SetIniValue("Graphics", "FPS Limiter", sgOptions.Graphics.bFPSLimit);
 	SetIniValue("Graphics", "Show FPS", sgOptions.Graphics.bShowFPS);
+	SetIniValue("Graphics", "Render Thread", sgOptions.Graphics.bRenderThread);
 
 	SetIniValue("Game", "Speed", sgOptions.Gameplay.nTickRate);
 	SetIniValue("Game", "Run in Town", sgOptions.Gameplay.bRunInTown);
@@ -235,6 +251,13 @@ void SaveOptions()
 	SetIniValue("Game", "Auto Equip Shields", sgOptions.Gameplay.bAutoEquipShields);
 	SetIniValue("Game", "Auto Equip Jewelry", sgOptions.Gameplay.bAutoEquipJewelry);
 	SetIniValue("Game", "Show Monster Type", sgOptions.Gameplay.bShowMonsterType);
+	SetIniValue("Game", "Shared Monster Pathing", sgOptions.Gameplay.bMonsterFlowFields);
+	SetIniValue("Game", "Monster Limit", sgOptions.Gameplay.nMonsterLimit);
+	SetIniValue("Game", "Missile Limit", sgOptions.Gameplay.nMissileLimit);
+	SetIniValue("Game", "Item Limit", sgOptions.Gameplay.nItemLimit);
+	SetIniValue("Game", "Object Limit", sgOptions.Gameplay.nObjectLimit);
+	SetIniValue("Game", "Light Limit", sgOptions.Gameplay.nLightLimit);
+	SetIniValue("Game", "Vision Limit", sgOptions.Gameplay.nVisionLimit);
 
 	keymapper.Save();
 
@@ -43,6 +43,8 @@ struct GraphicsOptions {
 	bool bFPSLimit;
 	/** @brief Show FPS, even without the -f command line flag. */
 	bool bShowFPS;
+	/** @brief Draw the dungeon on a separate thread. */
+	bool bRenderThread;
 };
 
 struct GameplayOptions {
@@ -66,6 +68,20 @@ struct GameplayOptions {
 	bool bAutoEquipJewelry;
 	/** @brief Indicates whether or not monster type (Animal, Demon, Undead) is shown along with other monster information. */
 	bool bShowMonsterType;
+	/** @brief Monsters chasing the same target share one path search per game tick. */
+	bool bMonsterFlowFields;
+	/** @brief Most monsters a level of a new game can hold, level generation fills the dungeon up to this number. */
+	int nMonsterLimit;
+	/** @brief Most missiles that can be in flight at once in a new game. */
+	int nMissileLimit;
+	/** @brief Most items that can lie on the ground of a level in a new game. */
+	int nItemLimit;
+	/** @brief Most objects a level of a new game can hold. */
+	int nObjectLimit;
+	/** @brief Most light sources that can shine at once in a new game. */
+	int nLightLimit;
+	/** @brief Most sources of vision that can be active at once in a new game. */
+	int nVisionLimit;
 };
 
 struct Options {
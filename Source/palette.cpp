@@ -4,6 +4,8 @@
  * Implementation of functions for handling the engines color palette.
  */
 
+#include <vector>
+
 #include "dx.h"
 #include "engine/load_file.hpp"
 #include "engine/random.hpp"
@@ -31,25 +33,129 @@ void LoadGamma()
 	sgOptions.Graphics.nGammaCorrection = gammaValue - gammaValue % 5;
 }
 
-Uint8 FindBestMatchForColor(SDL_Color *palette, SDL_Color color, int skipFrom, int skipTo)
-{
-	Uint8 best;
-	Uint32 bestDiff = SDL_MAX_UINT32;
-	for (int i = 0; i < 256; i++) {
-		if (i >= skipFrom && i <= skipTo)
-			continue;
-		int diffr = palette[i].r - color.r;
-		int diffg = palette[i].g - color.g;
-		int diffb = palette[i].b - color.b;
-		Uint32 diff = diffr * diffr + diffg * diffg + diffb * diffb;
-
-		if (bestDiff > diff) {
-			best = i;
-			bestDiff = diff;
+/**
+ * @brief Finds the closest palette color to a given color, giving the same result as comparing it against every entry
+ *
+ * The color cube is split into cells. The first time a cell is searched it gets a list of the entries that can be the
+ * closest match for any color inside of it, later searches in that cell only have to compare against that list.
+ */
+class PaletteColorSearch {
+public:
+	/**
+	 * @param palette The colors to search, must stay unchanged while this is in use
+	 * @param skipFrom Do not use colors between this index and skipTo
+	 * @param skipTo Do not use colors between skipFrom and this index
+	 */
+	PaletteColorSearch(const SDL_Color *palette, int skipFrom, int skipTo)
+	    : palette_(palette)
+	{
+		for (int i = 0; i < 256; i++) {
+			if (i >= skipFrom && i <= skipTo)
+				continue;
+			colors_[colorCount_++] = i;
 		}
+		candidates_.reserve(CellCount * 8);
+	}
+
+	/**
+	 * @brief Returns the index of the closest color, the lowest index wins if several are equally close
+	 */
+	Uint8 FindBestMatch(SDL_Color color)
+	{
+		int cell = ((color.r / CellWidth) * CellsPerChannel + color.g / CellWidth) * CellsPerChannel + color.b / CellWidth;
+		if (!cells_[cell].ready)
+			FillCell(cell);
+
+		// The candidates are in index order, so ties are broken the same way as when searching the whole palette
+		Uint8 best = 0;
+		Uint32 bestDiff = SDL_MAX_UINT32;
+		const Uint8 *candidate = &candidates_[cells_[cell].first];
+		const Uint8 *end = candidate + cells_[cell].count;
+		for (; candidate != end; candidate++) {
+			const SDL_Color &entry = palette_[*candidate];
+			int diffr = entry.r - color.r;
+			int diffg = entry.g - color.g;
+			int diffb = entry.b - color.b;
+			Uint32 diff = diffr * diffr + diffg * diffg + diffb * diffb;
+
+			if (bestDiff > diff) {
+				best = *candidate;
+				bestDiff = diff;
+			}
+		}
+		return best;
 	}
-	return best;
-}
+
+private:
+	static constexpr int CellWidth = 32;
+	static constexpr int CellsPerChannel = 256 / CellWidth;
+	static constexpr int CellCount = CellsPerChannel * CellsPerChannel * CellsPerChannel;
+
+	struct Cell {
+		bool ready;
+		/** Position of the first candidate in candidates_ */
+		int first;
+		int count;
+	};
+
+	const SDL_Color *palette_;
+	/** Indexes of the palette entries that may be used */
+	Uint8 colors_[256];
+	int colorCount_ = 0;
+	Cell cells_[CellCount] {};
+	std::vector<Uint8> candidates_;
+
+	/**
+	 * @brief Squared distance along one channel between a value and the closest or farthest value in a row of cells
+	 */
+	static Uint32 GetChannelDistance(int value, int low, bool farthest)
+	{
+		int high = low + CellWidth - 1;
+		int diff;
+		if (farthest)
+			diff = std::max(std::abs(value - low), std::abs(value - high));
+		else if (value < low)
+			diff = low - value;
+		else if (value > high)
+			diff = value - high;
+		else
+			diff = 0;
+		return diff * diff;
+	}
+
+	static Uint32 GetCellDistance(const SDL_Color &color, const int (&low)[3], bool farthest)
+	{
+		return GetChannelDistance(color.r, low[0], farthest) + GetChannelDistance(color.g, low[1], farthest) + GetChannelDistance(color.b, low[2], farthest);
+	}
+
+	/**
+	 * @brief Lists the entries that can be the closest match for some color in the cell
+	 *
+	 * No color in the cell is farther away from its closest entry than the smallest farthest distance of any entry, so
+	 * entries that can't get that close to the cell are left out.
+	 */
+	void FillCell(int cell)
+	{
+		const int low[3] = {
+			(cell / (CellsPerChannel * CellsPerChannel)) * CellWidth,
+			((cell / CellsPerChannel) % CellsPerChannel) * CellWidth,
+			(cell % CellsPerChannel) * CellWidth,
+		};
+
+		Uint32 bound = SDL_MAX_UINT32;
+		for (int i = 0; i < colorCount_; i++) {
+			bound = std::min(bound, GetCellDistance(palette_[colors_[i]], low, true));
+		}
+
+		cells_[cell].first = static_cast<int>(candidates_.size());
+		for (int i = 0; i < colorCount_; i++) {
+			if (GetCellDistance(palette_[colors_[i]], low, false) <= bound)
+				candidates_.push_back(colors_[i]);
+		}
+		cells_[cell].count = static_cast<int>(candidates_.size()) - cells_[cell].first;
+		cells_[cell].ready = true;
+	}
+};
 
 /**
  * @brief Generate lookup table for transparency
@@ -66,6 +172,8 @@ Uint8 FindBestMatchForColor(SDL_Color *palette, SDL_Color color, int skipFrom, i
  */
 void GenerateBlendedLookupTable(SDL_Color *palette, int skipFrom, int skipTo, int toUpdate = 256)
 {
+	PaletteColorSearch colorSearch(palette, skipFrom, skipTo);
+
 	for (int i = 0; i < 256; i++) {
 		for (int j = 0; j < 256; j++) {
 			if (i == j) { // No need to calculate transparency between 2 identical colors
@@ -84,8 +192,7 @@ void GenerateBlendedLookupTable(SDL_Color *palette, int skipFrom, int skipTo, in
 			blendedColor.r = ((int)palette[i].r + (int)palette[j].r) / 2;
 			blendedColor.g = ((int)palette[i].g + (int)palette[j].g) / 2;
 			blendedColor.b = ((int)palette[i].b + (int)palette[j].b) / 2;
-			Uint8 best = FindBestMatchForColor(palette, blendedColor, skipFrom, skipTo);
-			paletteTransparencyLookup[i][j] = best;
+			paletteTransparencyLookup[i][j] = colorSearch.FindBestMatch(blendedColor);
 		}
 	}
 }
@@ -105,11 +212,10 @@ void CycleColors(int from, int to)
 		system_palette[to] = col;
 	}
 
+	// The blended colors never use the cycled range, so moving the rows and columns along keeps the table exact
 	for (auto &palette : paletteTransparencyLookup) {
 		Uint8 col = palette[from];
-		for (int j = from; j < to; j++) {
-			palette[j] = palette[j + 1];
-		}
+		memmove(&palette[from], &palette[from + 1], to - from);
 		palette[to] = col;
 	}
 
@@ -138,9 +244,7 @@ void CycleColorsReverse(int from, int to)
 
 	for (auto &palette : paletteTransparencyLookup) {
 		Uint8 col = palette[to];
-		for (int j = to; j > from; j--) {
-			palette[j] = palette[j - 1];
-		}
+		memmove(&palette[from + 1], &palette[from], to - from);
 		palette[from] = col;
 	}
 
@@ -387,6 +491,7 @@ void palette_update_quest_palette(int n)
 	palette_update(0, 31);
 
 	// Update blended transparency, but only for the color that was updated
+	PaletteColorSearch colorSearch(logical_palette, 1, 31);
 	for (int j = 0; j < 256; j++) {
 		if (i == j) { // No need to calculate transparency between 2 identical colors
 			paletteTransparencyLookup[i][j] = j;
@@ -396,7 +501,7 @@ void palette_update_quest_palette(int n)
 		blendedColor.r = ((int)logical_palette[i].r + (int)logical_palette[j].r) / 2;
 		blendedColor.g = ((int)logical_palette[i].g + (int)logical_palette[j].g) / 2;
 		blendedColor.b = ((int)logical_palette[i].b + (int)logical_palette[j].b) / 2;
-		Uint8 best = FindBestMatchForColor(logical_palette, blendedColor, 1, 31);
+		Uint8 best = colorSearch.FindBestMatch(blendedColor);
 		paletteTransparencyLookup[i][j] = paletteTransparencyLookup[j][i] = best;
 	}
 }
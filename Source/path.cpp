@@ -5,6 +5,8 @@
  */
 #include "path.h"
 
+#include <vector>
+
 #include "gendung.h"
 #include "objects.h"
 
@@ -281,6 +283,13 @@ bool GetPath(const std::function<bool(Point)> &posOk, PATHNODE *pPath, Point des
 	return true;
 }
 
+/** Cost of a path of MAX_PATH_LENGTH - 1 diagonal steps, the longest path FindPath returns */
+constexpr uint8_t MaxFlowCost = 3 * (MAX_PATH_LENGTH - 1);
+constexpr uint8_t UnreachedFlowCost = 0xFF;
+
+/** Tiles waiting to be expanded by FlowField::Build, bucketed by their cost */
+std::vector<Point> FlowFieldBuckets[MaxFlowCost + 1];
+
 } // namespace
 
 bool IsTileNotSolid(Point position)
@@ -362,6 +371,67 @@ int FindPath(const std::function<bool(Point)> &posOk, Point startPosition, Point
 	return 0;
 }
 
+bool FlowField::Contains(Point position) const
+{
+	if (position.x < 0 || position.y < 0 || position.x >= MAXDUNX || position.y >= MAXDUNY)
+		return false;
+
+	return std::abs(position.x - destination_.x) <= Radius && std::abs(position.y - destination_.y) <= Radius;
+}
+
+void FlowField::Build(const std::function<bool(Point)> &posOk, Point destination)
+{
+	destination_ = destination;
+	costs_.fill(UnreachedFlowCost);
+
+	CostAt(destination) = 0;
+	FlowFieldBuckets[0].push_back(destination);
+	// FindPath lets the last step cut a corner when the destination itself is blocked
+	bool destinationOk = posOk(destination);
+
+	// All step costs are positive, so going through the buckets in order expands each tile once with its final cost
+	for (int cost = 0; cost <= MaxFlowCost; cost++) {
+		for (Point position : FlowFieldBuckets[cost]) {
+			if (CostAt(position) != cost)
+				continue;
+			for (Displacement dir : PathDirs) {
+				Point tile = position + dir;
+				if (!Contains(tile))
+					continue;
+				int nextCost = cost + CheckEqual(position, tile);
+				if (nextCost > MaxFlowCost || nextCost >= CostAt(tile))
+					continue;
+				// Walkers step from tile to position, the corner check is the same in both directions
+				if (!posOk(tile))
+					continue;
+				if ((position != destination || destinationOk) && !path_solid_pieces(tile, position))
+					continue;
+				CostAt(tile) = nextCost;
+				FlowFieldBuckets[nextCost].push_back(tile);
+			}
+		}
+		FlowFieldBuckets[cost].clear();
+	}
+}
+
+std::optional<Direction> FlowField::FindStep(const std::function<bool(Point)> &posOk, Point startPosition) const
+{
+	std::optional<Direction> step;
+	uint8_t bestCost = UnreachedFlowCost;
+	for (int i = 0; i < 8; i++) {
+		Point tile = startPosition + PathDirs[i];
+		if (!Contains(tile) || CostAt(tile) >= bestCost)
+			continue;
+		bool ok = posOk(tile);
+		if ((ok && path_solid_pieces(startPosition, tile)) || (!ok && tile == destination_)) {
+			bestCost = CostAt(tile);
+			step = PathDirections[i];
+		}
+	}
+
+	return step;
+}
+
 bool path_solid_pieces(Point startPosition, Point destinationPosition)
 {
 	// These checks are written as if working backwards from the destination to the source, given
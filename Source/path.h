@@ -5,7 +5,10 @@
  */
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <optional>
 
 #include <SDL.h>
 
@@ -66,4 +69,52 @@ const Displacement PathDirs[8] = {
 	// clang-format on
 };
 
+/** The direction of each entry in PathDirs */
+const Direction PathDirections[8] = { Direction::North, Direction::West, Direction::East, Direction::South, Direction::NorthWest, Direction::NorthEast, Direction::SouthEast, Direction::SouthWest };
+
+/**
+ * @brief Step costs toward a destination, shared by everything that walks there with the same PosOk
+ *
+ * Steps are weighted like FindPath does (2 straight, 3 diagonal) and the field only reaches as far as a path FindPath
+ * could return, so reading the first step from it is a drop-in for searching a path for each walker.
+ */
+class FlowField {
+public:
+	/**
+	 * @brief Fills the field by searching outward from the destination, the destination itself doesn't have to pass posOk
+	 */
+	void Build(const std::function<bool(Point)> &posOk, Point destination);
+
+	/**
+	 * @brief Picks the neighbour of startPosition that is closest to the destination, following the step rules of FindPath
+	 * @param posOk Checked again for the neighbours as the world may have changed since the field was built
+	 * @return The direction of the step, or an empty value if the destination can't be reached within the field
+	 */
+	std::optional<Direction> FindStep(const std::function<bool(Point)> &posOk, Point startPosition) const;
+
+	Point Destination() const
+	{
+		return destination_;
+	}
+
+private:
+	static constexpr int Radius = MAX_PATH_LENGTH;
+	static constexpr int Size = 2 * Radius + 1;
+
+	uint8_t &CostAt(Point position)
+	{
+		return costs_[(position.y - destination_.y + Radius) * Size + position.x - destination_.x + Radius];
+	}
+
+	uint8_t CostAt(Point position) const
+	{
+		return costs_[(position.y - destination_.y + Radius) * Size + position.x - destination_.x + Radius];
+	}
+
+	bool Contains(Point position) const;
+
+	Point destination_;
+	std::array<uint8_t, Size * Size> costs_;
+};
+
 } // namespace devilution
@@ -23,6 +23,7 @@
 #include "missiles.h"
 #include "options.h"
 #include "player.h"
+#include "engine/render/cl2_render.hpp"
 #include "spells.h"
 #include "stores.h"
 #include "storm/storm.h"
@@ -392,6 +393,8 @@ void StartWalk(int pnum, Displacement vel, Direction dir, bool pmWillBeCalled)
 
 void SetPlayerGPtrs(const char *path, std::unique_ptr<std::byte[]> &data, std::array<std::optional<CelSprite>, 8> &anim, int width)
 {
+	if (data != nullptr)
+		Cl2ClearDecodeCache();
 	data = nullptr;
 	data = LoadFileInMem(path);
 	if (data == nullptr && gbQuietMode)
@@ -559,7 +562,7 @@ void StartSpell(int pnum, Direction d, int cx, int cy)
 
 void RespawnDeadItem(Item *itm, Point target)
 {
-	if (ActiveItemCount >= MAXITEMS)
+	if (ActiveItemCount >= sgGameInitInfo.nItemLimit)
 		return;
 
 	int ii = AllocateItem();
@@ -890,7 +893,7 @@ bool PlrHitMonst(int pnum, int m)
 		hit = 0;
 	}
 
-	hper += player.GetMeleeToHit() - player.CalculateArmorPierce(monster.mArmorClass, true);
+	hper += player.GetMeleeToHit() - player.CalculateArmorPierce(monster.Stats().mArmorClass, true);
 	hper = std::clamp(hper, 5, 95);
 
 	bool ret = false;
@@ -928,7 +931,7 @@ bool PlrHitMonst(int pnum, int m)
 		phanditype = ItemType::Mace;
 	}
 
-	switch (monster.MData->mMonstClass) {
+	switch (monster.Stats().MData->mMonstClass) {
 	case MonsterClass::Undead:
 		if (phanditype == ItemType::Sword) {
 			dam -= dam / 2;
@@ -954,7 +957,7 @@ bool PlrHitMonst(int pnum, int m)
 		dam *= 3;
 	}
 
-	if ((player.pDamAcFlags & ISPLHF_DOPPELGANGER) != 0 && monster.MType->mtype != MT_DIABLO && monster._uniqtype == 0 && GenerateRnd(100) < 10) {
+	if ((player.pDamAcFlags & ISPLHF_DOPPELGANGER) != 0 && monster.MType->mtype != MT_DIABLO && monster.Stats()._uniqtype == 0 && GenerateRnd(100) < 10) {
 		AddDoppelganger(monster);
 	}
 
@@ -2175,6 +2178,7 @@ void InitPlayerGFX(Player &player)
 
 void ResetPlayerGFX(Player &player)
 {
+	Cl2ClearDecodeCache();
 	player.AnimInfo.pCelSprite = nullptr;
 	for (auto &animData : player.AnimationData) {
 		for (auto &celSprite : animData.CelSpritesForDirections)
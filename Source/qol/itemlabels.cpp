@@ -1,7 +1,7 @@
 #include "itemlabels.h"
 
+#include <algorithm>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 #include "common.h"
@@ -23,7 +23,24 @@ struct ItemLabel {
 	std::string text;
 };
 
+/** Text of the label last shown for an item along with its measured width */
+struct LabelText {
+	std::string text;
+	int width;
+};
+
 std::vector<ItemLabel> labelQueue;
+LabelText labelTexts[MAXITEMS + 1];
+
+/** Labels as they were queued in the last frame that was laid out, the layout is reused while nothing moves */
+std::vector<ItemLabel> previousLabelQueue;
+/** Where each label of previousLabelQueue ended up */
+std::vector<int> previousLabelX;
+
+/** Labels laid out so far, bucketed by rows of RowHeight pixels so a label only has to be checked against its neighbours */
+std::vector<std::vector<unsigned>> labelRows;
+std::vector<unsigned> labelNeighbours;
+std::vector<int> labelBacktrace;
 
 bool altPressed = false;
 bool isLabelHighlighted = false;
@@ -35,6 +52,78 @@ const int BorderY = 2;               // minimal vertical space between labels
 const int MarginX = 2;               // horizontal margins between text and edges of the label
 const int MarginY = 1;               // vertical margins between text and edges of the label
 const int Height = 11 + MarginY * 2; // going above 13 scatters labels of items that are next to each other
+const int RowHeight = Height + BorderY; // labels further apart than this vertically never overlap
+
+bool IsSameLayout(const std::vector<ItemLabel> &a, const std::vector<ItemLabel> &b)
+{
+	return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const ItemLabel &labelA, const ItemLabel &labelB) {
+		return labelA.id == labelB.id && labelA.width == labelB.width && labelA.pos == labelB.pos;
+	});
+}
+
+/**
+ * @brief Moves labels sideways until none of them overlap, each label is only moved around the ones before it
+ */
+void LayoutItemLabels()
+{
+	if (labelQueue.empty())
+		return;
+
+	int top = labelQueue[0].pos.y;
+	int bottom = top;
+	for (const ItemLabel &label : labelQueue) {
+		top = std::min(top, label.pos.y);
+		bottom = std::max(bottom, label.pos.y);
+	}
+	for (auto &row : labelRows)
+		row.clear();
+	labelRows.resize(std::max(labelRows.size(), static_cast<size_t>((bottom - top) / RowHeight + 1)));
+
+	for (unsigned i = 0; i < labelQueue.size(); ++i) {
+		ItemLabel &a = labelQueue[i];
+		const int row = (a.pos.y - top) / RowHeight;
+
+		// Gather the earlier labels close enough vertically in the order they were queued
+		labelNeighbours.clear();
+		for (int neighbourRow = std::max(row - 1, 0); neighbourRow <= row + 1 && neighbourRow < static_cast<int>(labelRows.size()); neighbourRow++)
+			labelNeighbours.insert(labelNeighbours.end(), labelRows[neighbourRow].begin(), labelRows[neighbourRow].end());
+		std::sort(labelNeighbours.begin(), labelNeighbours.end());
+
+		labelBacktrace.clear();
+		auto isBacktracked = [](int position) {
+			return std::find(labelBacktrace.begin(), labelBacktrace.end(), position) != labelBacktrace.end();
+		};
+
+		bool canShow;
+		do {
+			canShow = true;
+			for (unsigned j : labelNeighbours) {
+				ItemLabel &b = labelQueue[j];
+				if (std::abs(b.pos.y - a.pos.y) < Height + BorderY) {
+					int widthA = a.width + BorderX + MarginX * 2;
+					int widthB = b.width + BorderX + MarginX * 2;
+					int newpos = b.pos.x;
+					if (b.pos.x >= a.pos.x && b.pos.x - a.pos.x < widthA) {
+						newpos -= widthA;
+						if (isBacktracked(newpos))
+							newpos = b.pos.x + widthB;
+					} else if (b.pos.x < a.pos.x && a.pos.x - b.pos.x < widthB) {
+						newpos += widthB;
+						if (isBacktracked(newpos))
+							newpos = b.pos.x - widthA;
+					} else
+						continue;
+					canShow = false;
+					a.pos.x = newpos;
+					if (!isBacktracked(newpos))
+						labelBacktrace.push_back(newpos);
+				}
+			}
+		} while (!canShow);
+
+		labelRows[row].push_back(i);
+	}
+}
 
 } // namespace
 
@@ -72,7 +161,13 @@ void AddItemToLabelQueue(int id, int x, int y)
 		textOnGround = item._iIdentified ? item._iIName : item._iName;
 	}
 
-	int nameWidth = GetLineWidth(textOnGround);
+	LabelText &labelText = labelTexts[id];
+	if (labelText.text != textOnGround) {
+		labelText.text = textOnGround;
+		labelText.width = GetLineWidth(textOnGround);
+	}
+
+	int nameWidth = labelText.width;
 	nameWidth += MarginX * 2;
 	int index = ItemCAnimTbl[item._iCurs];
 	if (!labelCenterOffsets[index]) {
@@ -113,35 +208,15 @@ void DrawItemNameLabels(const Surface &out)
 {
 	isLabelHighlighted = false;
 
-	for (unsigned int i = 0; i < labelQueue.size(); ++i) {
-		std::unordered_set<int> backtrace;
-
-		bool canShow;
-		do {
-			canShow = true;
-			for (unsigned int j = 0; j < i; ++j) {
-				ItemLabel &a = labelQueue[i];
-				ItemLabel &b = labelQueue[j];
-				if (std::abs(b.pos.y - a.pos.y) < Height + BorderY) {
-					int widthA = a.width + BorderX + MarginX * 2;
-					int widthB = b.width + BorderX + MarginX * 2;
-					int newpos = b.pos.x;
-					if (b.pos.x >= a.pos.x && b.pos.x - a.pos.x < widthA) {
-						newpos -= widthA;
-						if (backtrace.find(newpos) != backtrace.end())
-							newpos = b.pos.x + widthB;
-					} else if (b.pos.x < a.pos.x && a.pos.x - b.pos.x < widthB) {
-						newpos += widthB;
-						if (backtrace.find(newpos) != backtrace.end())
-							newpos = b.pos.x - widthA;
-					} else
-						continue;
-					canShow = false;
-					a.pos.x = newpos;
-					backtrace.insert(newpos);
-				}
-			}
-		} while (!canShow);
+	if (IsSameLayout(labelQueue, previousLabelQueue)) {
+		for (unsigned i = 0; i < labelQueue.size(); ++i)
+			labelQueue[i].pos.x = previousLabelX[i];
+	} else {
+		previousLabelQueue = labelQueue;
+		LayoutItemLabels();
+		previousLabelX.clear();
+		for (const ItemLabel &label : labelQueue)
+			previousLabelX.push_back(label.pos.x);
 	}
 
 	for (const ItemLabel &label : labelQueue) {
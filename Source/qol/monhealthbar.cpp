@@ -99,7 +99,7 @@ void DrawMonsterHealthBar(const Surface &out)
 	};
 
 	if (sgOptions.Gameplay.bShowMonsterType) {
-		Uint8 borderColor = getBorderColor(monster.MData->mMonstClass);
+		Uint8 borderColor = getBorderColor(monster.Stats().MData->mMonstClass);
 		int borderWidth = width - (border * 2);
 		UnsafeDrawHorizontalLine(out, { position.x + border, position.y + border }, borderWidth, borderColor);
 		UnsafeDrawHorizontalLine(out, { position.x + border, position.y + height - border - 1 }, borderWidth, borderColor);
@@ -109,25 +109,25 @@ void DrawMonsterHealthBar(const Surface &out)
 	}
 
 	UiFlags style = UiFlags::AlignCenter | UiFlags::VerticalCenter;
-	DrawString(out, monster.mName, { position + Displacement { -1, 1 }, width, height }, style | UiFlags::ColorBlack);
-	if (monster._uniqtype != 0)
+	DrawString(out, monster.Stats().mName, { position + Displacement { -1, 1 }, width, height }, style | UiFlags::ColorBlack);
+	if (monster.Stats()._uniqtype != 0)
 		style |= UiFlags::ColorWhitegold;
 	else if (monster.leader != 0)
 		style |= UiFlags::ColorBlue;
 	else
 		style |= UiFlags::ColorWhite;
-	DrawString(out, monster.mName, { position, width, height }, style);
+	DrawString(out, monster.Stats().mName, { position, width, height }, style);
 
-	if (monster._uniqtype != 0 || MonsterKillCounts[monster.MType->mtype] >= 15) {
+	if (monster.Stats()._uniqtype != 0 || MonsterKillCounts[monster.MType->mtype] >= 15) {
 		monster_resistance immunes[] = { IMMUNE_MAGIC, IMMUNE_FIRE, IMMUNE_LIGHTNING };
 		monster_resistance resists[] = { RESIST_MAGIC, RESIST_FIRE, RESIST_LIGHTNING };
 
 		int resOffset = 5;
 		for (int i = 0; i < 3; i++) {
-			if ((monster.mMagicRes & immunes[i]) != 0) {
+			if ((monster.Stats().mMagicRes & immunes[i]) != 0) {
 				DrawArt(out, position + Displacement { resOffset, height - 6 }, &resistance, i * 2 + 1);
 				resOffset += resistance.w() + 2;
-			} else if ((monster.mMagicRes & resists[i]) != 0) {
+			} else if ((monster.Stats().mMagicRes & resists[i]) != 0) {
 				DrawArt(out, position + Displacement { resOffset, height - 6 }, &resistance, i * 2);
 				resOffset += resistance.w() + 2;
 			}
@@ -4,7 +4,15 @@
  * Implementation of functionality for rendering the dungeons, monsters and calling other render routines.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
 #include "automap.h"
+#include "capture.h"
 #include "cursor.h"
 #include "dead.h"
 #include "doom.h"
@@ -33,6 +41,10 @@
 #include "utils/display.h"
 #include "utils/endian.hpp"
 #include "utils/log.hpp"
+#include "utils/sdl_semaphore.h"
+#include "utils/sdl_thread.h"
+#include "utils/timing.h"
+#include "worldsnapshot.h"
 
 #ifdef _DEBUG
 #include "debug.h"
@@ -40,10 +52,13 @@
 
 namespace devilution {
 
+// The state the tile and sprite renderers are configured with is kept per thread, so drawing the dungeon on the
+// render thread leaves the state of the main thread alone.
+
 /**
  * Specifies the current light entry.
  */
-int LightTableIndex;
+thread_local int LightTableIndex;
 
 /**
  * Specifies the current MIN block of the level CEL file, as used during rendering of the level tiles.
@@ -51,40 +66,87 @@ int LightTableIndex;
  * frameNum  := block & 0x0FFF
  * frameType := block & 0x7000 >> 12
  */
-uint32_t level_cel_block;
+thread_local uint32_t level_cel_block;
 bool AutoMapShowItems;
 /**
  * Specifies the type of arches to render.
  */
-char arch_draw_type;
+thread_local char arch_draw_type;
 /**
  * Specifies whether transparency is active for the current CEL file being decoded.
  */
-bool cel_transparency_active;
+thread_local bool cel_transparency_active;
 /**
  * Specifies whether foliage (tile has extra content that overlaps previous tile) being rendered.
  */
-bool cel_foliage_active = false;
+thread_local bool cel_foliage_active = false;
 /**
  * Specifies the current dungeon piece ID of the level, as used during rendering of the level tiles.
  */
-int level_piece_id;
+thread_local int level_piece_id;
 
 namespace {
+
 /**
- * @brief Hash algorithm for point
+ * @brief The state besides the world snapshot that a frame of the dungeon is drawn with
  */
-struct PointHash {
-	std::size_t operator()(Point const &s) const noexcept
-	{
-		return s.x ^ (s.y << 1);
-	}
+struct WorldFrame {
+	/** Center of view in dPiece coordinates */
+	Point position;
+	/** Progress as a fraction (0.0f to 1.0f) in time to the next game tick */
+	float progress;
+	bool zoom;
+	/** The character panel or the quest log covers the left side of the view */
+	bool leftPanelOpen;
+	/** The inventory or the spell book covers the right side of the view */
+	bool rightPanelOpen;
+	bool showItems;
+	int cursMonster;
+	int cursPlayer;
+	int cursObject;
+	int cursItem;
+	Displacement tileOffset;
+	Displacement tileShift;
+	int tileColumns;
+	int tileRows;
+	int screenWidth;
+	int viewportHeight;
+};
+
+/**
+ * @brief An item that shows its name, handed to AddItemToLabelQueue once the frame it was drawn in is shown
+ */
+struct QueuedItemLabel {
+	int id;
+	int x;
+	int y;
 };
 
+// The state below is only used while the dungeon is drawn and belongs to the thread drawing it
+
+/** Snapshot the dungeon is being drawn from, only set while drawing it */
+thread_local WorldSnapshot *Scene;
+/** Frame the dungeon is being drawn for, only set while drawing it */
+thread_local const WorldFrame *Frame;
+/** Receives the labels of the items that are drawn */
+thread_local std::vector<QueuedItemLabel> *ItemLabels;
+#ifdef _DEBUG
+/** Receives the buffer position of every tile that is drawn */
+thread_local std::unordered_map<int, Point> *TileCoords;
+#endif
+
+static_assert(MAXMISSILES < UINT16_MAX, "Missile indices + 1 must fit in MissilesAtRenderingTile");
+
 /**
- * @brief Contains all Missile at rendering position
+ * @brief First missile drawn at each tile as index in the snapshot + 1, 0 if there is none
+ *
+ * Further missiles on the same tile are chained through NextMissileAtRenderingTile in the order they are drawn.
  */
-std::unordered_multimap<Point, Missile *, PointHash> MissilesAtRenderingTile;
+thread_local uint16_t MissilesAtRenderingTile[MAXDUNX][MAXDUNY];
+thread_local uint16_t NextMissileAtRenderingTile[MAXMISSILES];
+/** Tiles with an entry in MissilesAtRenderingTile, so only those have to be cleared for the next frame */
+thread_local Point MissileRenderingTiles[MAXMISSILES];
+thread_local int MissileRenderingTileCount;
 
 /**
  * @brief Could the missile (at the next game tick) collide? This method is a simplified version of CheckMissileCol (for example without random).
@@ -104,34 +166,131 @@ bool CouldMissileCollide(Point tile, bool checkPlayerAndMonster)
 	int oid = dObject[tile.x][tile.y];
 	if (oid != 0) {
 		oid = oid > 0 ? oid - 1 : -(oid + 1);
-		if (!Objects[oid]._oMissFlag)
+		if (!Scene->objects[oid].missFlag)
 			return true;
 	}
 	return nMissileTable[dPiece[tile.x][tile.y]];
 }
 
-void UpdateMissileRendererData(Missile &m)
+/**
+ * @brief Returns the offset for the walking animation at the given point between two game ticks
+ * @param animationInfo the current active walking animation
+ * @param dir walking direction
+ * @param progress Progress as a fraction (0.0f to 1.0f) in time to the next game tick
+ * @param cameraMode Adjusts the offset relative to the camera
+ */
+Displacement GetOffsetForWalking(const AnimationInfo &animationInfo, const Direction dir, float progress, bool cameraMode)
 {
-	m.position.tileForRendering = m.position.tile;
-	m.position.offsetForRendering = m.position.offset;
+	// clang-format off
+	//                                           South,        SouthWest,    West,         NorthWest,    North,        NorthEast,     East,         SouthEast,
+	constexpr Displacement StartOffset[8]    = { {   0, -32 }, {  32, -16 }, {  64,   0 }, {   0,   0 }, {   0,   0 }, {  0,    0 },  { -64,   0 }, { -32, -16 } };
+	constexpr Displacement MovingOffset[8]   = { {   0,  32 }, { -32,  16 }, { -64,   0 }, { -32, -16 }, {   0, -32 }, {  32, -16 },  {  64,   0 }, {  32,  16 } };
+	// clang-format on
 
-	const MissileMovementDistrubution missileMovement = MissilesData[m._mitype].MovementDistribution;
-	// don't calculate missile position if they don't move
-	if (missileMovement == MissileMovementDistrubution::Disabled || m.position.velocity == Displacement {})
-		return;
+	float fAnimationProgress = animationInfo.GetAnimationProgress(progress);
+	Displacement offset = MovingOffset[static_cast<size_t>(dir)];
+	offset *= fAnimationProgress;
 
-	float fProgress = gfProgressToNextGameTick;
-	Displacement velocity = m.position.velocity * fProgress;
-	Displacement traveled = m.position.traveled + velocity;
+	if (cameraMode) {
+		offset = -offset;
+	} else {
+		offset += StartOffset[static_cast<size_t>(dir)];
+	}
+
+	return offset;
+}
+
+/**
+ * @brief Moves the drawn position of a missile to where it is after the given part of the next game tick
+ */
+void SetMissileRenderPosition(Missile &m, float progress)
+{
+	Displacement traveled = m.position.traveled + m.position.velocity * progress;
 
 	int mx = traveled.deltaX >> 16;
 	int my = traveled.deltaY >> 16;
 	int dx = (mx + 2 * my) / 64;
 	int dy = (2 * my - mx) / 64;
 
-	// calculcate the future missile position
 	m.position.tileForRendering = m.position.start + Displacement { dx, dy };
 	m.position.offsetForRendering = { mx + (dy * 32) - (dx * 32), my - (dx * 16) - (dy * 16) };
+}
+
+/**
+ * @brief Range of a sum of pixel coordinates that is truncated to the given multiple of 64
+ */
+void GetTruncatedRange(int multiple, float &low, float &high)
+{
+	if (multiple > 0) {
+		low = 64.F * multiple;
+		high = low + 63.F;
+	} else if (multiple < 0) {
+		high = 64.F * multiple;
+		low = high - 63.F;
+	} else {
+		low = -63.F;
+		high = 63.F;
+	}
+}
+
+/**
+ * @brief Largest progress where start + slope * progress stays within [low, high]
+ * @return A negative value if start is already outside of the range
+ */
+float GetProgressLeavingRange(float start, float slope, float low, float high)
+{
+	if (start < low || start > high)
+		return -1.F;
+	if (slope > 0)
+		return (high - start) / slope;
+	if (slope < 0)
+		return (low - start) / slope;
+	return std::numeric_limits<float>::max();
+}
+
+/**
+ * @brief Finds how far into the next game tick a missile stays on the tile it is on
+ *
+ * The tile is picked by truncating u = mx + 2 * my and v = 2 * my - mx, both of which move linearly with the progress,
+ * so each gives the progress at which the missile crosses into a neighbouring row or column. mx and my are rounded
+ * down from the fixed point position, which moves u by up to 3 pixels and v by up to 2 pixels down or 1 up, so the
+ * crossing can only be narrowed down to a range.
+ *
+ * @param m Missile that leaves its tile before the next game tick
+ * @param safe Progress up to which the missile is certain to be on its tile, negative if it is close to the edge
+ * @param reach Progress after which the missile is certain to be on another tile
+ */
+void GetProgressAtTileExit(const Missile &m, float &safe, float &reach)
+{
+	const Displacement tile = m.position.tile - m.position.start;
+	const float x = m.position.traveled.deltaX / 65536.F;
+	const float y = m.position.traveled.deltaY / 65536.F;
+	const float vx = m.position.velocity.deltaX / 65536.F;
+	const float vy = m.position.velocity.deltaY / 65536.F;
+
+	float uLow;
+	float uHigh;
+	GetTruncatedRange(tile.deltaX, uLow, uHigh);
+	float vLow;
+	float vHigh;
+	GetTruncatedRange(tile.deltaY, vLow, vHigh);
+
+	safe = std::min(GetProgressLeavingRange(x + 2 * y, vx + 2 * vy, uLow + 3, uHigh), GetProgressLeavingRange(2 * y - x, 2 * vy - vx, vLow + 2, vHigh - 1));
+	reach = std::min(GetProgressLeavingRange(x + 2 * y, vx + 2 * vy, uLow, uHigh + 3), GetProgressLeavingRange(2 * y - x, 2 * vy - vx, vLow - 1, vHigh + 2));
+}
+
+void UpdateMissileRendererData(Missile &m)
+{
+	m.position.tileForRendering = m.position.tile;
+	m.position.offsetForRendering = m.position.offset;
+
+	const MissileMovementDistrubution missileMovement = MissilesData[m._mitype].MovementDistribution;
+	// don't calculate missile position if they don't move
+	if (missileMovement == MissileMovementDistrubution::Disabled || m.position.velocity == Displacement {})
+		return;
+
+	// calculcate the future missile position
+	SetMissileRenderPosition(m, Frame->progress);
 
 	// In some cases this calculcated position is invalid.
 	// For example a missile shouldn't move inside a wall.
@@ -147,39 +306,59 @@ void UpdateMissileRendererData(Missile &m)
 		return;
 
 	// The new tile could be invalid, so don't advance to it.
-	// We search the last offset that is in the old (valid) tile.
-	// Implementation note: If someone knows the correct math to calculate this without the loop, I would really appreciate it.
-	while (m.position.tile != m.position.tileForRendering) {
-		fProgress -= 0.01F;
-
-		if (fProgress <= 0.0F) {
-			m.position.tileForRendering = m.position.tile;
-			m.position.offsetForRendering = m.position.offset;
-			return;
-		}
-
-		velocity = m.position.velocity * fProgress;
-		traveled = m.position.traveled + velocity;
-
-		mx = traveled.deltaX >> 16;
-		my = traveled.deltaY >> 16;
-		dx = (mx + 2 * my) / 64;
-		dy = (2 * my - mx) / 64;
-
-		m.position.tileForRendering = m.position.start + Displacement { dx, dy };
-		m.position.offsetForRendering = { mx + (dy * 32) - (dx * 32), my - (dx * 16) - (dy * 16) };
+	// We search the last offset that is in the old (valid) tile, the edge of the tile is found up to a few pixels and
+	// the remaining range is halved until it is within a fraction of a pixel.
+	float safe;
+	float reach;
+	GetProgressAtTileExit(m, safe, reach);
+
+	float low = std::max(std::min(safe, Frame->progress), 0.F);
+	if (low > 0.F) {
+		SetMissileRenderPosition(m, low);
+		if (m.position.tileForRendering != m.position.tile)
+			low = 0.F;
+	}
+	float high = std::min(Frame->progress, std::max(reach, low));
+	for (int i = 0; i < 6 && high - low > 0.002F; i++) {
+		float middle = (low + high) / 2;
+		SetMissileRenderPosition(m, middle);
+		if (m.position.tileForRendering == m.position.tile)
+			low = middle;
+		else
+			high = middle;
+	}
+
+	if (low <= 0.F) {
+		m.position.tileForRendering = m.position.tile;
+		m.position.offsetForRendering = m.position.offset;
+		return;
 	}
+
+	SetMissileRenderPosition(m, low);
 }
 
 void UpdateMissilesRendererData()
 {
-	MissilesAtRenderingTile.clear();
+	for (int i = 0; i < MissileRenderingTileCount; i++) {
+		const Point tile = MissileRenderingTiles[i];
+		MissilesAtRenderingTile[tile.x][tile.y] = 0;
+	}
+	MissileRenderingTileCount = 0;
 
-	for (int i = 0; i < ActiveMissileCount; i++) {
-		assert(ActiveMissiles[i] < MAXMISSILES);
-		Missile &m = Missiles[ActiveMissiles[i]];
+	// Going backwards so each missile can be put at the head of its list and the lists end up in drawing order
+	for (int i = static_cast<int>(Scene->missiles.size()) - 1; i >= 0; i--) {
+		Missile &m = Scene->missiles[i];
 		UpdateMissileRendererData(m);
-		MissilesAtRenderingTile.insert(std::make_pair(m.position.tileForRendering, &m));
+
+		const Point tile = m.position.tileForRendering;
+		if (tile.x < 0 || tile.x >= MAXDUNX || tile.y < 0 || tile.y >= MAXDUNY)
+			continue;
+
+		uint16_t &head = MissilesAtRenderingTile[tile.x][tile.y];
+		if (head == 0)
+			MissileRenderingTiles[MissileRenderingTileCount++] = tile;
+		NextMissileAtRenderingTile[i] = head;
+		head = i + 1;
 	}
 }
 
@@ -192,12 +371,9 @@ uint32_t sgdwCursHgt;
 uint32_t sgdwCursWdt;
 BYTE sgSaveBack[8192];
 
-bool dRendered[MAXDUNX][MAXDUNY];
+thread_local bool dRendered[MAXDUNX][MAXDUNY];
 
 bool frameflag;
-int frameend;
-int framerate;
-int framestart;
 
 const char *const PlayerModeNames[] = {
 	"standing",
@@ -319,9 +495,8 @@ void DrawMissilePrivate(const Surface &out, const Missile &missile, Point target
  */
 void DrawMissile(const Surface &out, Point tilePosition, Point targetBufferPosition, bool pre)
 {
-	const auto range = MissilesAtRenderingTile.equal_range(tilePosition);
-	for (auto it = range.first; it != range.second; it++) {
-		DrawMissilePrivate(out, *it->second, targetBufferPosition, pre);
+	for (int mi = MissilesAtRenderingTile[tilePosition.x][tilePosition.y]; mi != 0; mi = NextMissileAtRenderingTile[mi - 1]) {
+		DrawMissilePrivate(out, Scene->missiles[mi - 1], targetBufferPosition, pre);
 	}
 }
 
@@ -332,10 +507,10 @@ void DrawMissile(const Surface &out, Point tilePosition, Point targetBufferPosit
  * @param targetBufferPosition Output buffer coordinates
  * @param m Id of monster
  */
-void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosition, const Monster &monster)
+void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosition, const SnapshotMonster &monster)
 {
 	if (monster.AnimInfo.pCelSprite == nullptr) {
-		Log("Draw Monster \"{}\": NULL Cel Buffer", monster.mName);
+		Log("Draw Monster \"{}\": NULL Cel Buffer", monster.name);
 		return;
 	}
 
@@ -400,15 +575,15 @@ void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosit
 		}
 	};
 
-	int nCel = monster.AnimInfo.GetFrameToUseForRendering();
+	int nCel = monster.AnimInfo.GetFrameToUseForRendering(Frame->progress);
 	const auto *frameTable = reinterpret_cast<const uint32_t *>(monster.AnimInfo.pCelSprite->Data());
 	int frames = SDL_SwapLE32(frameTable[0]);
 	if (nCel < 1 || frames > 50 || nCel > frames) {
 		Log(
 		    "Draw Monster \"{}\" {}: facing {}, frame {} of {}",
-		    monster.mName,
-		    getMonsterModeDisplayName(monster._mmode),
-		    monster._mdir,
+		    monster.name,
+		    getMonsterModeDisplayName(monster.mode),
+		    monster.dir,
 		    nCel,
 		    frames);
 		return;
@@ -420,12 +595,10 @@ void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosit
 		Cl2DrawLightTbl(out, targetBufferPosition.x, targetBufferPosition.y, cel, nCel, 1);
 		return;
 	}
-	int trans = 0;
-	if (monster._uniqtype != 0)
-		trans = monster._uniqtrans + 4;
-	if (monster._mmode == MonsterMode::Petrified)
+	int trans = monster.uniqueTrans;
+	if (monster.mode == MonsterMode::Petrified)
 		trans = 2;
-	if (Players[MyPlayerId]._pInfraFlag && LightTableIndex > 8)
+	if (Scene->infravision && LightTableIndex > 8)
 		trans = 1;
 	if (trans != 0)
 		Cl2DrawLightTbl(out, targetBufferPosition.x, targetBufferPosition.y, cel, nCel, trans);
@@ -438,7 +611,7 @@ void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosit
  */
 void DrawPlayerIconHelper(const Surface &out, int pnum, missile_graphic_id missileGraphicId, Point position, bool lighting)
 {
-	position.x += CalculateWidth2(Players[pnum].AnimInfo.pCelSprite->Width()) - MissileSpriteData[missileGraphicId].animWidth2;
+	position.x += CalculateWidth2(Scene->players[pnum].AnimInfo.pCelSprite->Width()) - MissileSpriteData[missileGraphicId].animWidth2;
 
 	int width = MissileSpriteData[missileGraphicId].animWidth;
 	std::byte *pCelBuff = MissileSpriteData[missileGraphicId].animData[0].get();
@@ -467,10 +640,10 @@ void DrawPlayerIconHelper(const Surface &out, int pnum, missile_graphic_id missi
  */
 void DrawPlayerIcons(const Surface &out, int pnum, Point position, bool lighting)
 {
-	auto &player = Players[pnum];
-	if (player.pManaShield)
+	auto &player = Scene->players[pnum];
+	if (player.manaShield)
 		DrawPlayerIconHelper(out, pnum, MFILE_MANASHLD, position, lighting);
-	if (player.wReflections > 0)
+	if (player.reflect)
 		DrawPlayerIconHelper(out, pnum, MFILE_REFLECT, position + Displacement { 0, 16 }, lighting);
 }
 
@@ -486,37 +659,37 @@ void DrawPlayerIcons(const Surface &out, int pnum, Point position, bool lighting
  */
 void DrawPlayer(const Surface &out, int pnum, Point tilePosition, Point targetBufferPosition)
 {
-	if ((dFlags[tilePosition.x][tilePosition.y] & BFLAG_LIT) == 0 && !Players[MyPlayerId]._pInfraFlag && leveltype != DTYPE_TOWN) {
+	if ((dFlags[tilePosition.x][tilePosition.y] & BFLAG_LIT) == 0 && !Scene->infravision && leveltype != DTYPE_TOWN) {
 		return;
 	}
 
-	auto &player = Players[pnum];
+	auto &player = Scene->players[pnum];
 
 	const auto *pCelSprite = player.AnimInfo.pCelSprite;
-	int nCel = player.AnimInfo.GetFrameToUseForRendering();
+	int nCel = player.AnimInfo.GetFrameToUseForRendering(Frame->progress);
 
 	if (pCelSprite == nullptr) {
-		Log("Drawing player {} \"{}\": NULL CelSprite", pnum, player._pName);
+		Log("Drawing player {} \"{}\": NULL CelSprite", pnum, player.name);
 		return;
 	}
 
 	int frames = SDL_SwapLE32(*reinterpret_cast<const DWORD *>(pCelSprite->Data()));
 	if (nCel < 1 || frames > 50 || nCel > frames) {
 		const char *szMode = "unknown action";
-		if (player._pmode <= PM_QUIT)
-			szMode = PlayerModeNames[player._pmode];
+		if (player.mode <= PM_QUIT)
+			szMode = PlayerModeNames[player.mode];
 		Log(
 		    "Drawing player {} \"{}\" {}: facing {}, frame {} of {}",
 		    pnum,
-		    player._pName,
+		    player.name,
 		    szMode,
-		    player._pdir,
+		    player.dir,
 		    nCel,
 		    frames);
 		return;
 	}
 
-	if (pnum == pcursplr)
+	if (pnum == Frame->cursPlayer)
 		Cl2DrawOutline(out, 165, targetBufferPosition.x, targetBufferPosition.y, *pCelSprite, nCel);
 
 	if (pnum == MyPlayerId) {
@@ -525,7 +698,7 @@ void DrawPlayer(const Surface &out, int pnum, Point tilePosition, Point targetBu
 		return;
 	}
 
-	if ((dFlags[tilePosition.x][tilePosition.y] & BFLAG_LIT) == 0 || (Players[MyPlayerId]._pInfraFlag && LightTableIndex > 8)) {
+	if ((dFlags[tilePosition.x][tilePosition.y] & BFLAG_LIT) == 0 || (Scene->infravision && LightTableIndex > 8)) {
 		Cl2DrawLightTbl(out, targetBufferPosition.x, targetBufferPosition.y, *pCelSprite, nCel, 1);
 		DrawPlayerIcons(out, pnum, targetBufferPosition, true);
 		return;
@@ -551,14 +724,11 @@ void DrawPlayer(const Surface &out, int pnum, Point tilePosition, Point targetBu
  */
 void DrawDeadPlayer(const Surface &out, Point tilePosition, Point targetBufferPosition)
 {
-	dFlags[tilePosition.x][tilePosition.y] &= ~BFLAG_DEAD_PLAYER;
-
 	for (int i = 0; i < MAX_PLRS; i++) {
-		auto &player = Players[i];
-		if (player.plractive && player._pHitPoints == 0 && player.plrlevel == (BYTE)currlevel && player.position.tile == tilePosition) {
-			dFlags[tilePosition.x][tilePosition.y] |= BFLAG_DEAD_PLAYER;
+		auto &player = Scene->players[i];
+		if (player.dead && player.tile == tilePosition) {
 			const Displacement center { CalculateWidth2(player.AnimInfo.pCelSprite == nullptr ? 96 : player.AnimInfo.pCelSprite->Width()), 0 };
-			const Point playerRenderPosition { targetBufferPosition + player.position.offset - center };
+			const Point playerRenderPosition { targetBufferPosition + player.offset - center };
 			DrawPlayer(out, i, tilePosition, playerRenderPosition);
 		}
 	}
@@ -573,7 +743,7 @@ void DrawDeadPlayer(const Surface &out, Point tilePosition, Point targetBufferPo
  */
 void DrawObject(const Surface &out, Point tilePosition, Point targetBufferPosition, bool pre)
 {
-	int8_t bv = dObject[tilePosition.x][tilePosition.y];
+	int bv = dObject[tilePosition.x][tilePosition.y];
 	if (bv == 0 || LightTableIndex >= LightsMax)
 		return;
 
@@ -581,41 +751,42 @@ void DrawObject(const Surface &out, Point tilePosition, Point targetBufferPositi
 
 	if (bv > 0) {
 		bv = bv - 1;
-		if (Objects[bv]._oPreFlag != pre)
+		if (Scene->objects[bv].preFlag != pre)
 			return;
-		objectPosition = targetBufferPosition - Displacement { CalculateWidth2(Objects[bv]._oAnimWidth), 0 };
+		objectPosition = targetBufferPosition - Displacement { CalculateWidth2(Scene->objects[bv].animWidth), 0 };
 	} else {
 		bv = -(bv + 1);
-		if (Objects[bv]._oPreFlag != pre)
+		if (Scene->objects[bv].preFlag != pre)
 			return;
-		int xx = Objects[bv].position.x - tilePosition.x;
-		int yy = Objects[bv].position.y - tilePosition.y;
-		objectPosition.x = (xx * TILE_WIDTH / 2) + targetBufferPosition.x - CalculateWidth2(Objects[bv]._oAnimWidth) - (yy * TILE_WIDTH / 2);
+		int xx = Scene->objects[bv].position.x - tilePosition.x;
+		int yy = Scene->objects[bv].position.y - tilePosition.y;
+		objectPosition.x = (xx * TILE_WIDTH / 2) + targetBufferPosition.x - CalculateWidth2(Scene->objects[bv].animWidth) - (yy * TILE_WIDTH / 2);
 		objectPosition.y = targetBufferPosition.y + (yy * TILE_HEIGHT / 2) + (xx * TILE_HEIGHT / 2);
 	}
 
 	assert(bv >= 0 && bv < MAXOBJECTS);
 
-	std::byte *pCelBuff = Objects[bv]._oAnimData;
+	const SnapshotObject &object = Scene->objects[bv];
+	std::byte *pCelBuff = object.animData;
 	if (pCelBuff == nullptr) {
-		Log("Draw Object type {}: NULL Cel Buffer", Objects[bv]._otype);
+		Log("Draw Object type {}: NULL Cel Buffer", object.type);
 		return;
 	}
 
-	uint32_t nCel = Objects[bv]._oAnimFrame;
+	uint32_t nCel = object.animFrame;
 	uint32_t frames = LoadLE32(pCelBuff);
 	if (nCel < 1 || frames > 50 || nCel > frames) {
-		Log("Draw Object: frame {} of {}, object type=={}", nCel, frames, Objects[bv]._otype);
+		Log("Draw Object: frame {} of {}, object type=={}", nCel, frames, object.type);
 		return;
 	}
 
-	CelSprite cel { Objects[bv]._oAnimData, Objects[bv]._oAnimWidth };
-	if (bv == pcursobj)
-		CelBlitOutlineTo(out, 194, objectPosition, cel, Objects[bv]._oAnimFrame);
-	if (Objects[bv]._oLight) {
-		CelClippedDrawLightTo(out, objectPosition, cel, Objects[bv]._oAnimFrame);
+	CelSprite cel { object.animData, object.animWidth };
+	if (bv == Frame->cursObject)
+		CelBlitOutlineTo(out, 194, objectPosition, cel, object.animFrame);
+	if (object.light) {
+		CelClippedDrawLightTo(out, objectPosition, cel, object.animFrame);
 	} else {
-		CelClippedDrawTo(out, objectPosition, cel, Objects[bv]._oAnimFrame);
+		CelClippedDrawTo(out, objectPosition, cel, object.animFrame);
 	}
 }
 
@@ -681,36 +852,36 @@ void DrawFloor(const Surface &out, Point tilePosition, Point targetBufferPositio
  */
 void DrawItem(const Surface &out, Point tilePosition, Point targetBufferPosition, bool pre)
 {
-	int8_t bItem = dItem[tilePosition.x][tilePosition.y];
+	int bItem = dItem[tilePosition.x][tilePosition.y];
 
 	if (bItem <= 0)
 		return;
 
-	auto &item = Items[bItem - 1];
-	if (item._iPostDraw == pre)
+	auto &item = Scene->items[bItem - 1];
+	if (item.postDraw == pre)
 		return;
 
 	const auto *cel = item.AnimInfo.pCelSprite;
 	if (cel == nullptr) {
-		Log("Draw Item \"{}\" 1: NULL CelSprite", item._iIName);
+		Log("Draw Item {} 1: NULL CelSprite", bItem - 1);
 		return;
 	}
 
-	int nCel = item.AnimInfo.GetFrameToUseForRendering();
+	int nCel = item.AnimInfo.GetFrameToUseForRendering(Frame->progress);
 	int frames = SDL_SwapLE32(*(DWORD *)cel->Data());
 	if (nCel < 1 || frames > 50 || nCel > frames) {
-		Log("Draw \"{}\" Item 1: frame {} of {}, item type=={}", item._iIName, nCel, frames, item._itype);
+		Log("Draw Item {} 1: frame {} of {}, item type=={}", bItem - 1, nCel, frames, item.type);
 		return;
 	}
 
 	int px = targetBufferPosition.x - CalculateWidth2(cel->Width());
 	const Point position { px, targetBufferPosition.y };
-	if (bItem - 1 == pcursitem || AutoMapShowItems) {
-		CelBlitOutlineTo(out, GetOutlineColor(item, false), position, *cel, nCel);
+	if (bItem - 1 == Frame->cursItem || Frame->showItems) {
+		CelBlitOutlineTo(out, item.outlineColor, position, *cel, nCel);
 	}
 	CelClippedDrawLightTo(out, position, *cel, nCel);
-	if (item.AnimInfo.CurrentFrame == item.AnimInfo.NumberOfFrames || item._iCurs == ICURS_MAGIC_ROCK)
-		AddItemToLabelQueue(bItem - 1, px, targetBufferPosition.y);
+	if (item.labeled)
+		ItemLabels->push_back({ bItem - 1, px, targetBufferPosition.y });
 }
 
 /**
@@ -725,18 +896,18 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 	mi = mi > 0 ? mi - 1 : -(mi + 1);
 
 	if (leveltype == DTYPE_TOWN) {
-		auto &towner = Towners[mi];
-		int px = targetBufferPosition.x - CalculateWidth2(towner._tAnimWidth);
+		auto &towner = Scene->towners[mi];
+		int px = targetBufferPosition.x - CalculateWidth2(towner.animWidth);
 		const Point position { px, targetBufferPosition.y };
-		if (mi == pcursmonst) {
-			CelBlitOutlineTo(out, 166, position, CelSprite(towner._tAnimData, towner._tAnimWidth), towner._tAnimFrame);
+		if (mi == Frame->cursMonster) {
+			CelBlitOutlineTo(out, 166, position, CelSprite(towner.animData, towner.animWidth), towner.animFrame);
 		}
-		assert(towner._tAnimData);
-		CelClippedDrawTo(out, position, CelSprite(towner._tAnimData, towner._tAnimWidth), towner._tAnimFrame);
+		assert(towner.animData);
+		CelClippedDrawTo(out, position, CelSprite(towner.animData, towner.animWidth), towner.animFrame);
 		return;
 	}
 
-	if ((dFlags[tilePosition.x][tilePosition.y] & BFLAG_LIT) == 0 && !Players[MyPlayerId]._pInfraFlag)
+	if ((dFlags[tilePosition.x][tilePosition.y] & BFLAG_LIT) == 0 && !Scene->infravision)
 		return;
 
 	if (mi < 0 || mi >= MAXMONSTERS) {
@@ -744,26 +915,26 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 		return;
 	}
 
-	const auto &monster = Monsters[mi];
-	if ((monster._mFlags & MFLAG_HIDDEN) != 0) {
+	const auto &monster = Scene->monsters[mi];
+	if (monster.hidden) {
 		return;
 	}
 
-	if (monster.MType == nullptr) {
-		Log("Draw Monster \"{}\": uninitialized monster", monster.mName);
+	if (!monster.initialized) {
+		Log("Draw Monster \"{}\": uninitialized monster", monster.name);
 		return;
 	}
 
 	const CelSprite &cel = *monster.AnimInfo.pCelSprite;
 
-	Displacement offset = monster.position.offset;
-	if (monster.IsWalking()) {
-		offset = GetOffsetForWalking(monster.AnimInfo, monster._mdir);
+	Displacement offset = monster.offset;
+	if (monster.walking) {
+		offset = GetOffsetForWalking(monster.AnimInfo, monster.dir, Frame->progress, false);
 	}
 
 	const Point monsterRenderPosition { targetBufferPosition + offset - Displacement { CalculateWidth2(cel.Width()), 0 } };
-	if (mi == pcursmonst) {
-		Cl2DrawOutline(out, 233, monsterRenderPosition.x, monsterRenderPosition.y, cel, monster.AnimInfo.GetFrameToUseForRendering());
+	if (mi == Frame->cursMonster) {
+		Cl2DrawOutline(out, 233, monsterRenderPosition.x, monsterRenderPosition.y, cel, monster.AnimInfo.GetFrameToUseForRendering(Frame->progress));
 	}
 	DrawMonster(out, tilePosition, monsterRenderPosition, monster);
 }
@@ -783,11 +954,11 @@ void DrawPlayerHelper(const Surface &out, Point tilePosition, Point targetBuffer
 		Log("draw player: tried to draw illegal player {}", p);
 		return;
 	}
-	auto &player = Players[p];
+	auto &player = Scene->players[p];
 
-	Displacement offset = player.position.offset;
-	if (player.IsWalking()) {
-		offset = GetOffsetForWalking(player.AnimInfo, player._pdir);
+	Displacement offset = player.offset;
+	if (player.walking) {
+		offset = GetOffsetForWalking(player.AnimInfo, player.dir, Frame->progress, false);
 	}
 
 	const Displacement center { CalculateWidth2(player.AnimInfo.pCelSprite == nullptr ? 96 : player.AnimInfo.pCelSprite->Width()), 0 };
@@ -823,16 +994,16 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 	if (DebugVision && (bFlag & BFLAG_LIT) != 0) {
 		CelClippedDrawTo(out, targetBufferPosition, *pSquareCel, 1);
 	}
-	DebugCoordsMap[tilePosition.x + tilePosition.y * MAXDUNX] = targetBufferPosition;
+	(*TileCoords)[tilePosition.x + tilePosition.y * MAXDUNX] = targetBufferPosition;
 #endif
 
-	if (MissilePreFlag) {
+	if (Scene->missilePreFlag) {
 		DrawMissile(out, tilePosition, targetBufferPosition, true);
 	}
 
 	if (LightTableIndex < LightsMax && bDead != 0) {
 		do {
-			Corpse *pDeadGuy = &Corpses[(bDead & 0x1F) - 1];
+			const Corpse *pDeadGuy = &Scene->corpses[(bDead & 0x1F) - 1];
 			int px = targetBufferPosition.x - CalculateWidth2(pDeadGuy->width);
 			const std::byte *pCelBuff = pDeadGuy->data[(bDead >> 5) & 7];
 			assert(pCelBuff != nullptr);
@@ -940,7 +1111,7 @@ void DrawFloor(const Surface &out, Point tilePosition, Point targetBufferPositio
 }
 
 #define IsWall(x, y) (dPiece[x][y] == 0 || nSolidTable[dPiece[x][y]] || dSpecial[x][y] != 0)
-#define IsWalkable(x, y) (dPiece[x][y] != 0 && IsTileNotSolid({ x, y }))
+#define IsWalkable(x, y) (dPiece[x][y] != 0 && !nSolidTable[dPiece[x][y]])
 
 /**
  * @brief Render a row of tile
@@ -959,7 +1130,7 @@ void DrawTileContent(const Surface &out, Point tilePosition, Point targetBufferP
 	for (int i = 0; i < rows; i++) {
 		for (int j = 0; j < columns; j++) {
 			if (tilePosition.x >= 0 && tilePosition.x < MAXDUNX && tilePosition.y >= 0 && tilePosition.y < MAXDUNY) {
-				if (tilePosition.x + 1 < MAXDUNX && tilePosition.y - 1 >= 0 && targetBufferPosition.x + TILE_WIDTH <= gnScreenWidth) {
+				if (tilePosition.x + 1 < MAXDUNX && tilePosition.y - 1 >= 0 && targetBufferPosition.x + TILE_WIDTH <= Frame->screenWidth) {
 					// Render objects behind walls first to prevent sprites, that are moving
 					// between tiles, from poking through the walls as they exceed the tile bounds.
 					// A proper fix for this would probably be to layout the sceen and render by
@@ -1002,13 +1173,11 @@ void Zoom(const Surface &out)
 {
 	int viewportWidth = out.w();
 	int viewportOffsetX = 0;
-	if (CanPanelsCoverView()) {
-		if (chrflag || QuestLogIsOpen) {
-			viewportWidth -= SPANEL_WIDTH;
-			viewportOffsetX = SPANEL_WIDTH;
-		} else if (invflag || sbookflag) {
-			viewportWidth -= SPANEL_WIDTH;
-		}
+	if (Frame->leftPanelOpen) {
+		viewportWidth -= SPANEL_WIDTH;
+		viewportOffsetX = SPANEL_WIDTH;
+	} else if (Frame->rightPanelOpen) {
+		viewportWidth -= SPANEL_WIDTH;
 	}
 
 	// We round to even for the source width and height.
@@ -1057,60 +1226,57 @@ int tileRows;
 
 /**
  * @brief Configure render and process screen rows
- * @param full_out Buffer to render to
- * @param position Center of view in dPiece coordinate
+ * @param fullOut Buffer to render to
  */
-void DrawGame(const Surface &fullOut, Point position)
+void DrawGame(const Surface &fullOut)
 {
 	// Limit rendering to the view area
-	const Surface &out = zoomflag
-	    ? fullOut.subregionY(0, gnViewportHeight)
-	    : fullOut.subregionY(0, (gnViewportHeight + 1) / 2);
+	const Surface &out = Frame->zoom
+	    ? fullOut.subregionY(0, Frame->viewportHeight)
+	    : fullOut.subregionY(0, (Frame->viewportHeight + 1) / 2);
 
 	// Adjust by player offset and tile grid alignment
-	auto &myPlayer = Players[MyPlayerId];
-	Displacement offset = ScrollInfo.offset;
-	if (myPlayer.IsWalking())
-		offset = GetOffsetForWalking(myPlayer.AnimInfo, myPlayer._pdir, true);
-	int sx = offset.deltaX + tileOffset.deltaX;
-	int sy = offset.deltaY + tileOffset.deltaY;
+	const auto &myPlayer = Scene->players[MyPlayerId];
+	Displacement offset = Scene->scroll.offset;
+	if (myPlayer.walking)
+		offset = GetOffsetForWalking(myPlayer.AnimInfo, myPlayer.dir, Frame->progress, true);
+	int sx = offset.deltaX + Frame->tileOffset.deltaX;
+	int sy = offset.deltaY + Frame->tileOffset.deltaY;
 
-	int columns = tileColums;
-	int rows = tileRows;
+	int columns = Frame->tileColumns;
+	int rows = Frame->tileRows;
 
-	position += tileShift;
+	Point position = Frame->position + Frame->tileShift;
 
 	// Skip rendering parts covered by the panels
-	if (CanPanelsCoverView()) {
-		if (zoomflag) {
-			if (chrflag || QuestLogIsOpen) {
-				position += Displacement(Direction::East) * 2;
-				columns -= 4;
-				sx += SPANEL_WIDTH - TILE_WIDTH / 2;
-			}
-			if (invflag || sbookflag) {
-				position += Displacement(Direction::East) * 2;
-				columns -= 4;
-				sx += -TILE_WIDTH / 2;
-			}
-		} else {
-			if (chrflag || QuestLogIsOpen) {
-				position += Direction::East;
-				columns -= 2;
-				sx += -TILE_WIDTH / 2 / 2; // SPANEL_WIDTH accounted for in Zoom()
-			}
-			if (invflag || sbookflag) {
-				position += Direction::East;
-				columns -= 2;
-				sx += -TILE_WIDTH / 2 / 2;
-			}
+	if (Frame->zoom) {
+		if (Frame->leftPanelOpen) {
+			position += Displacement(Direction::East) * 2;
+			columns -= 4;
+			sx += SPANEL_WIDTH - TILE_WIDTH / 2;
+		}
+		if (Frame->rightPanelOpen) {
+			position += Displacement(Direction::East) * 2;
+			columns -= 4;
+			sx += -TILE_WIDTH / 2;
+		}
+	} else {
+		if (Frame->leftPanelOpen) {
+			position += Direction::East;
+			columns -= 2;
+			sx += -TILE_WIDTH / 2 / 2; // SPANEL_WIDTH accounted for in Zoom()
+		}
+		if (Frame->rightPanelOpen) {
+			position += Direction::East;
+			columns -= 2;
+			sx += -TILE_WIDTH / 2 / 2;
 		}
 	}
 
 	UpdateMissilesRendererData();
 
 	// Draw areas moving in and out of the screen
-	switch (ScrollInfo._sdir) {
+	switch (Scene->scroll._sdir) {
 	case ScrollDirection::North:
 		sy -= TILE_HEIGHT;
 		position += Direction::North;
@@ -1157,9 +1323,170 @@ void DrawGame(const Surface &fullOut, Point position)
 	DrawFloor(out, position, { sx, sy }, rows, columns);
 	DrawTileContent(out, position, { sx, sy }, rows, columns);
 
-	if (!zoomflag) {
-		Zoom(fullOut.subregionY(0, gnViewportHeight));
+	if (!Frame->zoom) {
+		Zoom(fullOut.subregionY(0, Frame->viewportHeight));
+	}
+}
+
+/**
+ * @brief What is found while drawing the dungeon that the panels drawn on top of it need
+ */
+struct WorldDrawResult {
+	std::vector<QueuedItemLabel> itemLabels;
+#ifdef _DEBUG
+	std::unordered_map<int, Point> tileCoords;
+#endif
+};
+
+/**
+ * @brief Draws the dungeon from a snapshot
+ * @param out Buffer to render to
+ * @param snapshot Actors in view, the drawn positions of the missiles are written to it
+ * @param frame State of the view
+ * @param result Receives what was found while drawing
+ */
+void DrawSnapshot(const Surface &out, WorldSnapshot &snapshot, const WorldFrame &frame, WorldDrawResult &result)
+{
+	Scene = &snapshot;
+	Frame = &frame;
+	result.itemLabels.clear();
+	ItemLabels = &result.itemLabels;
+#ifdef _DEBUG
+	result.tileCoords.clear();
+	TileCoords = &result.tileCoords;
+#endif
+
+	DrawGame(out);
+
+	Scene = nullptr;
+	Frame = nullptr;
+	ItemLabels = nullptr;
+#ifdef _DEBUG
+	TileCoords = nullptr;
+#endif
+}
+
+WorldFrame GetWorldFrame(Point position)
+{
+	WorldFrame frame;
+	frame.position = position;
+	frame.progress = gfProgressToNextGameTick;
+	frame.zoom = zoomflag;
+	frame.leftPanelOpen = CanPanelsCoverView() && (chrflag || QuestLogIsOpen);
+	frame.rightPanelOpen = CanPanelsCoverView() && (invflag || sbookflag);
+	frame.showItems = AutoMapShowItems;
+	frame.cursMonster = pcursmonst;
+	frame.cursPlayer = pcursplr;
+	frame.cursObject = pcursobj;
+	frame.cursItem = pcursitem;
+	frame.tileOffset = tileOffset;
+	frame.tileShift = tileShift;
+	frame.tileColumns = tileColums;
+	frame.tileRows = tileRows;
+	frame.screenWidth = gnScreenWidth;
+	frame.viewportHeight = gnViewportHeight;
+	return frame;
+}
+
+/**
+ * @brief Finds the tiles the dungeon is drawn from in the given view
+ *
+ * Covers the rows DrawGame walks with the panels closed and the view scrolling, along with the neighbouring tiles that
+ * the drawing of a tile looks at.
+ */
+Rectangle GetDrawnTiles(const WorldFrame &frame)
+{
+	constexpr int Margin = 2;
+
+	Point position = frame.position + frame.tileShift;
+	int columns = frame.tileColumns + 1;
+	const int rows = frame.tileRows + 2 + MicroTileLen;
+
+	Point first = position;
+	Point last = position;
+	for (int i = 0; i < rows; i++) {
+		const Point rowEnd = position + Displacement(Direction::East) * (columns - 1);
+		first.x = std::min(first.x, position.x);
+		first.y = std::min(first.y, rowEnd.y);
+		last.x = std::max(last.x, rowEnd.x);
+		last.y = std::max(last.y, position.y);
+		if ((i & 1) != 0) {
+			position.x++;
+			columns--;
+		} else {
+			position.y++;
+			columns++;
+		}
+	}
+
+	first.x = std::max(first.x - Margin, 0);
+	first.y = std::max(first.y - Margin, 0);
+	last.x = std::min(last.x + Margin, MAXDUNX - 1);
+	last.y = std::min(last.y + Margin, MAXDUNY - 1);
+	if (first.x > last.x || first.y > last.y)
+		return { { 0, 0 }, { 0, 0 } };
+	return { first, { last.x - first.x + 1, last.y - first.y + 1 } };
+}
+
+/** View of the world the dungeon is drawn from */
+std::unique_ptr<WorldSnapshot> WorldView;
+/** Result of the last time the dungeon was drawn */
+WorldDrawResult WorldResult;
+
+/**
+ * @brief What the render thread draws next
+ *
+ * Written by the main thread before it posts RenderRequested, only read by the render thread after it was woken up.
+ */
+struct RenderRequest {
+	const Surface *out;
+	WorldSnapshot *snapshot;
+	const WorldFrame *frame;
+	WorldDrawResult *result;
+};
+
+SdlThread RenderThread;
+/** Posted by the main thread when the render thread has a frame to draw or has to stop */
+SdlSemaphore RenderRequested;
+/** Posted by the render thread when it has drawn the frame */
+SdlSemaphore RenderDone;
+std::atomic<bool> RenderStopping;
+RenderRequest PendingRender;
+
+void RenderWorld()
+{
+	while (true) {
+		RenderRequested.wait();
+		if (RenderStopping.load(std::memory_order_acquire))
+			return;
+		DrawSnapshot(*PendingRender.out, *PendingRender.snapshot, *PendingRender.frame, *PendingRender.result);
+		RenderDone.post();
+	}
+}
+
+/**
+ * @brief Draws the dungeon, on the render thread if it is running
+ * @param out Buffer to render to
+ * @param position Center of view in dPiece coordinates
+ * @return What was found while drawing the dungeon
+ */
+const WorldDrawResult &DrawWorld(const Surface &out, Point position)
+{
+	const WorldFrame frame = GetWorldFrame(position);
+	if (WorldView == nullptr)
+		WorldView = std::make_unique<WorldSnapshot>();
+	CaptureWorldSnapshot(*WorldView, GetDrawnTiles(frame));
+
+	if (!RenderThread.joinable()) {
+		DrawSnapshot(out, *WorldView, frame, WorldResult);
+		return WorldResult;
 	}
+
+	// The world is drawn in place, so the main thread leaves it alone until the render thread is done
+	PendingRender = { &out, WorldView.get(), &frame, &WorldResult };
+	RenderRequested.post();
+	RenderDone.wait();
+	return WorldResult;
 }
 
 /**
@@ -1169,10 +1496,12 @@ void DrawGame(const Surface &fullOut, Point position)
  */
 void DrawView(const Surface &out, Point startPosition)
 {
+	const WorldDrawResult &world = DrawWorld(out, startPosition);
+	for (const QueuedItemLabel &label : world.itemLabels)
+		AddItemToLabelQueue(label.id, label.x, label.y);
 #ifdef _DEBUG
-	DebugCoordsMap.clear();
+	DebugCoordsMap = world.tileCoords;
 #endif
-	DrawGame(out, startPosition);
 	if (AutomapActive) {
 		DrawAutomap(out.subregionY(0, gnViewportHeight));
 	}
@@ -1271,7 +1600,7 @@ void DrawView(const Surface &out, Point startPosition)
 	DrawPlrMsg(out);
 	gmenu_draw(out);
 	doom_draw(out);
-	DrawInfoBox(out);
+	UpdateInfoBox();
 	control_update_life_mana(); // Update life/mana totals before rendering any portion of the flask.
 	DrawLifeFlaskUpper(out);
 	DrawManaFlaskUpper(out);
@@ -1282,22 +1611,17 @@ void DrawView(const Surface &out, Point startPosition)
  */
 void DrawFPS(const Surface &out)
 {
-	char string[12];
+	char string[32];
 
 	if (!frameflag || !gbActive) {
 		return;
 	}
 
-	frameend++;
-	uint32_t tc = SDL_GetTicks();
-	uint32_t frames = tc - framestart;
-	if (tc - framestart >= 1000) {
-		framestart = tc;
-		framerate = 1000 * frameend / frames;
-		frameend = 0;
-	}
-	snprintf(string, 12, "%i FPS", framerate);
+	const FrameTimeStats stats = GetFrameTimeStats();
+	snprintf(string, sizeof(string), "%i FPS", stats.frames);
 	DrawString(out, string, Point { 8, 53 }, UiFlags::ColorRed);
+	snprintf(string, sizeof(string), "%.1f ms, max %.1f ms", stats.averageMs, stats.maxMs);
+	DrawString(out, string, Point { 8, 68 }, UiFlags::ColorRed);
 }
 
 /**
@@ -1336,23 +1660,7 @@ void DrawMain()
 
 Displacement GetOffsetForWalking(const AnimationInfo &animationInfo, const Direction dir, bool cameraMode /*= false*/)
 {
-	// clang-format off
-	//                                           South,        SouthWest,    West,         NorthWest,    North,        NorthEast,     East,         SouthEast,
-	constexpr Displacement StartOffset[8]    = { {   0, -32 }, {  32, -16 }, {  64,   0 }, {   0,   0 }, {   0,   0 }, {  0,    0 },  { -64,   0 }, { -32, -16 } };
-	constexpr Displacement MovingOffset[8]   = { {   0,  32 }, { -32,  16 }, { -64,   0 }, { -32, -16 }, {   0, -32 }, {  32, -16 },  {  64,   0 }, {  32,  16 } };
-	// clang-format on
-
-	float fAnimationProgress = animationInfo.GetAnimationProgress();
-	Displacement offset = MovingOffset[static_cast<size_t>(dir)];
-	offset *= fAnimationProgress;
-
-	if (cameraMode) {
-		offset = -offset;
-	} else {
-		offset += StartOffset[static_cast<size_t>(dir)];
-	}
-
-	return offset;
+	return GetOffsetForWalking(animationInfo, dir, gfProgressToNextGameTick, cameraMode);
 }
 
 void ClearCursor() // CODE_FIX: this was supposed to be in cursor.cpp
@@ -1568,7 +1876,25 @@ void ScrollView()
 void EnableFrameCount()
 {
 	frameflag = !frameflag;
-	framestart = SDL_GetTicks();
+}
+
+void StartWorldRenderThread()
+{
+	if (RenderThread.joinable())
+		return;
+
+	RenderStopping.store(false, std::memory_order_relaxed);
+	RenderThread = SdlThread { RenderWorld };
+}
+
+void StopWorldRenderThread()
+{
+	if (!RenderThread.joinable())
+		return;
+
+	RenderStopping.store(true, std::memory_order_release);
+	RenderRequested.post();
+	RenderThread.join();
 }
 
 void scrollrt_draw_game_screen()
@@ -1598,6 +1924,8 @@ void DrawAndBlit()
 		return;
 	}
 
+	const Uint64 drawStart = SDL_GetPerformanceCounter();
+
 	lock_buf(0);
 	const Surface &out = GlobalBackBuffer();
 	UndrawCursor(out);
@@ -1605,16 +1933,7 @@ void DrawAndBlit()
 	nthread_UpdateProgressToNextGameTick();
 
 	DrawView(out, ViewPosition);
-	DrawCtrlPan(out);
-	DrawLifeFlaskLower(out);
-	DrawManaFlaskLower(out);
-	DrawSpell(out);
-	DrawCtrlBtns(out);
-	DrawInvBelt(out);
-	if (talkflag) {
-		DrawTalkPan(out);
-	}
-	DrawXPBar(out);
+	DrawMainPanel(out);
 
 	if (IsHardwareCursor()) {
 		SetHardwareCursorVisible(ShouldShowCursor());
@@ -1626,9 +1945,13 @@ void DrawAndBlit()
 
 	unlock_buf(0);
 
+	const Uint64 presentStart = SDL_GetPerformanceCounter();
+
 	DrawMain();
 
 	RenderPresent();
+
+	CaptureFrame(presentStart - drawStart, SDL_GetPerformanceCounter() - presentStart);
 }
 
 } // namespace devilution
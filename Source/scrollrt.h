@@ -25,12 +25,12 @@ enum class ScrollDirection : uint8_t {
 	NorthWest,
 };
 
-extern int LightTableIndex;
-extern uint32_t level_cel_block;
-extern char arch_draw_type;
-extern bool cel_transparency_active;
-extern bool cel_foliage_active;
-extern int level_piece_id;
+extern thread_local int LightTableIndex;
+extern thread_local uint32_t level_cel_block;
+extern thread_local char arch_draw_type;
+extern thread_local bool cel_transparency_active;
+extern thread_local bool cel_foliage_active;
+extern thread_local int level_piece_id;
 extern bool AutoMapShowItems;
 
 /**
@@ -91,6 +91,19 @@ void ScrollView();
  */
 void EnableFrameCount();
 
+/**
+ * @brief Starts drawing the dungeon on a separate thread
+ *
+ * The render thread draws the dungeon of the frame that is being drawn, the main thread waits for it before drawing
+ * anything on top.
+ */
+void StartWorldRenderThread();
+
+/**
+ * @brief Stops the render thread, the dungeon is drawn on the main thread again
+ */
+void StopWorldRenderThread();
+
 /**
  * @brief Redraw screen
  */
@@ -6,6 +6,9 @@
 #include "sha.h"
 
 #include <cstdint>
+#include <cstring>
+#include <utility>
+
 #include <SDL.h>
 
 #include "appfat.h"
@@ -17,134 +20,113 @@ namespace devilution {
 
 namespace {
 
-struct SHA1Context {
-	uint32_t state[SHA1HashSize / sizeof(uint32_t)];
-	uint32_t buffer[BlockSize / sizeof(uint32_t)];
-};
-
-SHA1Context sgSHA1[3];
-
 /**
- * Diablo-"SHA1" circular left shift, portable version.
+ * Diablo-"SHA1" circular left shift.
+ *
+ * The SHA-like algorithm as originally implemented treated word as a signed value and used arithmetic right shifts
+ * (sign-extending). This results in the high 32-`bits` bits being set to 1 for negative words, which is what the
+ * arithmetic shift of the signed value gives without branching.
  */
-uint32_t SHA1CircularShift(uint32_t word, size_t bits)
+template <int bits>
+uint32_t SHA1CircularShift(uint32_t word)
 {
-	assert(bits < 32);
-	assert(bits > 0);
-
-	// The SHA-like algorithm as originally implemented treated word as a signed value and used arithmetic right shifts
-	//  (sign-extending). This results in the high 32-`bits` bits being set to 1.
-	if ((word & (1 << 31)) != 0)
-		return (0xFFFFFFFF << bits) | (word >> (32 - bits));
-	return (word << bits) | (word >> (32 - bits));
+	static_assert(bits > 0 && bits < 32, "Shift must leave part of the word in place");
+	return (word << bits) | static_cast<uint32_t>(static_cast<int32_t>(word) >> (32 - bits));
 }
 
-void SHA1Init(SHA1Context *context)
+/**
+ * The message schedule only looks 16 words back, so it is kept in a ring of 16 words that is extended as the rounds go.
+ */
+template <int i>
+uint32_t SHA1ScheduleWord(uint32_t (&w)[16])
 {
-	context->state[0] = 0x67452301;
-	context->state[1] = 0xEFCDAB89;
-	context->state[2] = 0x98BADCFE;
-	context->state[3] = 0x10325476;
-	context->state[4] = 0xC3D2E1F0;
+	if constexpr (i >= 16)
+		w[i % 16] ^= w[(i + 2) % 16] ^ w[(i + 8) % 16] ^ w[(i + 13) % 16];
+	return w[i % 16];
 }
 
-void SHA1ProcessMessageBlock(SHA1Context *context)
+template <int i>
+void SHA1Round(uint32_t (&w)[16], uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d, uint32_t &e)
 {
-	std::uint32_t w[80];
-
-	for (int i = 0; i < 16; i++)
-		w[i] = SDL_SwapLE32(context->buffer[i]);
-
-	for (int i = 16; i < 80; i++) {
-		w[i] = w[i - 16] ^ w[i - 14] ^ w[i - 8] ^ w[i - 3];
-	}
-
-	std::uint32_t a = context->state[0];
-	std::uint32_t b = context->state[1];
-	std::uint32_t c = context->state[2];
-	std::uint32_t d = context->state[3];
-	std::uint32_t e = context->state[4];
-
-	for (int i = 0; i < 20; i++) {
-		std::uint32_t temp = SHA1CircularShift(a, 5) + ((b & c) | ((~b) & d)) + e + w[i] + 0x5A827999;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	for (int i = 20; i < 40; i++) {
-		std::uint32_t temp = SHA1CircularShift(a, 5) + (b ^ c ^ d) + e + w[i] + 0x6ED9EBA1;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	for (int i = 40; i < 60; i++) {
-		std::uint32_t temp = SHA1CircularShift(a, 5) + ((b & c) | (b & d) | (c & d)) + e + w[i] + 0x8F1BBCDC;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	for (int i = 60; i < 80; i++) {
-		std::uint32_t temp = SHA1CircularShift(a, 5) + (b ^ c ^ d) + e + w[i] + 0xCA62C1D6;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
+	uint32_t f;
+	uint32_t k;
+	if constexpr (i < 20) {
+		f = d ^ (b & (c ^ d));
+		k = 0x5A827999;
+	} else if constexpr (i < 40) {
+		f = b ^ c ^ d;
+		k = 0x6ED9EBA1;
+	} else if constexpr (i < 60) {
+		f = (b & c) | (d & (b | c));
+		k = 0x8F1BBCDC;
+	} else {
+		f = b ^ c ^ d;
+		k = 0xCA62C1D6;
 	}
+	uint32_t temp = SHA1CircularShift<5>(a) + f + e + SHA1ScheduleWord<i>(w) + k;
+	e = d;
+	d = c;
+	c = SHA1CircularShift<30>(b);
+	b = a;
+	a = temp;
+}
 
-	context->state[0] += a;
-	context->state[1] += b;
-	context->state[2] += c;
-	context->state[3] += d;
-	context->state[4] += e;
+template <int... i>
+void SHA1Rounds(std::integer_sequence<int, i...> /*rounds*/, uint32_t (&w)[16], uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d, uint32_t &e)
+{
+	(SHA1Round<i>(w, a, b, c, d, e), ...);
 }
 
-void SHA1Input(SHA1Context *context, const std::byte *messageArray, std::size_t len)
+void SHA1ProcessMessageBlock(SHA1Context &context, const std::byte *block)
 {
-	for (auto i = len / BlockSize; i != 0; i--) {
-		memcpy(context->buffer, messageArray, BlockSize);
-		SHA1ProcessMessageBlock(context);
-		messageArray += BlockSize;
-	}
+	uint32_t w[16];
+	memcpy(w, block, BlockSize);
+	for (uint32_t &word : w)
+		word = SDL_SwapLE32(word);
+
+	uint32_t a = context.state[0];
+	uint32_t b = context.state[1];
+	uint32_t c = context.state[2];
+	uint32_t d = context.state[3];
+	uint32_t e = context.state[4];
+
+	SHA1Rounds(std::make_integer_sequence<int, 80> {}, w, a, b, c, d, e);
+
+	context.state[0] += a;
+	context.state[1] += b;
+	context.state[2] += c;
+	context.state[3] += d;
+	context.state[4] += e;
 }
 
 } // namespace
 
-void SHA1Clear()
+void SHA1Clear(SHA1Context &context)
 {
-	memset(sgSHA1, 0, sizeof(sgSHA1));
+	memset(&context, 0, sizeof(context));
 }
 
-void SHA1Result(int n, std::byte messageDigest[SHA1HashSize])
+void SHA1Result(const SHA1Context &context, std::byte messageDigest[SHA1HashSize])
 {
-	std::uint32_t *messageDigestBlock = reinterpret_cast<std::uint32_t *>(messageDigest);
-	if (messageDigest != nullptr) {
-		for (auto &block : sgSHA1[n].state) {
-			*messageDigestBlock = SDL_SwapLE32(block);
-			messageDigestBlock++;
-		}
+	for (uint32_t block : context.state) {
+		block = SDL_SwapLE32(block);
+		memcpy(messageDigest, &block, sizeof(block));
+		messageDigest += sizeof(block);
 	}
 }
 
-void SHA1Calculate(int n, const std::byte data[BlockSize], std::byte messageDigest[SHA1HashSize])
+void SHA1Calculate(SHA1Context &context, const std::byte data[BlockSize])
 {
-	SHA1Input(&sgSHA1[n], data, BlockSize);
-	if (messageDigest != nullptr)
-		SHA1Result(n, messageDigest);
+	SHA1ProcessMessageBlock(context, data);
 }
 
-void SHA1Reset(int n)
+void SHA1Reset(SHA1Context &context)
 {
-	SHA1Init(&sgSHA1[n]);
+	context.state[0] = 0x67452301;
+	context.state[1] = 0xEFCDAB89;
+	context.state[2] = 0x98BADCFE;
+	context.state[3] = 0x10325476;
+	context.state[4] = 0xC3D2E1F0;
 }
 
 } // namespace devilution
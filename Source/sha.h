@@ -13,9 +13,17 @@ namespace devilution {
 constexpr size_t BlockSize = 64;
 constexpr size_t SHA1HashSize = 20;
 
-void SHA1Clear();
-void SHA1Result(int n, std::byte messageDigest[SHA1HashSize]);
-void SHA1Calculate(int n, const std::byte data[BlockSize], std::byte messageDigest[SHA1HashSize]);
-void SHA1Reset(int n);
+/**
+ * @brief Running state of a hash, every hash in flight needs its own
+ */
+struct SHA1Context {
+	uint32_t state[SHA1HashSize / sizeof(uint32_t)];
+};
+
+/** @brief Wipes the state so it doesn't linger in memory */
+void SHA1Clear(SHA1Context &context);
+void SHA1Result(const SHA1Context &context, std::byte messageDigest[SHA1HashSize]);
+void SHA1Calculate(SHA1Context &context, const std::byte data[BlockSize]);
+void SHA1Reset(SHA1Context &context);
 
 } // namespace devilution
@@ -109,6 +109,17 @@ void RemoveFile(const char *lpFileName)
 	::DeleteFileW(&pathUtf16[0]);
 }
 
+bool RenameFile(const char *from, const char *to)
+{
+	const auto fromUtf16 = ToWideChar(from);
+	const auto toUtf16 = ToWideChar(to);
+	if (fromUtf16 == nullptr || toUtf16 == nullptr) {
+		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
+		return false;
+	}
+	return ::MoveFileExW(&fromUtf16[0], &toUtf16[0], MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
 std::optional<std::fstream> CreateFileStream(const char *path, std::ios::openmode mode)
 {
 	const auto pathUtf16 = ToWideChar(path);
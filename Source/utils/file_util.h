@@ -13,6 +13,7 @@ bool FileExistsAndIsWriteable(const char *path);
 bool GetFileSize(const char *path, std::uintmax_t *size);
 bool ResizeFile(const char *path, std::uintmax_t size);
 void RemoveFile(const char *lpFileName);
+bool RenameFile(const char *from, const char *to);
 std::optional<std::fstream> CreateFileStream(const char *path, std::ios::openmode mode);
 FILE *FOpen(const char *path, const char *mode);
 
@@ -0,0 +1,259 @@
+/**
+ * @file png_writer.cpp
+ *
+ * Implementation of the PNG encoder used for captured frames.
+ */
+#include "utils/png_writer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace devilution {
+
+namespace {
+
+constexpr int MinMatch = 3;
+constexpr int MaxMatch = 258;
+constexpr int WindowSize = 32768;
+constexpr int WindowMask = WindowSize - 1;
+constexpr int HashSize = 1 << 15;
+/** Number of earlier positions compared before settling for the best match found so far */
+constexpr int MaxChain = 32;
+
+constexpr uint16_t LengthBase[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+constexpr uint8_t LengthExtraBits[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+constexpr uint16_t DistanceBase[] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+constexpr uint8_t DistanceExtraBits[] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+/**
+ * @brief Packs values into bytes starting at the least significant bit, the way deflate expects them
+ */
+class BitWriter {
+public:
+	explicit BitWriter(std::vector<uint8_t> &out)
+	    : out_(out)
+	{
+	}
+
+	void Write(uint32_t bits, int count)
+	{
+		buffer_ |= bits << used_;
+		used_ += count;
+		while (used_ >= 8) {
+			out_.push_back(static_cast<uint8_t>(buffer_));
+			buffer_ >>= 8;
+			used_ -= 8;
+		}
+	}
+
+	/** @brief Writes a Huffman code, those are stored starting at the most significant bit */
+	void WriteCode(uint32_t code, int length)
+	{
+		uint32_t reversed = 0;
+		for (int i = 0; i < length; i++) {
+			reversed = (reversed << 1) | (code & 1);
+			code >>= 1;
+		}
+		Write(reversed, length);
+	}
+
+	void Flush()
+	{
+		if (used_ > 0)
+			out_.push_back(static_cast<uint8_t>(buffer_));
+		buffer_ = 0;
+		used_ = 0;
+	}
+
+private:
+	std::vector<uint8_t> &out_;
+	uint32_t buffer_ = 0;
+	int used_ = 0;
+};
+
+/** @brief Writes a literal/length symbol with the fixed Huffman codes */
+void WriteSymbol(BitWriter &writer, int symbol)
+{
+	if (symbol < 144)
+		writer.WriteCode(0x30 + symbol, 8);
+	else if (symbol < 256)
+		writer.WriteCode(0x190 + symbol - 144, 9);
+	else if (symbol < 280)
+		writer.WriteCode(symbol - 256, 7);
+	else
+		writer.WriteCode(0xC0 + symbol - 280, 8);
+}
+
+void WriteMatch(BitWriter &writer, int length, int distance)
+{
+	int lengthCode = static_cast<int>(std::upper_bound(std::begin(LengthBase), std::end(LengthBase), length) - std::begin(LengthBase)) - 1;
+	WriteSymbol(writer, 257 + lengthCode);
+	writer.Write(length - LengthBase[lengthCode], LengthExtraBits[lengthCode]);
+
+	int distanceCode = static_cast<int>(std::upper_bound(std::begin(DistanceBase), std::end(DistanceBase), distance) - std::begin(DistanceBase)) - 1;
+	writer.WriteCode(distanceCode, 5);
+	writer.Write(distance - DistanceBase[distanceCode], DistanceExtraBits[distanceCode]);
+}
+
+/**
+ * @brief Compresses the data into a single deflate block using the fixed Huffman codes
+ */
+void Deflate(const uint8_t *data, int size, std::vector<uint8_t> &out)
+{
+	BitWriter writer(out);
+	writer.Write(1, 1); // Last block
+	writer.Write(1, 2); // Fixed Huffman codes
+
+	std::vector<int> head(HashSize, -1);
+	std::vector<int> previous(WindowSize, -1);
+	const auto hashAt = [&](int position) {
+		return ((data[position] << 10) ^ (data[position + 1] << 5) ^ data[position + 2]) & (HashSize - 1);
+	};
+	const auto insert = [&](int position) {
+		if (position + MinMatch > size)
+			return;
+		int hash = hashAt(position);
+		previous[position & WindowMask] = head[hash];
+		head[hash] = position;
+	};
+
+	int position = 0;
+	while (position < size) {
+		int bestLength = 0;
+		int bestDistance = 0;
+		if (position + MinMatch <= size) {
+			int maxLength = std::min(MaxMatch, size - position);
+			int candidate = head[hashAt(position)];
+			for (int chain = 0; candidate >= 0 && chain < MaxChain; chain++) {
+				int distance = position - candidate;
+				if (distance > WindowSize)
+					break;
+				int length = 0;
+				while (length < maxLength && data[candidate + length] == data[position + length])
+					length++;
+				if (length > bestLength) {
+					bestLength = length;
+					bestDistance = distance;
+					if (length == maxLength)
+						break;
+				}
+				candidate = previous[candidate & WindowMask];
+			}
+		}
+
+		if (bestLength >= MinMatch) {
+			WriteMatch(writer, bestLength, bestDistance);
+			for (int i = 0; i < bestLength; i++)
+				insert(position + i);
+			position += bestLength;
+		} else {
+			WriteSymbol(writer, data[position]);
+			insert(position);
+			position++;
+		}
+	}
+
+	WriteSymbol(writer, 256);
+	writer.Flush();
+}
+
+uint32_t Adler32(const uint8_t *data, int size)
+{
+	uint32_t a = 1;
+	uint32_t b = 0;
+	for (int i = 0; i < size; i++) {
+		a = (a + data[i]) % 65521;
+		b = (b + a) % 65521;
+	}
+	return (b << 16) | a;
+}
+
+uint32_t Crc32(const uint8_t *data, size_t size)
+{
+	static const std::array<uint32_t, 256> Table = [] {
+		std::array<uint32_t, 256> table {};
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t crc = i;
+			for (int bit = 0; bit < 8; bit++)
+				crc = (crc & 1) != 0 ? 0xEDB88320 ^ (crc >> 1) : crc >> 1;
+			table[i] = crc;
+		}
+		return table;
+	}();
+
+	uint32_t crc = 0xFFFFFFFF;
+	for (size_t i = 0; i < size; i++)
+		crc = Table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	return crc ^ 0xFFFFFFFF;
+}
+
+void WriteBE32(std::vector<uint8_t> &out, uint32_t value)
+{
+	out.push_back(static_cast<uint8_t>(value >> 24));
+	out.push_back(static_cast<uint8_t>(value >> 16));
+	out.push_back(static_cast<uint8_t>(value >> 8));
+	out.push_back(static_cast<uint8_t>(value));
+}
+
+void WriteChunk(std::vector<uint8_t> &png, const char *type, const std::vector<uint8_t> &data)
+{
+	WriteBE32(png, static_cast<uint32_t>(data.size()));
+	size_t start = png.size();
+	png.insert(png.end(), type, type + 4);
+	png.insert(png.end(), data.begin(), data.end());
+	WriteBE32(png, Crc32(&png[start], png.size() - start));
+}
+
+} // namespace
+
+std::vector<uint8_t> EncodePng(const uint8_t *pixels, int width, int height, int pitch, const SDL_Color *palette, const std::vector<PngText> &text)
+{
+	static const uint8_t Signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	std::vector<uint8_t> png(std::begin(Signature), std::end(Signature));
+
+	std::vector<uint8_t> header;
+	WriteBE32(header, width);
+	WriteBE32(header, height);
+	header.push_back(8); // Bit depth
+	header.push_back(3); // Paletted
+	header.push_back(0); // Deflate
+	header.push_back(0); // Adaptive filtering
+	header.push_back(0); // Not interlaced
+	WriteChunk(png, "IHDR", header);
+
+	std::vector<uint8_t> colors;
+	colors.reserve(256 * 3);
+	for (int i = 0; i < 256; i++) {
+		colors.push_back(palette[i].r);
+		colors.push_back(palette[i].g);
+		colors.push_back(palette[i].b);
+	}
+	WriteChunk(png, "PLTE", colors);
+
+	for (const PngText &entry : text) {
+		std::vector<uint8_t> chunk(entry.keyword.begin(), entry.keyword.end());
+		chunk.push_back(0);
+		chunk.insert(chunk.end(), entry.value.begin(), entry.value.end());
+		WriteChunk(png, "tEXt", chunk);
+	}
+
+	// Every row starts with the filter type, paletted images compress best without filtering
+	int rowSize = width + 1;
+	std::vector<uint8_t> rows(static_cast<size_t>(rowSize) * height);
+	for (int y = 0; y < height; y++) {
+		rows[y * rowSize] = 0;
+		memcpy(&rows[y * rowSize + 1], &pixels[y * pitch], width);
+	}
+
+	std::vector<uint8_t> compressed = { 0x78, 0x01 };
+	Deflate(rows.data(), static_cast<int>(rows.size()), compressed);
+	WriteBE32(compressed, Adler32(rows.data(), static_cast<int>(rows.size())));
+	WriteChunk(png, "IDAT", compressed);
+
+	WriteChunk(png, "IEND", {});
+
+	return png;
+}
+
+} // namespace devilution
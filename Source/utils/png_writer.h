@@ -0,0 +1,37 @@
+/**
+ * @file png_writer.h
+ *
+ * Interface of the PNG encoder used for captured frames.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+namespace devilution {
+
+/** @brief A keyword and value stored in a tEXt chunk */
+struct PngText {
+	std::string keyword;
+	std::string value;
+};
+
+/**
+ * @brief Encodes an 8-bit paletted image as a PNG file
+ *
+ * The pixel data is deflated with the fixed Huffman codes, which keeps the encoder small while still collapsing the
+ * long runs of equal pixels a frame of the game consists of.
+ * @param pixels First pixel of the image
+ * @param width Image width
+ * @param height Image height
+ * @param pitch Distance between two rows of pixels
+ * @param palette The 256 colors the pixels index
+ * @param text Chunks of text to store with the image
+ * @return The contents of the PNG file
+ */
+std::vector<uint8_t> EncodePng(const uint8_t *pixels, int width, int height, int pitch, const SDL_Color *palette, const std::vector<PngText> &text);
+
+} // namespace devilution
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SDL.h>
+
+#include "appfat.h"
+
+namespace devilution {
+
+/*
+ * RAII wrapper for SDL_sem.
+ */
+class SdlSemaphore final {
+public:
+	SdlSemaphore()
+	    : sem(SDL_CreateSemaphore(0))
+	{
+		if (sem == nullptr)
+			ErrSdl();
+	}
+
+	~SdlSemaphore()
+	{
+		SDL_DestroySemaphore(sem);
+	}
+
+	SdlSemaphore(const SdlSemaphore &) = delete;
+	SdlSemaphore(SdlSemaphore &&) = delete;
+	SdlSemaphore &operator=(const SdlSemaphore &) = delete;
+	SdlSemaphore &operator=(SdlSemaphore &&) = delete;
+
+	void post()
+	{
+		int err = SDL_SemPost(sem);
+		if (err < 0)
+			ErrSdl();
+	}
+
+	void wait()
+	{
+		int err = SDL_SemWait(sem);
+		if (err < 0)
+			ErrSdl();
+	}
+
+private:
+	SDL_sem *sem;
+};
+
+} // namespace devilution
@@ -0,0 +1,93 @@
+/**
+ * @file timing.cpp
+ *
+ * Implementation of the high resolution clock helpers used to pace game ticks and frames.
+ */
+#include "utils/timing.h"
+
+#include <algorithm>
+
+#include <SDL.h>
+
+namespace devilution {
+
+namespace {
+
+/** Time before a deadline that is spent polling instead of sleeping, in microseconds */
+constexpr uint64_t SpinMicroseconds = 1000;
+
+uint64_t LastFrameTime;
+uint64_t WindowStart;
+int WindowFrames;
+uint64_t WindowMaxFrameTime;
+FrameTimeStats LastWindowStats;
+
+float ToMilliseconds(uint64_t ticks)
+{
+	return static_cast<float>(ticks * 1000.0 / SDL_GetPerformanceFrequency());
+}
+
+} // namespace
+
+uint64_t MicrosecondsToPerformanceTicks(uint64_t microseconds)
+{
+	return microseconds * SDL_GetPerformanceFrequency() / 1000000;
+}
+
+void SleepUntil(uint64_t deadline)
+{
+	const uint64_t spinTicks = MicrosecondsToPerformanceTicks(SpinMicroseconds);
+	const uint64_t ticksPerMillisecond = MicrosecondsToPerformanceTicks(1000);
+
+	uint64_t now = SDL_GetPerformanceCounter();
+	while (now < deadline && deadline - now >= spinTicks + ticksPerMillisecond) {
+		// Sleep in whole milliseconds and leave the spin time as margin for SDL_Delay waking up late
+		SDL_Delay(static_cast<Uint32>((deadline - now - spinTicks) / ticksPerMillisecond));
+		now = SDL_GetPerformanceCounter();
+	}
+	while (now < deadline)
+		now = SDL_GetPerformanceCounter();
+}
+
+void DelayUntil(uint64_t deadline)
+{
+	const uint64_t ticksPerMillisecond = MicrosecondsToPerformanceTicks(1000);
+
+	const uint64_t now = SDL_GetPerformanceCounter();
+	if (now >= deadline)
+		return;
+	// Round up so the thread doesn't wake just before the deadline and loop again straight away
+	SDL_Delay(static_cast<Uint32>((deadline - now + ticksPerMillisecond - 1) / ticksPerMillisecond));
+}
+
+void RecordFramePresented()
+{
+	const uint64_t now = SDL_GetPerformanceCounter();
+	if (LastFrameTime == 0) {
+		LastFrameTime = now;
+		WindowStart = now;
+		return;
+	}
+
+	WindowFrames++;
+	WindowMaxFrameTime = std::max(WindowMaxFrameTime, now - LastFrameTime);
+	LastFrameTime = now;
+
+	const uint64_t windowTime = now - WindowStart;
+	if (windowTime < SDL_GetPerformanceFrequency())
+		return;
+
+	LastWindowStats.frames = WindowFrames;
+	LastWindowStats.averageMs = ToMilliseconds(windowTime) / WindowFrames;
+	LastWindowStats.maxMs = ToMilliseconds(WindowMaxFrameTime);
+	WindowStart = now;
+	WindowFrames = 0;
+	WindowMaxFrameTime = 0;
+}
+
+FrameTimeStats GetFrameTimeStats()
+{
+	return LastWindowStats;
+}
+
+} // namespace devilution
@@ -0,0 +1,55 @@
+/**
+ * @file timing.h
+ *
+ * Interface of the high resolution clock helpers used to pace game ticks and frames.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace devilution {
+
+/** @brief Durations of the frames presented during the last full second */
+struct FrameTimeStats {
+	/** Number of frames presented */
+	int frames;
+	/** Average time between two frames in milliseconds */
+	float averageMs;
+	/** Longest time between two frames in milliseconds */
+	float maxMs;
+};
+
+/**
+ * @brief Converts a duration to performance counter ticks
+ * @param microseconds Duration in microseconds
+ */
+uint64_t MicrosecondsToPerformanceTicks(uint64_t microseconds);
+
+/**
+ * @brief Waits until the performance counter reaches the given value
+ *
+ * SDL_Delay only wakes up with millisecond precision, so it is used to sleep until shortly before the deadline and the
+ * rest of the time is spent polling the counter.
+ * @param deadline Performance counter value to wait for
+ */
+void SleepUntil(uint64_t deadline);
+
+/**
+ * @brief Sleeps until the performance counter reaches the given value, without polling
+ *
+ * Only accurate to the millisecond, for threads that must not hold a core while they wait.
+ * @param deadline Performance counter value to wait for
+ */
+void DelayUntil(uint64_t deadline);
+
+/**
+ * @brief Adds the time since the previous call to the frame time statistics, called once a frame was presented
+ */
+void RecordFramePresented();
+
+/**
+ * @brief Returns the frame times of the last full second
+ */
+FrameTimeStats GetFrameTimeStats();
+
+} // namespace devilution
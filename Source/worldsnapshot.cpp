@@ -0,0 +1,149 @@
+/**
+ * @file worldsnapshot.cpp
+ *
+ * Implementation of the copies of the actors that the dungeon is drawn from.
+ */
+#include "worldsnapshot.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace devilution {
+
+namespace {
+
+/**
+ * @brief Clears BFLAG_DEAD_PLAYER on the given tiles where no dead player lies
+ *
+ * The flag is set when a player dies but never cleared by the game logic, once the player is revived or leaves it has
+ * to be dropped so the tile is neither drawn nor picked by the cursor as a dead player.
+ */
+void RefreshDeadPlayerFlags(Rectangle tiles)
+{
+	for (int x = tiles.position.x; x < tiles.position.x + tiles.size.width; x++) {
+		for (int y = tiles.position.y; y < tiles.position.y + tiles.size.height; y++) {
+			if ((dFlags[x][y] & BFLAG_DEAD_PLAYER) == 0)
+				continue;
+			dFlags[x][y] &= ~BFLAG_DEAD_PLAYER;
+			for (auto &player : Players) {
+				if (player.plractive && player._pHitPoints == 0 && player.plrlevel == currlevel && player.position.tile == Point { x, y }) {
+					dFlags[x][y] |= BFLAG_DEAD_PLAYER;
+					break;
+				}
+			}
+		}
+	}
+}
+
+void CapturePlayers(WorldSnapshot &snapshot)
+{
+	for (int i = 0; i < MAX_PLRS; i++) {
+		const auto &player = Players[i];
+		SnapshotPlayer &target = snapshot.players[i];
+		target.AnimInfo = player.AnimInfo;
+		target.tile = player.position.tile;
+		target.offset = player.position.offset;
+		target.dir = player._pdir;
+		target.mode = player._pmode;
+		target.walking = player.IsWalking();
+		target.dead = player.plractive && player._pHitPoints == 0 && player.plrlevel == currlevel;
+		target.manaShield = player.pManaShield;
+		target.reflect = player.wReflections > 0;
+		memcpy(target.name, player._pName, sizeof(target.name));
+	}
+}
+
+void CaptureMonster(WorldSnapshot &snapshot, int id)
+{
+	const auto &monster = Monsters[id];
+	SnapshotMonster &target = snapshot.monsters[id];
+	target.AnimInfo = monster.AnimInfo;
+	target.offset = monster.position.offset;
+	target.dir = monster._mdir;
+	target.mode = monster._mmode;
+	target.walking = monster.IsWalking();
+	target.hidden = (monster._mFlags & MFLAG_HIDDEN) != 0;
+	target.initialized = monster.MType != nullptr;
+	target.uniqueTrans = monster.Stats()._uniqtype != 0 ? monster.Stats()._uniqtrans + 4 : 0;
+	target.name = monster.Stats().mName;
+}
+
+void CaptureItem(WorldSnapshot &snapshot, int id)
+{
+	const auto &item = Items[id];
+	SnapshotItem &target = snapshot.items[id];
+	target.AnimInfo = item.AnimInfo;
+	target.type = item._itype;
+	target.postDraw = item._iPostDraw;
+	target.labeled = item.AnimInfo.CurrentFrame == item.AnimInfo.NumberOfFrames || item._iCurs == ICURS_MAGIC_ROCK;
+	target.outlineColor = GetOutlineColor(item, false);
+}
+
+void CaptureObject(WorldSnapshot &snapshot, int id)
+{
+	const auto &object = Objects[id];
+	snapshot.objects[id] = {
+		object._oAnimData,
+		object._oAnimFrame,
+		object._oAnimWidth,
+		object.position,
+		object._otype,
+		object._oPreFlag,
+		object._oLight,
+		object._oMissFlag
+	};
+}
+
+/**
+ * @brief Copies the monsters, items and objects the given tiles refer to
+ */
+void CaptureActorsOnTiles(WorldSnapshot &snapshot, Rectangle tiles)
+{
+	for (int x = tiles.position.x; x < tiles.position.x + tiles.size.width; x++) {
+		for (int y = tiles.position.y; y < tiles.position.y + tiles.size.height; y++) {
+			// Town tiles refer to towners, those are all copied below
+			if (dMonster[x][y] != 0 && leveltype != DTYPE_TOWN)
+				CaptureMonster(snapshot, std::abs(dMonster[x][y]) - 1);
+			if (dItem[x][y] > 0)
+				CaptureItem(snapshot, dItem[x][y] - 1);
+			if (dObject[x][y] != 0)
+				CaptureObject(snapshot, std::abs(dObject[x][y]) - 1);
+		}
+	}
+
+	if (leveltype == DTYPE_TOWN) {
+		for (int i = 0; i < NUM_TOWNERS; i++) {
+			const auto &towner = Towners[i];
+			snapshot.towners[i] = { towner._tAnimData, towner._tAnimWidth, towner._tAnimFrame };
+		}
+	}
+
+	memcpy(snapshot.corpses, Corpses, sizeof(snapshot.corpses));
+}
+
+void CaptureMissiles(WorldSnapshot &snapshot, Rectangle tiles)
+{
+	snapshot.missiles.clear();
+	for (int i = 0; i < ActiveMissileCount; i++) {
+		const Missile &missile = Missiles[ActiveMissiles[i]];
+		if (tiles.Contains(missile.position.tile))
+			snapshot.missiles.push_back(missile);
+	}
+}
+
+} // namespace
+
+void CaptureWorldSnapshot(WorldSnapshot &snapshot, Rectangle tiles)
+{
+	RefreshDeadPlayerFlags(tiles);
+
+	snapshot.scroll = ScrollInfo;
+	snapshot.missilePreFlag = MissilePreFlag;
+	snapshot.infravision = Players[MyPlayerId]._pInfraFlag;
+
+	CapturePlayers(snapshot);
+	CaptureActorsOnTiles(snapshot, tiles);
+	CaptureMissiles(snapshot, tiles);
+}
+
+} // namespace devilution
@@ -0,0 +1,113 @@
+/**
+ * @file worldsnapshot.h
+ *
+ * Interface of the copies of the actors that the dungeon is drawn from.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "dead.h"
+#include "engine/animationinfo.h"
+#include "engine/point.hpp"
+#include "engine/rectangle.hpp"
+#include "gendung.h"
+#include "items.h"
+#include "lighting.h"
+#include "missiles.h"
+#include "monster.h"
+#include "objects.h"
+#include "player.h"
+#include "towners.h"
+
+namespace devilution {
+
+struct SnapshotPlayer {
+	AnimationInfo AnimInfo;
+	Point tile;
+	Displacement offset;
+	Direction dir;
+	PLR_MODE mode;
+	bool walking;
+	/** Active on the current level without any hit points left */
+	bool dead;
+	bool manaShield;
+	bool reflect;
+	char name[PLR_NAME_LEN];
+};
+
+struct SnapshotMonster {
+	AnimationInfo AnimInfo;
+	Displacement offset;
+	Direction dir;
+	MonsterMode mode;
+	bool walking;
+	bool hidden;
+	/** The monster has a type, i.e. graphics to draw it with */
+	bool initialized;
+	/** Light table used for unique monsters, 0 for regular ones */
+	uint8_t uniqueTrans;
+	const char *name;
+};
+
+struct SnapshotItem {
+	AnimationInfo AnimInfo;
+	ItemType type;
+	bool postDraw;
+	/** The item shows its name on the ground */
+	bool labeled;
+	uint8_t outlineColor;
+};
+
+struct SnapshotObject {
+	std::byte *animData;
+	uint32_t animFrame;
+	int animWidth;
+	Point position;
+	_object_id type;
+	bool preFlag;
+	bool light;
+	bool missFlag;
+};
+
+struct SnapshotTowner {
+	std::byte *animData;
+	int animWidth;
+	int animFrame;
+};
+
+/**
+ * @brief The actors in view, in the form the dungeon is drawn from
+ *
+ * The tile maps are read in place, the world must not change while the dungeon is drawn.
+ */
+struct WorldSnapshot {
+	ScrollStruct scroll;
+	bool missilePreFlag;
+	bool infravision;
+
+	SnapshotPlayer players[MAX_PLRS];
+	/** Only the monsters, items and objects on the tiles in view are filled in */
+	SnapshotMonster monsters[MAXMONSTERS];
+	SnapshotTowner towners[NUM_TOWNERS];
+	SnapshotItem items[MAXITEMS];
+	SnapshotObject objects[MAXOBJECTS];
+	Corpse corpses[MaxCorpses];
+
+	/**
+	 * @brief The missiles in view in the order they are drawn
+	 *
+	 * These are full copies, the renderer writes the position the missile is drawn at into them.
+	 */
+	std::vector<Missile> missiles;
+};
+
+/**
+ * @brief Takes the actors on the given tiles into the snapshot
+ *
+ * Also drops the dead player flag from the tiles no dead player lies on anymore.
+ */
+void CaptureWorldSnapshot(WorldSnapshot &snapshot, Rectangle tiles);
+
+} // namespace devilution
@@ -0,0 +1,164 @@
+/**
+ * @file main.cpp
+ *
+ * Checks the random level generators against the layouts recorded next to this file.
+ *
+ * Usage: seedsweep {recordings directory} [--record {count}]
+ *
+ * Every dungeon level has a recording seedsweep_{level}.txt in the format of the seedsweep debug command. The
+ * recorded seeds are generated again and the tool fails if any layout changed. --record replaces the recordings with
+ * the layouts of the first {count} seeds, this is only meant for changes that alter the layouts on purpose.
+ *
+ * The recorded hashes don't depend on the tile definitions, so no game data is needed. The recordings were made with
+ * the generators as they were before they could run on worker threads. Every sweep also prints how long the layouts
+ * took to generate.
+ *
+ * Only the recorded seeds are checked. Seed 606 is left out on the catacomb levels, ConnectHall wanders for minutes
+ * or longer there before it reaches its target, in the original generator just the same.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SDL.h>
+#include <fmt/format.h>
+
+#include "gendung.h"
+#include "levelsweep.h"
+
+using namespace devilution;
+
+namespace {
+
+/** Seeds that take too long to generate on the catacomb levels to be swept */
+constexpr uint32_t RunawayCatacombSeeds[] = { 606 };
+
+/** First seed and number of seeds of a range of consecutive seeds */
+using SeedRun = std::pair<uint32_t, int>;
+
+/**
+ * @brief Generates the given ranges of seeds and prints how long it took
+ */
+std::vector<SeedSweepResult> SweepLevel(int level, const std::vector<SeedRun> &runs)
+{
+	int threadCount = 0;
+	std::vector<SeedSweepResult> results;
+	uint64_t start = SDL_GetPerformanceCounter();
+	for (const SeedRun &run : runs) {
+		std::vector<SeedSweepResult> runResults = SweepLevelSeeds(level, run.first, run.second, false, threadCount);
+		results.insert(results.end(), runResults.begin(), runResults.end());
+	}
+	uint64_t wallTicks = SDL_GetPerformanceCounter() - start;
+	fmt::print("{}\n", DescribeSeedSweep(level, results, wallTicks, threadCount));
+	return results;
+}
+
+/**
+ * @brief Splits the first count seeds into the ranges that can be swept on the given level
+ */
+std::vector<SeedRun> GetRecordedRuns(int level, int count)
+{
+	std::vector<SeedRun> runs;
+	uint32_t first = 0;
+	if (level >= 5 && level <= 8) {
+		for (uint32_t seed : RunawayCatacombSeeds) {
+			if (seed >= static_cast<uint32_t>(count))
+				break;
+			if (seed > first)
+				runs.emplace_back(first, static_cast<int>(seed - first));
+			first = seed + 1;
+		}
+	}
+	if (first < static_cast<uint32_t>(count))
+		runs.emplace_back(first, static_cast<int>(count - first));
+	return runs;
+}
+
+/**
+ * @brief Splits the seeds of a recording into ranges of consecutive seeds
+ */
+std::vector<SeedRun> GetRuns(const SeedSweepRecording &recording)
+{
+	std::vector<SeedRun> runs;
+	for (const auto &entry : recording) {
+		if (!runs.empty() && runs.back().first + runs.back().second == entry.first)
+			runs.back().second++;
+		else
+			runs.emplace_back(entry.first, 1);
+	}
+	return runs;
+}
+
+bool RecordLevel(const std::string &path, int level, int count)
+{
+	std::vector<SeedSweepResult> results = SweepLevel(level, GetRecordedRuns(level, count));
+
+	std::ofstream stream(path, std::ios::out | std::ios::trunc);
+	WriteSeedSweep(stream, results);
+	if (!stream) {
+		fmt::print(stderr, "Failed to write {}\n", path);
+		return false;
+	}
+
+	fmt::print("Recorded {} layouts of level {}\n", results.size(), level);
+	return true;
+}
+
+bool CheckLevel(const std::string &path, int level)
+{
+	std::ifstream stream(path);
+	SeedSweepRecording recording;
+	if (!stream || !ReadSeedSweep(stream, recording) || recording.empty()) {
+		fmt::print(stderr, "Level {}: {} is missing or not a recorded sweep\n", level, path);
+		return false;
+	}
+
+	std::vector<SeedSweepResult> results = SweepLevel(level, GetRuns(recording));
+
+	int compared;
+	const SeedSweepResult *firstMismatch = nullptr;
+	int mismatches = CompareSeedSweep(results, recording, compared, &firstMismatch);
+	if (mismatches != 0) {
+		const SeedSweepResult &expected = recording.at(firstMismatch->seed);
+		fmt::print(stderr, "Level {}: {} of {} layouts differ, seed {} took {} attempts with hash {:016x} instead of {} attempts with hash {:016x}\n",
+		    level, mismatches, compared, firstMismatch->seed,
+		    firstMismatch->layoutAttempts, firstMismatch->hash, expected.layoutAttempts, expected.hash);
+		return false;
+	}
+
+	fmt::print("Level {}: {} layouts match\n", level, compared);
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	if (argc != 2 && !(argc == 4 && std::string(argv[2]) == "--record")) {
+		fmt::print(stderr, "Usage: {} {{recordings directory}} [--record {{count}}]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	int recordCount = argc == 4 ? std::atoi(argv[3]) : 0;
+	if (argc == 4 && recordCount < 1) {
+		fmt::print(stderr, "Can't record less than one layout\n");
+		return EXIT_FAILURE;
+	}
+
+	bool success = true;
+	for (int level = 1; level < NUMLEVELS; level++) {
+		if (!CanSweepLevel(level))
+			continue;
+
+		std::string path = fmt::format("{}/seedsweep_{}.txt", argv[1], level);
+		if (recordCount != 0)
+			success = RecordLevel(path, level, recordCount) && success;
+		else
+			success = CheckLevel(path, level) && success;
+	}
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}